@@ -26,6 +26,8 @@ public class OGCore : ModuleRules
 			new string[]
 			{
 				"Core",
+				"OGAsync",
+				"StructUtils",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -36,6 +38,7 @@ public class OGCore : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"NetCore",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
@@ -0,0 +1,69 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGConcurrentDataBank.h"
+
+FOGConcurrentDataBank::FOGConcurrentDataBank(const FOGPolymorphicDataBankBase& TargetBank)
+	: StructCache(TargetBank.GetStructCache())
+	, InnerStruct(TargetBank.GetInnerStruct())
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	NumSlots = StructCache->GetNumTypes();
+	Slots = MakeUnique<FSlot[]>(NumSlots);
+}
+
+FOGConcurrentDataBank::~FOGConcurrentDataBank()
+{
+	for (int32 Key = 0; Key < NumSlots; ++Key)
+	{
+		delete Slots[Key].Value.load(std::memory_order_relaxed);
+	}
+	TArray<FSlotValue*> RetiredValues;
+	Retired.PopAll(RetiredValues);
+	for (FSlotValue* Value : RetiredValues)
+	{
+		delete Value;
+	}
+}
+
+void FOGConcurrentDataBank::Publish(const uint16 Key, const TSharedRef<FOGPolymorphicStructBase>& Entry)
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	FSlot& Slot = Slots[Key];
+	FSlotValue* OldValue = Slot.Value.exchange(new FSlotValue{Entry}, std::memory_order_acq_rel);
+	// Flagged after the value is visible, so Commit can never see the flag without the value it belongs to
+	Slot.bPendingCommit.store(true, std::memory_order_release);
+	if (OldValue)
+	{
+		Retired.Push(OldValue);
+	}
+}
+
+int32 FOGConcurrentDataBank::Commit(FOGPolymorphicDataBankBase& TargetBank)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGConcurrentDataBank::Commit);
+	check(IsInGameThread());
+	if (!ensureAlwaysMsgf(TargetBank.GetStructCache() == StructCache, TEXT("Committing into a bank with a different struct cache"))) [[unlikely]]
+		return 0;
+
+	// Anything retired before this point has already been replaced, it can't be what we're about to commit
+	TArray<FSlotValue*> RetiredValues;
+	Retired.PopAll(RetiredValues);
+
+	int32 NumCommitted = 0;
+	for (int32 Key = 0; Key < NumSlots; ++Key)
+	{
+		FSlot& Slot = Slots[Key];
+		if (!Slot.bPendingCommit.exchange(false, std::memory_order_acq_rel))
+			continue;
+		// A write landing between the exchange and this load is committed now and flagged again for the next Commit, which is harmless
+		const FSlotValue* Value = Slot.Value.load(std::memory_order_acquire);
+		TargetBank.SetShared_Internal(Key, Value->Entry);
+		++NumCommitted;
+	}
+
+	for (FSlotValue* Value : RetiredValues)
+	{
+		delete Value;
+	}
+	return NumCommitted;
+}
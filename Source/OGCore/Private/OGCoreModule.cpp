@@ -1,17 +1,22 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OGCoreModule.h"
+#include "OGDataBankChangeListeners.h"
 #include "OGPolymorphicDataBank.h"
 
 #define LOCTEXT_NAMESPACE "FOGUtilitiesModule"
 
+DEFINE_LOG_CATEGORY(LogOGCore);
+
 static FOGPolymorphicStructCache UniversalStructCache;
+static TArray<const UScriptStruct*> UniversalStructCacheExclusions;
 
 void FOGCoreModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	// In your class constructor or initialization function:
 	ModulesLoadedHandle = FCoreDelegates::OnAllModuleLoadingPhasesComplete.AddStatic(&FOGCoreModule::OnAllModulesLoaded);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FOGDataBankChangeListeners::FlushAll);
 }
 
 void FOGCoreModule::ShutdownModule()
@@ -19,6 +24,7 @@ void FOGCoreModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	FCoreDelegates::OnAllModuleLoadingPhasesComplete.Remove(ModulesLoadedHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
 }
 
 FOGPolymorphicStructCache* FOGCoreModule::GetUniversalStructCache()
@@ -26,9 +32,16 @@ FOGPolymorphicStructCache* FOGCoreModule::GetUniversalStructCache()
 	return &UniversalStructCache;
 }
 
+void FOGCoreModule::ExcludeFromUniversalStructCache(const UScriptStruct* GroupType)
+{
+	ensureMsgf(UniversalStructCache.GetNumTypes() == 0, TEXT("%s was excluded after the universal StructCache was built"), *GetNameSafe(GroupType));
+	UniversalStructCacheExclusions.AddUnique(GroupType);
+}
+
 void FOGCoreModule::OnAllModulesLoaded()
 {
-	UniversalStructCache.InitTypeCache(FOGPolymorphicStructBase::StaticStruct());
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGCoreModule::OnAllModulesLoaded);
+	UniversalStructCache.InitTypeCache(FOGPolymorphicStructBase::StaticStruct(), UniversalStructCacheExclusions);
 }
 
 #undef LOCTEXT_NAMESPACE
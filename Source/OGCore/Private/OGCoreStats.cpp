@@ -0,0 +1,12 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGCoreStats.h"
+
+DEFINE_STAT(STAT_OGCore_LiveBanks);
+DEFINE_STAT(STAT_OGCore_LiveEntries);
+DEFINE_STAT(STAT_OGCore_EntryMemory);
+DEFINE_STAT(STAT_OGCore_Lookups);
+DEFINE_STAT(STAT_OGCore_DirtyMarks);
+DEFINE_STAT(STAT_OGCore_RedundantWrites);
+
+LLM_DEFINE_TAG(OGCore);
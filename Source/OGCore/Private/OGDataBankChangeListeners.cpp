@@ -0,0 +1,134 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankChangeListeners.h"
+
+#include "OGPolymorphicDataBank.h"
+
+// Banks with pending changes this frame. Weak, so a bank that goes away before the end of the frame is simply skipped.
+static TArray<TWeakPtr<FOGDataBankChangeListeners>> GPendingListeners;
+
+FOGDataBankSubscriptionHandle FOGDataBankChangeListeners::Add(const uint16 TypeKey, FOGOnDataBankChanged&& Delegate)
+{
+	FSubscription Subscription;
+	Subscription.Delegate = MoveTemp(Delegate);
+	return Add_Internal(TypeKey, MoveTemp(Subscription));
+}
+
+FOGDataBankSubscriptionHandle FOGDataBankChangeListeners::Add(const uint16 TypeKey, const FOGOnDataBankChangedDynamic& Delegate)
+{
+	FSubscription Subscription;
+	Subscription.DynamicDelegate = Delegate;
+	return Add_Internal(TypeKey, MoveTemp(Subscription));
+}
+
+FOGDataBankSubscriptionHandle FOGDataBankChangeListeners::Add_Internal(const uint16 TypeKey, FSubscription&& Subscription)
+{
+	check(IsInGameThread());
+	Subscription.Handle = FOGHandleBase::GenerateHandle<FOGDataBankSubscriptionHandle>();
+	Subscription.KeyRange = StructCache->GetSubtreeRange(TypeKey);
+	return Subscriptions.Add_GetRef(MoveTemp(Subscription)).Handle;
+}
+
+bool FOGDataBankChangeListeners::Remove(const FOGDataBankSubscriptionHandle& Handle)
+{
+	check(IsInGameThread());
+	return Subscriptions.RemoveAll([&Handle](const FSubscription& Subscription) { return Subscription.Handle == Handle; }) > 0;
+}
+
+TOGFuture<void> FOGDataBankChangeListeners::WhenContains(const uint16 TypeKey)
+{
+	check(IsInGameThread());
+	return ContainsWaiters.Emplace_GetRef(TypeKey, TOGPromise<void>()).Value;
+}
+
+TOGFuture<void> FOGDataBankChangeListeners::WhenChanged(const uint16 TypeKey)
+{
+	check(IsInGameThread());
+	return ChangedWaiters.Emplace_GetRef(TypeKey, TOGPromise<void>()).Value;
+}
+
+void FOGDataBankChangeListeners::MarkChanged(const uint16 Key, const bool bPresent)
+{
+	checkSlow(IsInGameThread());
+	if (!HasListeners())
+		return;
+	if (PendingKeys.IsEmpty())
+	{
+		GPendingListeners.Add(AsWeak());
+	}
+	PendingKeys.Add(Key, bPresent);
+}
+
+void FOGDataBankChangeListeners::FlushAll()
+{
+	if (GPendingListeners.IsEmpty())
+		return;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGDataBankChangeListeners::FlushAll);
+	// Listeners may change banks again, those changes go out next frame
+	TArray<TWeakPtr<FOGDataBankChangeListeners>> Pending = MoveTemp(GPendingListeners);
+	GPendingListeners.Reset();
+	for (const TWeakPtr<FOGDataBankChangeListeners>& WeakListeners : Pending)
+	{
+		if (const TSharedPtr<FOGDataBankChangeListeners> Listeners = WeakListeners.Pin())
+		{
+			Listeners->Flush();
+		}
+	}
+}
+
+void FOGDataBankChangeListeners::Flush()
+{
+	TArray<uint16, TInlineAllocator<16>> ChangedKeys;
+	TArray<TOGPromise<void>, TInlineAllocator<4>> ToFulfill;
+	for (const auto& [Key, bPresent] : PendingKeys)
+	{
+		ChangedKeys.Add(Key);
+		if (!bPresent)
+			continue;
+		for (int32 Idx = ContainsWaiters.Num() - 1; Idx >= 0; --Idx)
+		{
+			if (ContainsWaiters[Idx].Key == Key)
+			{
+				ToFulfill.Add(ContainsWaiters[Idx].Value);
+				ContainsWaiters.RemoveAtSwap(Idx);
+			}
+		}
+		for (int32 Idx = ChangedWaiters.Num() - 1; Idx >= 0; --Idx)
+		{
+			if (ChangedWaiters[Idx].Key == Key)
+			{
+				ToFulfill.Add(ChangedWaiters[Idx].Value);
+				ChangedWaiters.RemoveAtSwap(Idx);
+			}
+		}
+	}
+	PendingKeys.Reset();
+	ChangedKeys.Sort();
+
+	// Continuations may wait on this bank again, so the waiters are taken out before fulfilling
+	for (TOGPromise<void>& Promise : ToFulfill)
+	{
+		Promise->Fulfill();
+	}
+
+	// Copied so listeners may subscribe or unsubscribe while being called
+	const TArray<FSubscription> ToNotify = Subscriptions;
+	TArray<UScriptStruct*> ChangedTypes;
+	for (const FSubscription& Subscription : ToNotify)
+	{
+		if (!Subscriptions.ContainsByPredicate([&Subscription](const FSubscription& Existing) { return Existing.Handle == Subscription.Handle; }))
+			continue;
+		ChangedTypes.Reset();
+		for (const uint16 Key : ChangedKeys)
+		{
+			if (Key >= Subscription.KeyRange.Key && Key < Subscription.KeyRange.Value)
+			{
+				ChangedTypes.Add(StructCache->GetTypeForIndex(Key));
+			}
+		}
+		if (ChangedTypes.IsEmpty())
+			continue;
+		Subscription.Delegate.ExecuteIfBound(ChangedTypes);
+		Subscription.DynamicDelegate.ExecuteIfBound(ChangedTypes);
+	}
+}
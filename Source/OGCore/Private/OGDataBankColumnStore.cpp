@@ -0,0 +1,224 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankColumnStore.h"
+
+#include "Misc/ScopeLock.h"
+
+static constexpr int32 ColumnAlignment = 16;
+
+//Stores may be created off the game thread, unlike the delta states tracked for the same report
+static FCriticalSection GLiveColumnStoresLock;
+static TSet<const FOGDataBankColumnStore*> GLiveColumnStores;
+
+FOGDataBankColumnStore::FOGDataBankColumnStore(const FOGPolymorphicDataBankBase& BankPrototype)
+	: StructCache(BankPrototype.GetStructCache())
+	, InnerStruct(BankPrototype.GetInnerStruct())
+{
+	Columns.SetNum(StructCache->GetNumTypes());
+	FScopeLock Lock(&GLiveColumnStoresLock);
+	GLiveColumnStores.Add(this);
+}
+
+FOGDataBankColumnStore::~FOGDataBankColumnStore()
+{
+	{
+		FScopeLock Lock(&GLiveColumnStoresLock);
+		GLiveColumnStores.Remove(this);
+	}
+	for (int32 Key = 0; Key < Columns.Num(); ++Key)
+	{
+		FColumn& Column = Columns[Key];
+		if (!Column.Data)
+			continue;
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		for (TConstSetBitIterator<> It(Column.Presence); It; ++It)
+		{
+			Struct->DestroyStruct(Column.Data + It.GetIndex() * Column.Stride);
+		}
+		FMemory::Free(Column.Data);
+	}
+}
+
+int32 FOGDataBankColumnStore::AddEntity()
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	++NumLiveEntities;
+	if (!FreeEntities.IsEmpty())
+	{
+		const int32 Entity = FreeEntities.Pop(EAllowShrinking::No);
+		Entities[Entity] = true;
+		return Entity;
+	}
+
+	const int32 Entity = Entities.Add(true);
+	if (Entity >= EntityCapacity)
+	{
+		const int32 OldCapacity = EntityCapacity;
+		EntityCapacity = FMath::Max(64, EntityCapacity * 2);
+		for (int32 Key = 0; Key < Columns.Num(); ++Key)
+		{
+			if (Columns[Key].Data)
+			{
+				GrowColumn(Key, OldCapacity);
+			}
+		}
+	}
+	return Entity;
+}
+
+void FOGDataBankColumnStore::RemoveEntity(const int32 Entity)
+{
+	if (!ensure(IsValidEntity(Entity))) [[unlikely]]
+		return;
+	for (int32 Key = 0; Key < Columns.Num(); ++Key)
+	{
+		if (Columns[Key].Data && Columns[Key].Presence[Entity])
+		{
+			RemoveRaw(Key, Entity);
+		}
+	}
+	Entities[Entity] = false;
+	FreeEntities.Add(Entity);
+	--NumLiveEntities;
+}
+
+void FOGDataBankColumnStore::GrowColumn(const uint16 Key, const int32 OldCapacity)
+{
+	FColumn& Column = Columns[Key];
+	//Like TArray, entries are assumed to be bitwise relocatable
+	Column.Data = static_cast<uint8*>(FMemory::Realloc(Column.Data, EntityCapacity * Column.Stride, ColumnAlignment));
+	FMemory::Memzero(Column.Data + OldCapacity * Column.Stride, (EntityCapacity - OldCapacity) * Column.Stride);
+	Column.Presence.Add(false, EntityCapacity - Column.Presence.Num());
+}
+
+void* FOGDataBankColumnStore::AddRaw(const uint16 Key, const int32 Entity)
+{
+	check(IsValidEntity(Entity));
+	FColumn& Column = Columns[Key];
+	const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+	if (!Column.Data)
+	{
+		LLM_SCOPE_BYTAG(OGCore);
+		const UScriptStruct::ICppStructOps* StructOps = Struct->GetCppStructOps();
+		checkf(StructOps->GetAlignment() <= ColumnAlignment, TEXT("%s is over aligned for a column"), *Struct->GetName());
+		Column.Stride = StructOps->GetSize();
+		GrowColumn(Key, 0);
+	}
+
+	uint8* EntryData = Column.Data + Entity * Column.Stride;
+	if (!ensureAlwaysMsgf(!Column.Presence[Entity], TEXT("Tried adding a unique type, but type already exsists"))) [[unlikely]]
+		return EntryData;
+	Struct->InitializeStruct(EntryData);
+	Column.Presence[Entity] = true;
+	return EntryData;
+}
+
+void FOGDataBankColumnStore::RemoveRaw(const uint16 Key, const int32 Entity)
+{
+	FColumn& Column = Columns[Key];
+	if (!Column.Data || !Column.Presence[Entity])
+		return;
+	uint8* EntryData = Column.Data + Entity * Column.Stride;
+	StructCache->GetTypeForIndex(Key)->DestroyStruct(EntryData);
+	FMemory::Memzero(EntryData, Column.Stride);
+	Column.Presence[Entity] = false;
+}
+
+void* FOGDataBankColumnStore::FindRaw(const uint16 Key, const int32 Entity)
+{
+	FColumn& Column = Columns[Key];
+	if (!Column.Data || !Column.Presence.IsValidIndex(Entity) || !Column.Presence[Entity])
+		return nullptr;
+	return Column.Data + Entity * Column.Stride;
+}
+
+void FOGDataBankColumnStore::CopyToBank(const int32 Entity, FOGPolymorphicDataBankBase& OutBank) const
+{
+	check(IsValidEntity(Entity));
+	if (!ensureAlwaysMsgf(OutBank.GetStructCache() == StructCache && OutBank.GetInnerStruct() == InnerStruct,
+		TEXT("Bank must be the kind of bank the store was created for"))) [[unlikely]]
+		return;
+
+	LLM_SCOPE_BYTAG(OGCore);
+	OutBank.Empty();
+	for (int32 Key = 0; Key < Columns.Num(); ++Key)
+	{
+		if (const void* EntryData = const_cast<FOGDataBankColumnStore*>(this)->FindRaw(Key, Entity))
+		{
+			FOGPolymorphicStructBase& Entry = OutBank.AddUnique_Internal(Key, StructCache->GetTypeForIndex(Key));
+			OutBank.CopyEntry_Internal(Key, Entry, *static_cast<const FOGPolymorphicStructBase*>(EntryData));
+			OutBank.MarkDirty(Entry);
+		}
+	}
+}
+
+void FOGDataBankColumnStore::CopyFromBank(const int32 Entity, const FOGPolymorphicDataBankBase& Bank)
+{
+	check(IsValidEntity(Entity));
+	if (!ensureAlwaysMsgf(Bank.GetStructCache() == StructCache && Bank.GetInnerStruct() == InnerStruct,
+		TEXT("Bank must be the kind of bank the store was created for"))) [[unlikely]]
+		return;
+
+	for (int32 Key = 0; Key < Columns.Num(); ++Key)
+	{
+		const FOGPolymorphicStructBase* Source = Bank.GetConst_Internal(Key);
+		if (!Source)
+		{
+			RemoveRaw(Key, Entity);
+			continue;
+		}
+		void* EntryData = FindRaw(Key, Entity);
+		if (!EntryData)
+		{
+			EntryData = AddRaw(Key, Entity);
+		}
+		Bank.CopyEntry_Internal(Key, *static_cast<FOGPolymorphicStructBase*>(EntryData), *Source);
+	}
+}
+
+SIZE_T FOGDataBankColumnStore::GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType) const
+{
+	SIZE_T Size = Columns.GetAllocatedSize() + Entities.GetAllocatedSize() + FreeEntities.GetAllocatedSize();
+	for (int32 Key = 0; Key < Columns.Num(); ++Key)
+	{
+		const FColumn& Column = Columns[Key];
+		if (!Column.Data)
+			continue;
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		SIZE_T ColumnSize = EntityCapacity * Column.Stride + Column.Presence.GetAllocatedSize();
+		for (TConstSetBitIterator<> It(Column.Presence); It; ++It)
+		{
+			ColumnSize += FOGPolymorphicStructCache::GetEntryHeapSize(Struct, Column.Data + It.GetIndex() * Column.Stride);
+		}
+		Size += ColumnSize;
+		if (OutBytesPerEntryType)
+		{
+			OutBytesPerEntryType->FindOrAdd(Struct) += ColumnSize;
+		}
+	}
+	return Size;
+}
+
+void FOGDataBankColumnStore::ForEachLiveStore(TFunctionRef<void(const FOGDataBankColumnStore&)> Func)
+{
+	FScopeLock Lock(&GLiveColumnStoresLock);
+	for (const FOGDataBankColumnStore* Store : GLiveColumnStores)
+	{
+		Func(*Store);
+	}
+}
+
+void FOGDataBankColumnStore::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (int32 Key = 0; Key < Columns.Num(); ++Key)
+	{
+		FColumn& Column = Columns[Key];
+		if (!Column.Data)
+			continue;
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		for (TConstSetBitIterator<> It(Column.Presence); It; ++It)
+		{
+			Collector.AddPropertyReferencesWithStructARO(Struct, Column.Data + It.GetIndex() * Column.Stride);
+		}
+	}
+}
@@ -0,0 +1,263 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankMemory.h"
+
+#include "OGDataBankColumnStore.h"
+#include "OGOverlayDataBank.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGPolymorphicMultiBank.h"
+#include "Engine/NetConnection.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectIterator.h"
+
+static TSet<const FOGDataBankDeltaStateBase*> GLiveDeltaStates;
+
+FOGDataBankDeltaStateBase::FOGDataBankDeltaStateBase()
+{
+	GLiveDeltaStates.Add(this);
+}
+
+FOGDataBankDeltaStateBase::~FOGDataBankDeltaStateBase()
+{
+	GLiveDeltaStates.Remove(this);
+}
+
+void FOGDataBankDeltaStateBase::ForEachLiveState(TFunctionRef<void(const FOGDataBankDeltaStateBase&)> Func)
+{
+	for (const FOGDataBankDeltaStateBase* State : GLiveDeltaStates)
+	{
+		Func(*State);
+	}
+}
+
+namespace OGDataBankMemReport
+{
+	struct FBankUsage
+	{
+		FString Path;
+		FString BankType;
+		SIZE_T Bytes = 0;
+	};
+
+	struct FReport
+	{
+		TArray<FBankUsage> Banks;
+		TMap<const UScriptStruct*, SIZE_T> BytesPerEntryType;
+		//Entries are shared by copy on write between banks, snapshots and templates, each one is charged to the first bank seen with it
+		TSet<const void*> CountedEntries;
+		//Whether a struct has banks anywhere inside it, so types without any are only walked once
+		TMap<const UStruct*, bool> ContainsBanks;
+	};
+
+	static bool IsBankType(const UScriptStruct* Struct)
+	{
+		return Struct->IsChildOf(FOGPolymorphicDataBankBase::StaticStruct()) || Struct->IsChildOf(FOGPolymorphicMultiBankBase::StaticStruct())
+			|| Struct->IsChildOf(FOGOverlayDataBankBase::StaticStruct());
+	}
+
+	// Containers hold their values in other properties, banks can be in any of them
+	template <typename FuncType>
+	static void ForEachInnerProperty(const FProperty* Property, FuncType&& Func)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			Func(ArrayProperty->Inner);
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			Func(SetProperty->ElementProp);
+		}
+		else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			Func(MapProperty->KeyProp);
+			Func(MapProperty->ValueProp);
+		}
+		else
+		{
+			Func(Property);
+		}
+	}
+
+	static bool ContainsBanks(FReport& Report, const UStruct* Type)
+	{
+		if (const bool* Known = Report.ContainsBanks.Find(Type))
+			return *Known;
+		//Recursive types are treated as bank free while they are being looked at
+		Report.ContainsBanks.Add(Type, false);
+		bool bContainsBanks = false;
+		for (TFieldIterator<FProperty> It(Type); It && !bContainsBanks; ++It)
+		{
+			ForEachInnerProperty(*It, [&Report, &bContainsBanks](const FProperty* Property)
+			{
+				if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+				{
+					bContainsBanks |= IsBankType(StructProperty->Struct) || ContainsBanks(Report, StructProperty->Struct);
+				}
+			});
+		}
+		Report.ContainsBanks.Add(Type, bContainsBanks);
+		return bContainsBanks;
+	}
+
+	static void VisitStruct(FReport& Report, const UStruct* Type, const void* Data, const FString& Path);
+
+	static void VisitValue(FReport& Report, const FProperty* Property, const void* Value, const FString& Path)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper Array(ArrayProperty, Value);
+			for (int32 Index = 0; Index < Array.Num(); ++Index)
+			{
+				VisitValue(Report, ArrayProperty->Inner, Array.GetRawPtr(Index), FString::Printf(TEXT("%s[%d]"), *Path, Index));
+			}
+			return;
+		}
+		//Set and map elements are named by their position in iteration order, they have no stable index
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			FScriptSetHelper Set(SetProperty, Value);
+			int32 Position = 0;
+			for (FScriptSetHelper::FIterator It(Set); It; ++It)
+			{
+				VisitValue(Report, SetProperty->ElementProp, Set.GetElementPtr(It), FString::Printf(TEXT("%s[%d]"), *Path, Position++));
+			}
+			return;
+		}
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			FScriptMapHelper Map(MapProperty, Value);
+			int32 Position = 0;
+			for (FScriptMapHelper::FIterator It(Map); It; ++It)
+			{
+				VisitValue(Report, MapProperty->KeyProp, Map.GetKeyPtr(It), FString::Printf(TEXT("%s[%d].Key"), *Path, Position));
+				VisitValue(Report, MapProperty->ValueProp, Map.GetValuePtr(It), FString::Printf(TEXT("%s[%d].Value"), *Path, Position));
+				++Position;
+			}
+			return;
+		}
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (!StructProperty)
+			return;
+		const UScriptStruct* Struct = StructProperty->Struct;
+		if (IsBankType(Struct))
+		{
+			FBankUsage& Usage = Report.Banks.AddDefaulted_GetRef();
+			Usage.Path = Path;
+			Usage.BankType = Struct->GetName();
+			//Bank structs only derive from one of the bases, which sit at the start of the struct
+			if (Struct->IsChildOf(FOGPolymorphicDataBankBase::StaticStruct()))
+			{
+				Usage.Bytes = static_cast<const FOGPolymorphicDataBankBase*>(Value)->GetAllocatedSize(&Report.BytesPerEntryType, &Report.CountedEntries);
+			}
+			else if (Struct->IsChildOf(FOGPolymorphicMultiBankBase::StaticStruct()))
+			{
+				Usage.Bytes = static_cast<const FOGPolymorphicMultiBankBase*>(Value)->GetAllocatedSize(&Report.BytesPerEntryType, &Report.CountedEntries);
+			}
+			else
+			{
+				Usage.Bytes = static_cast<const FOGOverlayDataBankBase*>(Value)->GetAllocatedSize(&Report.BytesPerEntryType, &Report.CountedEntries);
+			}
+			return;
+		}
+		VisitStruct(Report, Struct, Value, Path);
+	}
+
+	static void VisitStruct(FReport& Report, const UStruct* Type, const void* Data, const FString& Path)
+	{
+		if (!ContainsBanks(Report, Type))
+			return;
+		for (TFieldIterator<FProperty> It(Type); It; ++It)
+		{
+			for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+			{
+				const FString PropertyPath = It->ArrayDim > 1
+					? FString::Printf(TEXT("%s.%s[%d]"), *Path, *It->GetName(), ArrayIndex)
+					: FString::Printf(TEXT("%s.%s"), *Path, *It->GetName());
+				VisitValue(Report, *It, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex), PropertyPath);
+			}
+		}
+	}
+
+	static double ToKiB(const SIZE_T Bytes)
+	{
+		return Bytes / 1024.0;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		int32 NumTop = 20;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("Top="), NumTop);
+		}
+
+		//Banks are plain structs, so they are found through the reflected properties of every object holding one
+		FReport Report;
+		for (TObjectIterator<UObject> It(RF_ClassDefaultObject | RF_ArchetypeObject, true); It; ++It)
+		{
+			VisitStruct(Report, It->GetClass(), *It, It->GetPathName());
+		}
+
+		SIZE_T TotalBankBytes = 0;
+		for (const FBankUsage& Usage : Report.Banks)
+		{
+			TotalBankBytes += Usage.Bytes;
+		}
+		Report.Banks.Sort([](const FBankUsage& A, const FBankUsage& B) { return A.Bytes > B.Bytes; });
+
+		//Column stores aren't reflected, they are listed from their own registry
+		int32 NumColumnStores = 0;
+		SIZE_T TotalColumnStoreBytes = 0;
+		FOGDataBankColumnStore::ForEachLiveStore([&Report, &NumColumnStores, &TotalColumnStoreBytes](const FOGDataBankColumnStore& Store)
+		{
+			++NumColumnStores;
+			TotalColumnStoreBytes += Store.GetAllocatedSize(&Report.BytesPerEntryType);
+		});
+
+		Ar.Logf(TEXT("OGCore data banks: %d banks held by objects, %.1f KiB, entries shared between banks counted once"), Report.Banks.Num(), ToKiB(TotalBankBytes));
+		Ar.Logf(TEXT("OGCore column stores: %d stores, %.1f KiB"), NumColumnStores, ToKiB(TotalColumnStoreBytes));
+		Ar.Logf(TEXT("Top banks:"));
+		for (int32 Index = 0; Index < FMath::Min(NumTop, Report.Banks.Num()); ++Index)
+		{
+			const FBankUsage& Usage = Report.Banks[Index];
+			Ar.Logf(TEXT("  %10.1f KiB  %s (%s)"), ToKiB(Usage.Bytes), *Usage.Path, *Usage.BankType);
+		}
+
+		Report.BytesPerEntryType.ValueSort([](const SIZE_T A, const SIZE_T B) { return A > B; });
+		Ar.Logf(TEXT("Top entry types:"));
+		int32 NumPrinted = 0;
+		for (const auto& [EntryType, Bytes] : Report.BytesPerEntryType)
+		{
+			if (NumPrinted++ >= NumTop)
+				break;
+			Ar.Logf(TEXT("  %10.1f KiB  %s"), ToKiB(Bytes), *GetNameSafe(EntryType));
+		}
+
+		struct FConnectionUsage
+		{
+			int32 NumStates = 0;
+			SIZE_T Bytes = 0;
+		};
+		TMap<TWeakObjectPtr<UNetConnection>, FConnectionUsage> PerConnection;
+		FOGDataBankDeltaStateBase::ForEachLiveState([&PerConnection](const FOGDataBankDeltaStateBase& State)
+		{
+			FArchiveCountMem CountMem(nullptr);
+			State.CountBytes(CountMem);
+			FConnectionUsage& Usage = PerConnection.FindOrAdd(State.Connection);
+			++Usage.NumStates;
+			Usage.Bytes += CountMem.GetMax();
+		});
+		Ar.Logf(TEXT("Delta states per connection:"));
+		for (const auto& [Connection, Usage] : PerConnection)
+		{
+			const FString ConnectionName = Connection.IsValid() ? Connection->LowLevelDescribe() : TEXT("(closed connection)");
+			Ar.Logf(TEXT("  %10.1f KiB  %d states  %s"), ToKiB(Usage.Bytes), Usage.NumStates, *ConnectionName);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice Command(
+		TEXT("OGCore.DataBank.MemReport"),
+		TEXT("Lists the data banks and entry types using the most memory, and the data bank delta state memory per connection. Optional Top=N, default 20. Also runs as part of memreport."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&Run));
+}
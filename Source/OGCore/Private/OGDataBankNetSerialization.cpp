@@ -0,0 +1,32 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankNetSerialization.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/PackageMapClient.h"
+#include "Net/RepLayout.h"
+
+bool OGDataBankNet::NetSerializeEntry(FArchive& Ar, UPackageMap* Map, UScriptStruct* Struct, FOGPolymorphicStructBase* Data, bool& bOutSuccess)
+{
+	if (Struct->StructFlags & STRUCT_NetSerializeNative)
+	{
+		Struct->GetCppStructOps()->NetSerialize(Ar, Map, bOutSuccess, Data);
+		return false;
+	}
+	//modified from FInstancedStruct
+	UPackageMapClient* MapClient = Cast<UPackageMapClient>(Map);
+	check(::IsValid(MapClient));
+
+	UNetConnection* NetConnection = MapClient->GetConnection();
+	check(::IsValid(NetConnection));
+	check(::IsValid(NetConnection->GetDriver()));
+	
+	const TSharedPtr<FRepLayout> RepLayout = NetConnection->GetDriver()->GetStructRepLayout(Struct);
+	check(RepLayout.IsValid());
+
+	bool bHasUnmapped = false;
+	RepLayout->SerializePropertiesForStruct(Struct, static_cast<FBitArchive&>(Ar), Map, Data, bHasUnmapped);
+	bOutSuccess = true;
+	return bHasUnmapped;
+}
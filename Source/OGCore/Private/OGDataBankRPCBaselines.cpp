@@ -0,0 +1,250 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankRPCBaselines.h"
+
+#include "OGPolymorphicDataBank.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/Actor.h"
+
+FOGDataBankRPCBaselines& FOGDataBankRPCBaselines::Get()
+{
+	static FOGDataBankRPCBaselines Instance;
+	return Instance;
+}
+
+uint32 FOGDataBankRPCBaselines::AllocateStreamId()
+{
+	uint32 StreamId = NextStreamId.fetch_add(1, std::memory_order_relaxed);
+	//Skip 0 when the counter wraps, it means "no stream yet"
+	while (StreamId == 0)
+	{
+		StreamId = NextStreamId.fetch_add(1, std::memory_order_relaxed);
+	}
+	return StreamId;
+}
+
+FOGDataBankRPCBaselines::FConnection& FOGDataBankRPCBaselines::FindOrAddConnection(UPackageMap* Connection)
+{
+	if (FConnection* Existing = Connections.Find(Connection))
+		return *Existing;
+
+	//Closed connections are only cleaned up when a new one shows up, there are never many of them
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.Connection.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	FConnection& Added = Connections.Add(Connection);
+	Added.Connection = Connection;
+	return Added;
+}
+
+FOGDataBankRPCBaselines::FStream& FOGDataBankRPCBaselines::FindOrAddStream(FConnection& Connection, TMap<uint32, FStream>& Streams, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache)
+{
+	FStream* Stream = Streams.Find(StreamId);
+	if (!Stream)
+	{
+		//Banks that stopped sending never say so, the least recently used stream makes room
+		if (Streams.Num() >= MaxStreamsPerConnection)
+		{
+			uint32 OldestId = 0;
+			uint64 OldestUse = TNumericLimits<uint64>::Max();
+			for (const auto& [Id, Candidate] : Streams)
+			{
+				if (Candidate.LastUsed < OldestUse)
+				{
+					OldestId = Id;
+					OldestUse = Candidate.LastUsed;
+				}
+			}
+			Streams.Remove(OldestId);
+		}
+		Stream = &Streams.Add(StreamId);
+	}
+	if (Stream->StructCache != StructCache)
+	{
+		//Entry keys mean something else under another struct cache
+		Stream->Baselines.Reset();
+		Stream->StructCache = StructCache;
+	}
+	Stream->LastUsed = ++Connection.UseCounter;
+	return *Stream;
+}
+
+void FOGDataBankRPCBaselines::AddToRing(FStream& Stream, const uint16 Id, const FEntries& Entries)
+{
+	if (Stream.Baselines.Num() >= RingSize)
+	{
+		Stream.Baselines.RemoveAt(0, Stream.Baselines.Num() - RingSize + 1, EAllowShrinking::No);
+	}
+	FBaseline& Baseline = Stream.Baselines.AddDefaulted_GetRef();
+	Baseline.Id = Id;
+	Baseline.Entries = Entries;
+}
+
+const FOGDataBankRPCBaselines::FEntries* FOGDataBankRPCBaselines::FindAcknowledgedBaseline(const UPackageMap* Connection, const uint32 StreamId, uint16& OutId) const
+{
+	const FConnection* Found = Connections.Find(Connection);
+	const FStream* Stream = Found ? Found->SentStreams.Find(StreamId) : nullptr;
+	if (!Stream)
+		return nullptr;
+	for (int32 Index = Stream->Baselines.Num() - 1; Index >= 0; --Index)
+	{
+		if (Stream->Baselines[Index].bAcknowledged)
+		{
+			OutId = Stream->Baselines[Index].Id;
+			return &Stream->Baselines[Index].Entries;
+		}
+	}
+	return nullptr;
+}
+
+uint16 FOGDataBankRPCBaselines::AddSentBaseline(UPackageMap* Connection, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache, const FEntries& Entries)
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	FConnection& Found = FindOrAddConnection(Connection);
+	FStream& Stream = FindOrAddStream(Found, Found.SentStreams, StreamId, StructCache);
+	const uint16 Id = Found.NextId++;
+	AddToRing(Stream, Id, Entries);
+	return Id;
+}
+
+void FOGDataBankRPCBaselines::Acknowledge(const UPackageMap* Connection, TConstArrayView<uint16> Ids)
+{
+	FConnection* Found = Connections.Find(Connection);
+	if (!Found)
+		return;
+	for (auto& [StreamId, Stream] : Found->SentStreams)
+	{
+		for (FBaseline& Baseline : Stream.Baselines)
+		{
+			Baseline.bAcknowledged |= Ids.Contains(Baseline.Id);
+		}
+	}
+}
+
+void FOGDataBankRPCBaselines::ResetSentStreams(const UPackageMap* Connection, TConstArrayView<uint32> StreamIds)
+{
+	FConnection* Found = Connections.Find(Connection);
+	if (!Found)
+		return;
+	for (const uint32 StreamId : StreamIds)
+	{
+		Found->SentStreams.Remove(StreamId);
+	}
+}
+
+const FOGDataBankRPCBaselines::FEntries* FOGDataBankRPCBaselines::FindReceivedBaseline(const UPackageMap* Connection, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache, const uint16 Id) const
+{
+	const FConnection* Found = Connections.Find(Connection);
+	const FStream* Stream = Found ? Found->ReceivedStreams.Find(StreamId) : nullptr;
+	if (!Stream || Stream->StructCache != StructCache)
+		return nullptr;
+	const FBaseline* Baseline = Stream->Baselines.FindByPredicate([Id](const FBaseline& Candidate) { return Candidate.Id == Id; });
+	return Baseline ? &Baseline->Entries : nullptr;
+}
+
+void FOGDataBankRPCBaselines::AddReceivedBaseline(UPackageMap* Connection, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache, const uint16 Id, const FEntries& Entries)
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	FConnection& Found = FindOrAddConnection(Connection);
+	FStream& Stream = FindOrAddStream(Found, Found.ReceivedStreams, StreamId, StructCache);
+	AddToRing(Stream, Id, Entries);
+	//Without an ack component nobody consumes these, and the sender only still holds the most recent baselines anyway
+	if (Found.PendingAcks.Num() >= RingSize * MaxStreamsPerConnection)
+	{
+		Found.PendingAcks.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+	Found.PendingAcks.Add(Id);
+}
+
+void FOGDataBankRPCBaselines::ResetReceivedStream(UPackageMap* Connection, const uint32 StreamId)
+{
+	FConnection& Found = FindOrAddConnection(Connection);
+	Found.ReceivedStreams.Remove(StreamId);
+	if (!Found.PendingResets.Contains(StreamId))
+	{
+		if (Found.PendingResets.Num() >= MaxStreamsPerConnection)
+		{
+			Found.PendingResets.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+		Found.PendingResets.Add(StreamId);
+	}
+}
+
+void FOGDataBankRPCBaselines::ConsumePendingAcks(const UPackageMap* Connection, TArray<uint16>& OutIds, TArray<uint32>& OutResetStreams)
+{
+	FConnection* Found = Connections.Find(Connection);
+	OutIds = Found ? MoveTemp(Found->PendingAcks) : TArray<uint16>();
+	OutResetStreams = Found ? MoveTemp(Found->PendingResets) : TArray<uint32>();
+}
+
+void FOGDataBankRPCBaselines::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (auto& [ConnectionKey, Connection] : Connections)
+	{
+		for (TMap<uint32, FStream>* Streams : {&Connection.SentStreams, &Connection.ReceivedStreams})
+		{
+			for (auto& [StreamId, Stream] : *Streams)
+			{
+				for (FBaseline& Baseline : Stream.Baselines)
+				{
+					for (auto& [Key, Entry] : Baseline.Entries)
+					{
+						Collector.AddPropertyReferencesWithStructARO(Stream.StructCache->GetTypeForIndex(Key), &Entry.Get());
+					}
+				}
+			}
+		}
+	}
+}
+
+UOGDataBankBaselineAckComponent::UOGDataBankBaselineAckComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	SetIsReplicatedByDefault(true);
+}
+
+void UOGDataBankBaselineAckComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	const AActor* Owner = GetOwner();
+	const UNetConnection* Connection = Owner ? Owner->GetNetConnection() : nullptr;
+	if (!Connection)
+		return;
+	TArray<uint16> Ids;
+	TArray<uint32> ResetStreams;
+	FOGDataBankRPCBaselines::Get().ConsumePendingAcks(Connection->PackageMap, Ids, ResetStreams);
+	if (Ids.IsEmpty() && ResetStreams.IsEmpty())
+		return;
+	if (Owner->HasAuthority())
+	{
+		ClientAcknowledgeBaselines(Ids, ResetStreams);
+	}
+	else
+	{
+		ServerAcknowledgeBaselines(Ids, ResetStreams);
+	}
+}
+
+static void ApplyBaselineAcks(const AActor* Owner, const TArray<uint16>& Ids, const TArray<uint32>& ResetStreams)
+{
+	const UNetConnection* Connection = Owner->GetNetConnection();
+	if (!Connection)
+		return;
+	FOGDataBankRPCBaselines& Baselines = FOGDataBankRPCBaselines::Get();
+	Baselines.Acknowledge(Connection->PackageMap, Ids);
+	Baselines.ResetSentStreams(Connection->PackageMap, ResetStreams);
+}
+
+void UOGDataBankBaselineAckComponent::ServerAcknowledgeBaselines_Implementation(const TArray<uint16>& Ids, const TArray<uint32>& ResetStreams)
+{
+	ApplyBaselineAcks(GetOwner(), Ids, ResetStreams);
+}
+
+void UOGDataBankBaselineAckComponent::ClientAcknowledgeBaselines_Implementation(const TArray<uint16>& Ids, const TArray<uint32>& ResetStreams)
+{
+	ApplyBaselineAcks(GetOwner(), Ids, ResetStreams);
+}
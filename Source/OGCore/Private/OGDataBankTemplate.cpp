@@ -0,0 +1,125 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankTemplate.h"
+
+#include "OGCoreModule.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "OGDataBankTemplate"
+
+void UOGDataBankTemplate::Instantiate(FOGPolymorphicDataBankBase& DataBank) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UOGDataBankTemplate::Instantiate);
+	const TConstArrayView<TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>> Shared = GetSharedEntries(DataBank.GetInnerStruct(), DataBank.GetStructCache());
+
+	DataBank.Empty();
+	DataBank.DataMap.Reserve(Shared.Num());
+	for (const auto& [Key, Entry] : Shared)
+	{
+		DataBank.SetShared_Internal(Key, Entry, false);
+	}
+}
+
+TConstArrayView<TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>> UOGDataBankTemplate::GetSharedEntries(const UScriptStruct* InnerStruct, const FOGPolymorphicStructCache* StructCache) const
+{
+	FScopeLock Lock(&SharedEntriesLock);
+	const FSharedEntriesKey BankKey(InnerStruct, StructCache);
+	if (const FSharedEntryArray* Existing = SharedEntriesByBank.Find(BankKey))
+	{
+		return *Existing;
+	}
+	//The array's allocation doesn't move when the map grows, so views handed out earlier stay valid
+	FSharedEntryArray& Built = SharedEntriesByBank.Add(BankKey);
+	BuildSharedEntries(InnerStruct, StructCache, Built);
+	return Built;
+}
+
+const TSharedRef<FOGPolymorphicStructBase>* UOGDataBankTemplate::FindSharedEntry(const uint16 Key, const UScriptStruct* InnerStruct, const FOGPolymorphicStructCache* StructCache) const
+{
+	const TConstArrayView<TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>> Shared = GetSharedEntries(InnerStruct, StructCache);
+	const int32 Index = Algo::BinarySearchBy(Shared, Key, [](const TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>& Entry) { return Entry.Key; });
+	return Index != INDEX_NONE ? &Shared[Index].Value : nullptr;
+}
+
+void UOGDataBankTemplate::BuildSharedEntries(const UScriptStruct* InnerStruct, const FOGPolymorphicStructCache* StructCache, FSharedEntryArray& OutEntries) const
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	OutEntries.Reserve(Entries.Num());
+	for (const FInstancedStruct& Entry : Entries)
+	{
+		const UScriptStruct* Struct = Entry.GetScriptStruct();
+		if (!Struct || !Struct->IsChildOf(InnerStruct))
+		{
+			UE_LOG(LogOGCore, Warning, TEXT("%s: skipping template entry %s, it doesn't belong in %s"), *GetPathName(),
+				Struct ? *Struct->GetName() : TEXT("None"), *InnerStruct->GetName());
+			continue;
+		}
+		const uint16 Key = StructCache->GetIndexForType(Struct);
+		if (OutEntries.ContainsByPredicate([Key](const TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>& Existing) { return Existing.Key == Key; }))
+		{
+			UE_LOG(LogOGCore, Warning, TEXT("%s: skipping duplicate template entry %s"), *GetPathName(), *Struct->GetName());
+			continue;
+		}
+
+		TSharedRef<FOGPolymorphicStructBase> SharedEntry = FOGPolymorphicDataBankBase::AllocateEntry(Struct);
+		Struct->CopyScriptStruct(&SharedEntry.Get(), Entry.GetMemory());
+		//Banks never assign key 0 themselves, so an instance's first write is always seen as a change
+		SharedEntry->SetReplicationKey(0);
+		OutEntries.Emplace(Key, SharedEntry);
+	}
+	OutEntries.Sort([](const TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>& A, const TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>& B) { return A.Key < B.Key; });
+}
+
+#if WITH_EDITOR
+void UOGDataBankTemplate::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	// Banks instantiated earlier keep their references to the old entries, only new instances see the edit.
+	// Overlays that read through to this template must not hold on to entry pointers across an edit.
+	FScopeLock Lock(&SharedEntriesLock);
+	SharedEntriesByBank.Reset();
+}
+
+EDataValidationResult UOGDataBankTemplate::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+	const UScriptStruct* InnerStruct = FOGPolymorphicDataBankBase::GetInnerStructForBankType(BankType);
+	if (!InnerStruct)
+	{
+		Context.AddError(LOCTEXT("MissingBankType", "BankType must be set to a concrete data bank type"));
+		return EDataValidationResult::Invalid;
+	}
+
+	TSet<const UScriptStruct*> SeenTypes;
+	for (const FInstancedStruct& Entry : Entries)
+	{
+		const UScriptStruct* Struct = Entry.GetScriptStruct();
+		if (!Struct)
+		{
+			Context.AddError(LOCTEXT("EmptyEntry", "Template entries must have a type"));
+			Result = EDataValidationResult::Invalid;
+		}
+		else if (!Struct->IsChildOf(InnerStruct))
+		{
+			Context.AddError(FText::Format(LOCTEXT("WrongEntryType", "{0} doesn't derive from {1}"),
+				Struct->GetDisplayNameText(), InnerStruct->GetDisplayNameText()));
+			Result = EDataValidationResult::Invalid;
+		}
+		else if (SeenTypes.Contains(Struct))
+		{
+			Context.AddError(FText::Format(LOCTEXT("DuplicateEntryType", "{0} appears more than once, a data bank holds one entry per type"),
+				Struct->GetDisplayNameText()));
+			Result = EDataValidationResult::Invalid;
+		}
+		SeenTypes.Add(Struct);
+	}
+	return Result;
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
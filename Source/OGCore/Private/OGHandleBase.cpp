@@ -1,4 +1,53 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-
-#include "OGHandleBase.h"
+/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGHandleBase.h"
+
+#include "OGHandleNetIdMap.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/PackageMapClient.h"
+
+static const UNetDriver* GetNetDriver(UPackageMap* Map)
+{
+	const UPackageMapClient* MapClient = Cast<UPackageMapClient>(Map);
+	if (!MapClient || !MapClient->GetConnection())
+		return nullptr;
+	return MapClient->GetConnection()->GetDriver();
+}
+
+void OGHandle::NetSerializeId(FArchive& Ar, OGHandleIdType& Id)
+{
+	//0 to 32 significant bits, always written as a fixed 6 bit prefix
+	uint8 NumBits = Ar.IsSaving() ? (Id == 0 ? 0 : FMath::FloorLog2(Id) + 1) : 0;
+	Ar.SerializeBits(&NumBits, 6);
+	if (Ar.IsLoading() && NumBits > 32) [[unlikely]]
+	{
+		Ar.SetError();
+		NumBits = 0;
+	}
+	if (Ar.IsLoading())
+	{
+		Id = 0;
+	}
+	if (NumBits > 0)
+	{
+		Ar.SerializeBits(&Id, NumBits);
+	}
+}
+
+void OGHandle::NetSerializeMappedId(FArchive& Ar, UPackageMap* Map, const UScriptStruct* HandleType, OGHandleIdType& Id)
+{
+	const FOGHandleNetIdMap* IdMap = FOGHandleNetIdMap::Find(HandleType, GetNetDriver(Map));
+	if (Ar.IsSaving())
+	{
+		OGHandleIdType WireId = IdMap ? IdMap->LocalToServer(Id) : Id;
+		NetSerializeId(Ar, WireId);
+	}
+	else
+	{
+		OGHandleIdType WireId = 0;
+		NetSerializeId(Ar, WireId);
+		Id = IdMap ? IdMap->ServerToLocal(WireId) : WireId;
+	}
+}
@@ -0,0 +1,78 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGHandleNetIdMap.h"
+
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+
+TMap<TPair<FObjectKey, FObjectKey>, FOGHandleNetIdMap>& FOGHandleNetIdMap::GetMaps()
+{
+	static TMap<TPair<FObjectKey, FObjectKey>, FOGHandleNetIdMap> Maps;
+	return Maps;
+}
+
+FOGHandleNetIdMap& FOGHandleNetIdMap::FindOrAdd(const UScriptStruct* HandleType, const UObject* WorldContextObject)
+{
+	check(IsInGameThread());
+	const UWorld* World = GEngine->GetWorldFromContextObjectChecked(WorldContextObject);
+	ensureMsgf(World->GetNetMode() == NM_Client, TEXT("Handle id maps are only used on clients"));
+
+	// Registration is rare, drop the maps of net drivers that have gone away while we're here
+	TMap<TPair<FObjectKey, FObjectKey>, FOGHandleNetIdMap>& Maps = GetMaps();
+	for (auto It = Maps.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().Value.ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	return Maps.FindOrAdd(MakeTuple(FObjectKey(HandleType), FObjectKey(World->GetNetDriver())));
+}
+
+const FOGHandleNetIdMap* FOGHandleNetIdMap::Find(const UScriptStruct* HandleType, const UNetDriver* NetDriver)
+{
+	if (!NetDriver)
+		return nullptr;
+	return GetMaps().Find(MakeTuple(FObjectKey(HandleType), FObjectKey(NetDriver)));
+}
+
+void FOGHandleNetIdMap::Register(const OGHandleIdType ServerId, const OGHandleIdType LocalId)
+{
+	if (!ensure(ServerId != 0 && LocalId != 0)) [[unlikely]]
+		return;
+	UnregisterLocal(LocalId);
+	if (const OGHandleIdType* PreviousLocal = ServerToLocalMap.Find(ServerId))
+	{
+		LocalToServerMap.Remove(*PreviousLocal);
+	}
+	ServerToLocalMap.Add(ServerId, LocalId);
+	LocalToServerMap.Add(LocalId, ServerId);
+}
+
+void FOGHandleNetIdMap::UnregisterLocal(const OGHandleIdType LocalId)
+{
+	OGHandleIdType ServerId;
+	if (LocalToServerMap.RemoveAndCopyValue(LocalId, ServerId))
+	{
+		ServerToLocalMap.Remove(ServerId);
+	}
+}
+
+void FOGHandleNetIdMap::Empty()
+{
+	ServerToLocalMap.Empty();
+	LocalToServerMap.Empty();
+}
+
+OGHandleIdType FOGHandleNetIdMap::ServerToLocal(const OGHandleIdType ServerId) const
+{
+	const OGHandleIdType* LocalId = ServerToLocalMap.Find(ServerId);
+	return LocalId ? *LocalId : 0;
+}
+
+OGHandleIdType FOGHandleNetIdMap::LocalToServer(const OGHandleIdType LocalId) const
+{
+	const OGHandleIdType* ServerId = LocalToServerMap.Find(LocalId);
+	return ServerId ? *ServerId : 0;
+}
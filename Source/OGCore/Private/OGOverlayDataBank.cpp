@@ -0,0 +1,263 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGOverlayDataBank.h"
+
+#include "OGCoreModule.h"
+#include "OGDataBankTemplate.h"
+#include "UObject/CoreNet.h"
+
+void FOGOverlayDataBankBase::SetParent(const UOGDataBankTemplate* NewParent)
+{
+	if (Parent == NewParent)
+		return;
+	Parent = NewParent;
+	//Tombstones only mean something relative to the parent they hid entries of
+	Tombstones.Empty();
+	++GetOverrides().LastReplicationKey;
+}
+
+const TSharedRef<FOGPolymorphicStructBase>* FOGOverlayDataBankBase::FindParentEntry(const uint16 Key) const
+{
+	if (!Parent || Tombstones.Contains(Key))
+		return nullptr;
+	return Parent->FindSharedEntry(Key, GetInnerStruct(), GetStructCache());
+}
+
+bool FOGOverlayDataBankBase::Contains_Internal(const uint16 Key) const
+{
+	return GetOverrides().DataMap.Contains(Key) || FindParentEntry(Key);
+}
+
+const FOGPolymorphicStructBase* FOGOverlayDataBankBase::FindConst_Internal(const uint16 Key) const
+{
+	if (const FOGPolymorphicStructBase* Override = GetOverrides().GetConst_Internal(Key))
+		return Override;
+	const TSharedRef<FOGPolymorphicStructBase>* ParentEntry = FindParentEntry(Key);
+	return ParentEntry ? &ParentEntry->Get() : nullptr;
+}
+
+FOGPolymorphicStructBase* FOGOverlayDataBankBase::Find_Internal(const uint16 Key)
+{
+	FOverrideBank& Bank = GetOverrides();
+	if (!Bank.DataMap.Contains(Key))
+	{
+		const TSharedRef<FOGPolymorphicStructBase>* ParentEntry = FindParentEntry(Key);
+		if (!ParentEntry)
+			return nullptr;
+		//Share the parent's entry, the copy on write in Get_Internal then gives the override its own copy
+		Bank.SetShared_Internal(Key, *ParentEntry, false);
+	}
+	return Bank.Get_Internal(Key);
+}
+
+FOGPolymorphicStructBase& FOGOverlayDataBankBase::FindOrAddOverride_Internal(const uint16 Key, const UScriptStruct* ScriptStruct)
+{
+	if (FOGPolymorphicStructBase* Existing = Find_Internal(Key))
+		return *Existing;
+	Tombstones.Remove(Key);
+	return GetOverrides().AddUnique_Internal(Key, ScriptStruct);
+}
+
+void FOGOverlayDataBankBase::Remove_Internal(const uint16 Key)
+{
+	FOverrideBank& Bank = GetOverrides();
+	Bank.Remove_Internal(Key);
+	if (FindParentEntry(Key))
+	{
+		Tombstones.Add(Key);
+	}
+	++Bank.LastReplicationKey;
+}
+
+void FOGOverlayDataBankBase::RevertToParent_Internal(const uint16 Key)
+{
+	FOverrideBank& Bank = GetOverrides();
+	Bank.Remove_Internal(Key);
+	Tombstones.Remove(Key);
+	++Bank.LastReplicationKey;
+}
+
+void FOGOverlayDataBankBase::GatherKeys(const TPair<uint16, uint16>& Range, TArray<uint16, TInlineAllocator<16>>& OutKeys) const
+{
+	const FOverrideBank& Bank = GetOverrides();
+	for (const auto& [Key, Entry] : Bank.DataMap)
+	{
+		if (Key >= Range.Key && Key < Range.Value)
+		{
+			OutKeys.Add(Key);
+		}
+	}
+	if (Parent)
+	{
+		//Shared entries are sorted by key, so only the range is walked
+		for (const auto& [Key, Entry] : Parent->GetSharedEntries(GetInnerStruct(), GetStructCache()))
+		{
+			if (Key >= Range.Value)
+				break;
+			if (Key >= Range.Key && !Bank.DataMap.Contains(Key) && !Tombstones.Contains(Key))
+			{
+				OutKeys.Add(Key);
+			}
+		}
+	}
+	OutKeys.Sort();
+}
+
+int32 FOGOverlayDataBankBase::Num() const
+{
+	const FOverrideBank& Bank = GetOverrides();
+	int32 Count = Bank.DataMap.Num();
+	if (Parent)
+	{
+		for (const auto& [Key, Entry] : Parent->GetSharedEntries(GetInnerStruct(), GetStructCache()))
+		{
+			if (!Bank.DataMap.Contains(Key) && !Tombstones.Contains(Key))
+			{
+				++Count;
+			}
+		}
+	}
+	return Count;
+}
+
+void FOGOverlayDataBankBase::Empty()
+{
+	GetOverrides().Empty();
+	Tombstones.Empty();
+}
+
+SIZE_T FOGOverlayDataBankBase::GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType, TSet<const void*>* InOutCountedEntries) const
+{
+	return GetOverrides().GetAllocatedSize(OutBytesPerEntryType, InOutCountedEntries) + Tombstones.GetAllocatedSize();
+}
+
+void FOGOverlayDataBankBase::AddStructReferencedObjects(FReferenceCollector& Collector)
+{
+	//The parent is a UPROPERTY and owns the entries shared with it, only the overrides need reporting
+	GetOverrides().AddStructReferencedObjects(Collector);
+}
+
+void FOGOverlayDataBankBase::SerializeParentAndTombstones(FArchive& Ar, UPackageMap* Map)
+{
+	UObject* ParentObject = const_cast<UOGDataBankTemplate*>(Parent.Get());
+	FNetworkGUID ParentGUID;
+	Map->SerializeObject(Ar, UOGDataBankTemplate::StaticClass(), ParentObject, &ParentGUID);
+
+	uint32 TombstoneNum = Tombstones.Num();
+	Ar.SerializeIntPacked(TombstoneNum);
+	if (Ar.IsSaving())
+	{
+		for (uint16 Key : Tombstones)
+		{
+			Ar << Key;
+		}
+		return;
+	}
+
+	Tombstones.Reset();
+	for (uint32 Idx = 0; Idx < TombstoneNum && !Ar.IsError(); ++Idx)
+	{
+		uint16 Key;
+		Ar << Key;
+		Tombstones.Add(Key);
+	}
+	//A parent that isn't loaded on this end yet is picked up by UpdateUnmappedParent once it is
+	UnmappedParentGUID = !ParentObject && ParentGUID.IsValid() ? ParentGUID : FNetworkGUID();
+	UOGDataBankTemplate* NewParent = Cast<UOGDataBankTemplate>(ParentObject);
+	if (ParentObject && !NewParent)
+	{
+		UE_LOG(LogOGCore, Warning, TEXT("Overlay data bank received a parent that isn't a data bank template: %s"), *GetNameSafe(ParentObject));
+	}
+	Parent = NewParent;
+}
+
+void FOGOverlayDataBankBase::UpdateUnmappedParent(FNetDeltaSerializeInfo& DeltaParams)
+{
+	if (!UnmappedParentGUID.IsValid())
+		return;
+	if (DeltaParams.Map->IsGUIDBroken(UnmappedParentGUID, false))
+	{
+		UnmappedParentGUID = FNetworkGUID();
+		return;
+	}
+	UObject* ParentObject = DeltaParams.Map->GetObjectFromNetGUID(UnmappedParentGUID, false);
+	if (!ParentObject)
+	{
+		DeltaParams.bOutHasMoreUnmapped = true;
+		return;
+	}
+
+	UnmappedParentGUID = FNetworkGUID();
+	DeltaParams.bOutSomeObjectsWereMapped = true;
+	if (!DeltaParams.bCalledPreNetReceive)
+	{
+		DeltaParams.Object->PreNetReceive();
+		DeltaParams.bCalledPreNetReceive = true;
+	}
+	//Tombstones arrived along with the guid and still belong to this parent, so this doesn't go through SetParent
+	Parent = Cast<UOGDataBankTemplate>(ParentObject);
+	if (!Parent)
+	{
+		UE_LOG(LogOGCore, Warning, TEXT("Overlay data bank received a parent that isn't a data bank template: %s"), *GetNameSafe(ParentObject));
+	}
+}
+
+bool FOGOverlayDataBankBase::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGOverlayDataBankBase::NetSerialize);
+	SerializeParentAndTombstones(Ar, Map);
+	return GetOverrides().NetSerialize(Ar, Map, bOutSuccess);
+}
+
+bool FOGOverlayDataBankBase::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGOverlayDataBankBase::NetDeltaSerialize);
+	FOverrideBank& Bank = GetOverrides();
+	if (DeltaParams.GatherGuidReferences)
+	{
+		if (UnmappedParentGUID.IsValid())
+		{
+			DeltaParams.GatherGuidReferences->Add(UnmappedParentGUID);
+		}
+		return Bank.NetDeltaSerialize(DeltaParams);
+	}
+
+	if (DeltaParams.bUpdateUnmappedObjects)
+	{
+		UpdateUnmappedParent(DeltaParams);
+		return Bank.NetDeltaSerialize(DeltaParams);
+	}
+
+	//Templates are assets, their guids are never dynamic, so only the overrides can have guids to move
+	if (DeltaParams.MoveGuidToUnmapped)
+	{
+		return Bank.NetDeltaSerialize(DeltaParams);
+	}
+
+	if (DeltaParams.Writer)
+	{
+		FBitWriter& Writer = *DeltaParams.Writer;
+		//The overrides return false without writing anything when nothing changed. Parent and tombstone changes bump
+		//the override bank's key, so they are always sent along with the next change.
+		if (!Bank.NetDeltaSerialize(DeltaParams))
+			return false;
+		SerializeParentAndTombstones(Writer, DeltaParams.Map);
+		return true;
+	}
+
+	check(DeltaParams.Reader);
+	FBitReader& Reader = *DeltaParams.Reader;
+	const bool bResult = Bank.NetDeltaSerialize(DeltaParams);
+	SerializeParentAndTombstones(Reader, DeltaParams.Map);
+	if (UnmappedParentGUID.IsValid())
+	{
+		DeltaParams.bOutHasMoreUnmapped = true;
+	}
+	return bResult;
+}
+
+FOGPolymorphicStructCache* FOGOverlayDataBankBase::GetStructCache() const
+{
+	return FOGCoreModule::GetUniversalStructCache();
+}
@@ -1,539 +1,1382 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-
-#include "OGPolymorphicDataBank.h"
-
-#include "OGCoreModule.h"
-#include "Engine/PackageMapClient.h"
-#include "Net/RepLayout.h"
-
-FOGPolymorphicDataBankBase::FOGPolymorphicDataBankBase(const FOGPolymorphicDataBankBase& Other)
-{
-	DataMap.Reserve(Other.DataMap.Num());
-	const FOGPolymorphicStructCache* StructCache = GetStructCache();
-	for (auto& [Key, SharedRef] : Other.DataMap)
-	{
-		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
-		FOGPolymorphicStructBase* DataPtr = &AddUnique_Internal(Key, Struct);
-		Struct->CopyScriptStruct(DataPtr, &SharedRef.Get());
-		MarkDirty(*DataPtr);
-	}
-}
-
-FOGPolymorphicDataBankBase& FOGPolymorphicDataBankBase::operator=(const FOGPolymorphicDataBankBase& Other)
-{
-	DataMap.Empty();
-	DataMap.Reserve(Other.DataMap.Num());
-	const FOGPolymorphicStructCache* StructCache = GetStructCache();
-	for (auto& [Key, SharedRef] : Other.DataMap)
-	{
-		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
-		FOGPolymorphicStructBase* DataPtr = &AddUnique_Internal(Key, Struct);
-		Struct->CopyScriptStruct(DataPtr, &SharedRef.Get());
-		MarkDirty(*DataPtr);
-	}
-	return *this;
-}
-
-void FOGPolymorphicDataBankBase::Empty()
-{
-	DataMap.Empty();
-	GuidReferencesMap.Empty();
-	++LastReplicationKey;
-#if WITH_EDITOR
-	AvailableDataTypes.Empty();
-#endif
-}
-
-void FOGPolymorphicDataBankBase::AddStructReferencedObjects(FReferenceCollector& Collector)
-{
-	const FOGPolymorphicStructCache* StructCache = GetStructCache();
-	if(!ensure(StructCache))
-		return;
-	for (auto& [Key, SharedRef] : DataMap)
-	{
-		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
-		if (!ensure(Struct))
-			continue;
-		Collector.AddPropertyReferencesWithStructARO(Struct, &SharedRef.Get());
-	}
-}
-
-bool FOGPolymorphicDataBankBase::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
-{
-	const FOGPolymorphicStructCache* StructCache = GetStructCache();
-	if(!ensure(StructCache)) [[unlikely]]
-		return false;
-	ensure(DataMap.Num() <= 255);
-	uint8 DataNum = DataMap.Num();
-	Ar << DataNum;
-	
-	if (Ar.IsSaving())
-	{
-		for (auto& [StructKey, SharedRef] : DataMap)
-		{
-			UScriptStruct* Struct = StructCache->GetTypeForIndex(StructKey);
-			Ar << StructKey;
-			if(!ensure(Struct)) [[unlikely]]
-				return false;
-			if (Struct->StructFlags & STRUCT_NetSerializeNative)
-			{
-				Struct->GetCppStructOps()->NetSerialize(Ar, Map, bOutSuccess, &SharedRef.Get());
-			}
-			else
-			{
-				//modified from FInstancedStruct
-				UPackageMapClient* MapClient = Cast<UPackageMapClient>(Map);
-				check(::IsValid(MapClient));
-
-				UNetConnection* NetConnection = MapClient->GetConnection();
-				check(::IsValid(NetConnection));
-				check(::IsValid(NetConnection->GetDriver()));
-				
-				const TSharedPtr<FRepLayout> RepLayout = NetConnection->GetDriver()->GetStructRepLayout(Struct);
-				check(RepLayout.IsValid());
-
-				bool bHasUnmapped = false;
-				RepLayout->SerializePropertiesForStruct(Struct, static_cast<FBitArchive&>(Ar), Map, &SharedRef.Get(), bHasUnmapped);
-				bOutSuccess = true;
-			}
-		}
-		return true;
-	}
-	else
-	{
-		//When loading, need to clear out the old values first.
-		Empty();
-		bool bHasUnmapped = false;
-		for (uint8 Idx = 0; Idx < DataNum; ++Idx)
-		{
-			uint16 StructKey;
-			Ar << StructKey;
-			UScriptStruct* Struct = StructCache->GetTypeForIndex(StructKey);
-			if(!ensure(Struct)) [[unlikely]]
-				return false;
-			FOGPolymorphicStructBase* NewStructData = &AddUnique_Internal(StructKey, Struct);
-			if (Struct->StructFlags & STRUCT_NetSerializeNative)
-			{
-				Struct->GetCppStructOps()->NetSerialize(Ar, Map, bOutSuccess, NewStructData);
-			}
-			else
-			{
-				//modified from FInstancedStruct
-				UPackageMapClient* MapClient = Cast<UPackageMapClient>(Map);
-				check(::IsValid(MapClient));
-
-				UNetConnection* NetConnection = MapClient->GetConnection();
-				check(::IsValid(NetConnection));
-				check(::IsValid(NetConnection->GetDriver()));
-				
-				const TSharedPtr<FRepLayout> RepLayout = NetConnection->GetDriver()->GetStructRepLayout(Struct);
-				check(RepLayout.IsValid());
-
-				bool bHasUnmappedScoped = false;
-				RepLayout->SerializePropertiesForStruct(Struct, static_cast<FBitArchive&>(Ar), Map, NewStructData, bHasUnmappedScoped);
-				bOutSuccess = true;
-				bHasUnmapped |= bHasUnmappedScoped;
-			}
-		}
-		return !bHasUnmapped;
-	}
-}
-
-bool FOGPolymorphicDataBankBase::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
-{
-	//full serialize the internal structs
-	if ( DeltaParams.GatherGuidReferences )
-	{
-		// Loop over all tracked guids, and return what we have
-		for ( const auto& [StructKey, GuidReferences] : GuidReferencesMap )
-		{
-			DeltaParams.GatherGuidReferences->Append( GuidReferences.UnmappedGUIDs );
-			DeltaParams.GatherGuidReferences->Append( GuidReferences.MappedDynamicGUIDs );
-
-			if ( DeltaParams.TrackedGuidMemoryBytes )
-			{
-				*DeltaParams.TrackedGuidMemoryBytes += GuidReferences.Buffer.Num();
-			}
-		}
-		return true;
-	}
-
-	if ( DeltaParams.MoveGuidToUnmapped )
-	{
-		bool bFound = false;
-
-		const FNetworkGUID GUID = *DeltaParams.MoveGuidToUnmapped;
-
-		// Try to find the guid in the list, and make sure it's on the unmapped lists now
-		for ( auto& [StructKey, GuidReferences] : GuidReferencesMap )
-		{
-			if ( GuidReferences.MappedDynamicGUIDs.Contains( GUID ) )
-			{
-				GuidReferences.MappedDynamicGUIDs.Remove( GUID );
-				GuidReferences.UnmappedGUIDs.Add( GUID );
-				bFound = true;
-			}
-		}
-		
-		return bFound;
-	}
-
-	if ( DeltaParams.bUpdateUnmappedObjects )
-	{
-		TArray<uint16, TInlineAllocator<8>> ChangedIndices;
-		TSet<uint16> KeysToRemove;
-
-		// Loop over each item that has unmapped objects
-		for ( auto& [StructKey, GuidReferences] : GuidReferencesMap)
-		{			
-			if ( ( GuidReferences.UnmappedGUIDs.Num() == 0 && GuidReferences.MappedDynamicGUIDs.Num() == 0 ) || !DataMap.Contains( StructKey ))
-			{
-				// If for some reason the item is gone (or all guids were removed), we don't need to track guids for this item anymore
-				KeysToRemove.Add(StructKey);
-				continue;		// We're done with this unmapped item
-			}
-
-			// Loop over all the guids, and check to see if any of them are loaded yet
-			bool bMappedSomeGUIDs = false;
-
-			for ( auto UnmappedIt = GuidReferences.UnmappedGUIDs.CreateIterator(); UnmappedIt; ++UnmappedIt )
-			{
-				const FNetworkGUID& GUID = *UnmappedIt;
-
-				if ( DeltaParams.Map->IsGUIDBroken( GUID, false ) )
-				{
-					// Stop trying to load broken guids
-					UnmappedIt.RemoveCurrent();
-					continue;
-				}
-
-				UObject* Object = DeltaParams.Map->GetObjectFromNetGUID( GUID, false );
-
-				if ( Object != nullptr )
-				{
-					// This guid loaded!
-					if ( GUID.IsDynamic() )
-					{
-						GuidReferences.MappedDynamicGUIDs.Add( GUID );		// Move back to mapped list
-					}
-					UnmappedIt.RemoveCurrent();
-					bMappedSomeGUIDs = true;
-				}
-			}
-
-			// Check to see if we loaded any guids. If we did, we can serialize the element again which will load it this time
-			if ( bMappedSomeGUIDs )
-			{
-				DeltaParams.bOutSomeObjectsWereMapped = true;
-
-				if ( !DeltaParams.bCalledPreNetReceive )
-				{
-					// Call PreNetReceive if we are going to change a value (some game code will need to think this is an actual replicated value)
-					DeltaParams.Object->PreNetReceive();
-					DeltaParams.bCalledPreNetReceive = true;
-				}
-
-				FOGPolymorphicStructBase& ThisElement = DataMap.FindChecked( StructKey ).Get();
-
-				ChangedIndices.Add(StructKey);
-
-				// Initialize the reader with the stored buffer that we need to read from
-				FNetBitReader Reader( DeltaParams.Map, GuidReferences.Buffer.GetData(), GuidReferences.NumBufferBits );
-
-				// Read the property (which should serialize any newly mapped objects as well)
-				DeltaParams.Struct = GetStructCache()->GetTypeForIndex(StructKey);
-				DeltaParams.Data = &ThisElement;
-				DeltaParams.Reader = &Reader;
-				DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
-
-				// Let the element know it changed TODO - Once Post Replicated Change is implemented
-				//ThisElement->PostReplicatedChange(ArraySerializer);
-			}
-
-			// If we have no more guids, we can remove this item for good
-			if ( GuidReferences.UnmappedGUIDs.Num() == 0 && GuidReferences.MappedDynamicGUIDs.Num() == 0 )
-			{
-				KeysToRemove.Add(StructKey);
-			}
-		}
-
-		for (uint16 Key : KeysToRemove)
-		{
-			Remove_Internal(Key);
-		}
-			
-		// If we still have unmapped items, then communicate this to the outside
-		if ( GuidReferencesMap.Num() > 0 )
-		{
-			DeltaParams.bOutHasMoreUnmapped = true;
-		}
-
-		//TODO: Once Post Replicated Change is implemented for the data bank
-		/*if (DeltaParams.bOutSomeObjectsWereMapped)
-		{
-			ArraySerializer.PostReplicatedChange(ChangedIndices, Items.Num());
-			Helper.CallPostReplicatedReceiveOrNot(Items.Num());
-		}*/
-		
-		return true;
-	}
-
-	//TODO: Optionally delta serialize internal structs, but only after initial replication has completed
-
-	if (DeltaParams.Writer)
-	{
-		//-----------------------------
-		// Saving
-		//-----------------------------	
-		check(DeltaParams.Struct);
-		
-		// Get the old map if its there
-		TMap<uint16, uint16> * OldMap = nullptr;
-		TSet<uint16> OldKeys;
-		int32 BaseReplicationKey = INDEX_NONE;
-
-		// See if the array changed at all. If the ArrayReplicationKey matches we can skip checking individual items
-		if (DeltaParams.OldState)
-		{
-			OldMap = &static_cast<FOGPolymorphicDataBankDeltaState*>(DeltaParams.OldState)->IDToRepKeyMap;
-			BaseReplicationKey = static_cast<FOGPolymorphicDataBankDeltaState*>(DeltaParams.OldState)->ContainerReplicationKey;
-			
-			if (BaseReplicationKey == LastReplicationKey) //If the container is not dirty, we're done
-			{
-				*DeltaParams.NewState = DeltaParams.OldState->AsShared();
-				return false;
-			}
-			OldMap->GetKeys(OldKeys);
-		}
-
-		// Create a new map from the current state of the array		
-		FOGPolymorphicDataBankDeltaState * NewState = new FOGPolymorphicDataBankDeltaState();
-
-		check(DeltaParams.NewState);
-		*DeltaParams.NewState = MakeShareable( NewState );
-		TMap<uint16, uint16>& NewMap = NewState->IDToRepKeyMap;
-		NewState->ContainerReplicationKey = LastReplicationKey;
-
-		TSet<uint16> ChangedKeys, AllCurrentKeys;
-		for (auto& [Key, DataStruct] : DataMap)
-		{
-			AllCurrentKeys.Add(Key);
-			NewMap.Add(Key, DataStruct->ReplicationKey);
-			if (OldKeys.Contains(Key))
-			{
-				if (DataStruct->ReplicationKey != OldMap->FindChecked(Key))
-				{
-					ChangedKeys.Add(Key);
-				}
-			}
-			else
-			{
-				ChangedKeys.Add(Key);
-			}
-		}
-
-		TSet<uint16> RemovedKeys; 
-		RemovedKeys = OldKeys.Difference(AllCurrentKeys);
-		
-		//----------------------
-		// Write it out.
-		//----------------------
-		FBitWriter& Writer = *DeltaParams.Writer;
-
-		uint8 RemovedCount = RemovedKeys.Num();
-		Writer << RemovedCount;
-		for (uint16& RemovedKey : RemovedKeys)
-		{
-			Writer << RemovedKey;
-		}
-
-		FOGPolymorphicStructCache* StructCache = GetStructCache();
-		uint8 ReplicatedCount = ChangedKeys.Num();
-		Writer << ReplicatedCount;
-		for (uint16& AddOrChangedKey : ChangedKeys)
-		{
-			Writer << AddOrChangedKey;
-			
-			UScriptStruct* Struct = StructCache->GetTypeForIndex(AddOrChangedKey);
-			FOGPolymorphicStructBase* DataPtr = &DataMap.Find(AddOrChangedKey)->Get();
-			ensure(Struct);
-			DeltaParams.Struct = Struct;
-			DeltaParams.Data = DataPtr;
-			DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
-		}
-	}
-	else
-	{
-		//-----------------------------
-		// Loading
-		//-----------------------------	
-		check(DeltaParams.Reader);
-		FBitReader& Reader = *DeltaParams.Reader;
-
-		//---------------
-		// Read Removed elements
-		//---------------
-		uint8 RemovedCount;
-		Reader << RemovedCount;
-		//TODO PreReplicatedRemove callback before any removals take place
-		for (int Idx = 0; Idx < RemovedCount; ++Idx)
-		{
-			uint16 RemovedKey;
-			Reader << RemovedKey;
-			Remove_Internal(RemovedKey);
-			GuidReferencesMap.Remove(RemovedKey);
-		}
-
-		//---------------
-		// Read Changed/New elements
-		//---------------
-		FOGPolymorphicStructCache* StructCache = GetStructCache();
-		uint8 AddOrChangedCount;
-		Reader << AddOrChangedCount;
-		TSet<uint16> ChangedKeys, AddedKeys;
-		for (int Idx = 0; Idx < AddOrChangedCount; ++Idx)
-		{
-			uint16 AddedOrChangedKey;
-			Reader << AddedOrChangedKey;
-			UScriptStruct* Struct = StructCache->GetTypeForIndex(AddedOrChangedKey);
-			ensure(Struct);
-
-			FOGPolymorphicStructBase* DataPtr;
-			if (DataMap.Contains(AddedOrChangedKey))
-			{
-				ChangedKeys.Add(AddedOrChangedKey);
-				DataPtr = Get_Internal(AddedOrChangedKey);
-			}
-			else
-			{
-				AddedKeys.Add(AddedOrChangedKey);
-				DataPtr = &AddUnique_Internal(AddedOrChangedKey, Struct);
-			}
-			
-			// Let package map know we want to track and know about any guids that are unmapped during the serialize call
-			DeltaParams.Map->ResetTrackedGuids( true );
-			// Remember where we started reading from, so that if we have unmapped properties, we can re-deserialize from this data later
-			FBitReaderMark Mark( Reader );
-
-			DeltaParams.Struct = Struct;
-			DeltaParams.Data = DataPtr;
-			DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
-
-			if ( !Reader.IsError() )
-			{
-				// Track unmapped guids
-                const TSet< FNetworkGUID >& TrackedUnmappedGuids = DeltaParams.Map->GetTrackedUnmappedGuids();
-                const TSet< FNetworkGUID >& TrackedMappedDynamicGuids = DeltaParams.Map->GetTrackedDynamicMappedGuids();
-
-				if ( TrackedUnmappedGuids.Num() || TrackedMappedDynamicGuids.Num() )
-				{
-					FOGPolymorphicDataBankSerializerGuidReferences& GuidReferences = GuidReferencesMap.FindOrAdd( AddedOrChangedKey );
-
-					// If guid lists are different, make note of that, and copy respective list
-					if ( !NetworkGuidSetsAreSame( GuidReferences.UnmappedGUIDs, TrackedUnmappedGuids ) )
-					{
-						// Copy the unmapped guid list to this unmapped item
-						GuidReferences.UnmappedGUIDs = TrackedUnmappedGuids;
-						DeltaParams.bGuidListsChanged = true;
-					}
-					
-					if ( !NetworkGuidSetsAreSame( GuidReferences.MappedDynamicGUIDs, TrackedMappedDynamicGuids ) )
-					{ 
-						// Copy the mapped guid list
-						GuidReferences.MappedDynamicGUIDs = TrackedMappedDynamicGuids;
-						DeltaParams.bGuidListsChanged = true;
-					}
-
-					// Copy the buffer into the guid references so we can re-serialize it when the guids change
-					GuidReferences.Buffer.Empty();
-
-					// Remember the number of bits in the buffer
-					check(Reader.GetPosBits() - Mark.GetPos() <= TNumericLimits<int32>::Max());
-					GuidReferences.NumBufferBits = int32(Reader.GetPosBits() - Mark.GetPos());
-					
-					// Copy the buffer itself
-					Mark.Copy( Reader, GuidReferences.Buffer );
-
-					// Hijack this property to communicate that we need to be tracked since we have some unmapped guids
-					if ( TrackedUnmappedGuids.Num() )
-					{
-						DeltaParams.bOutHasMoreUnmapped = true;
-					}
-				}
-				else
-				{
-					// If we don't have any unmapped objects, make sure we're no longer tracking this item in the unmapped lists
-					GuidReferencesMap.Remove( AddedOrChangedKey );
-				}
-			}
-
-			// Stop tracking unmapped objects
-			DeltaParams.Map->ResetTrackedGuids( false );
-		}
-		//TODO: PostReplicatedChange callback after finished updating data
-	}
-	return true;
-}
-
-FOGPolymorphicStructCache* FOGPolymorphicDataBankBase::GetStructCache() const
-{
-	return FOGCoreModule::GetUniversalStructCache();
-}
-
-FOGPolymorphicStructBase* FOGPolymorphicDataBankBase::Get_Internal(const uint16& Key)
-{
-	const TSharedRef<FOGPolymorphicStructBase>* Existing = DataMap.Find(Key);
-	if (!Existing)
-		return nullptr;
-	FOGPolymorphicStructBase& ExistingTyped = Existing->Get();
-	MarkDirty(ExistingTyped);
-	return &ExistingTyped;
-}
-
-const FOGPolymorphicStructBase* FOGPolymorphicDataBankBase::GetConst_Internal(const uint16& Key) const
-{
-	const TSharedRef<FOGPolymorphicStructBase>* Existing = DataMap.Find(Key);
-	if (!Existing)
-		return nullptr;
-	const FOGPolymorphicStructBase& ExistingTyped = Existing->Get();
-	return &ExistingTyped;
-}
-
-FOGPolymorphicStructBase& FOGPolymorphicDataBankBase::AddUnique_Internal(const uint16& Key,
-	const UScriptStruct* ScriptStruct)
-{
-	if (!ensureAlwaysMsgf(!DataMap.Contains(Key), TEXT("Tried adding a unique type, but type already exsists"))) [[unlikely]]
-		return *Get_Internal(Key);
-	//Cannot use the more convenient MakeShared<FOGPolymorphicStructBase> because when dealing with BP we will have access to the script struct but not the type
-	FOGPolymorphicStructBase* NewStructPtr = static_cast<FOGPolymorphicStructBase*>(FMemory::MallocZeroed(ScriptStruct->GetCppStructOps()->GetSize(), ScriptStruct->GetCppStructOps()->GetAlignment()));
-	if (ScriptStruct->GetCppStructOps()->HasNoopConstructor())
-	{
-		ScriptStruct->GetCppStructOps()->Construct(NewStructPtr);
-	}
-	MarkDirty(*NewStructPtr);
-	DataMap.Add(Key, TSharedRef<FOGPolymorphicStructBase>(NewStructPtr));
-
-#if WITH_EDITOR
-	AvailableDataTypes.Add(ScriptStruct->GetStructCPPName());
-#endif
-	
-	return *NewStructPtr;
-}
-
-void FOGPolymorphicDataBankBase::Remove_Internal(const uint16& Key, const UScriptStruct* ScriptStruct)
-{
-	DataMap.Remove(Key);
-#if WITH_EDITOR
-	FString NameToRemove;
-	if (ScriptStruct)
-	{
-		NameToRemove = ScriptStruct->GetStructCPPName();
-	}
-	else
-	{
-		NameToRemove = GetStructCache()->GetTypeForIndex(Key)->GetStructCPPName();
-	}
-	AvailableDataTypes.Remove(NameToRemove);
-#endif
-}
+/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGPolymorphicDataBank.h"
+
+#include "OGCoreModule.h"
+#include "OGDataBankNetSerialization.h"
+#include "OGDataBankRPCBaselines.h"
+#include "OGPolymorphicDataBankNetStats.h"
+#include "Async/UniqueLock.h"
+#include "Engine/PackageMapClient.h"
+#include "Misc/ScopeLock.h"
+#include "Net/Core/Trace/NetTrace.h"
+#include "Serialization/CustomVersion.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+struct FOGDataBankCustomVersion
+{
+	enum Type
+	{
+		// Entries carry their type path, layout hash and payload size, plain data entries are written member by member
+		InitialVersion = 0,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
+const FGuid FOGDataBankCustomVersion::GUID(0x5A0C64B1, 0x2E7F4D19, 0x9B3C8A42, 0x71D6E0F3);
+static FCustomVersionRegistration GRegisterOGDataBankCustomVersion(FOGDataBankCustomVersion::GUID, FOGDataBankCustomVersion::LatestVersion, TEXT("OGDataBank"));
+
+//Cannot use the more convenient MakeShared<FOGPolymorphicStructBase> because when dealing with BP we will have access to the script struct but not the type
+//The deleter has to go through the script struct as well, so the derived type's destructor runs
+//The memory is zeroed first so padding and members without initializers never hold stale heap bytes, which matters
+//for anything that hashes, compares or copies entries as raw memory
+TSharedRef<FOGPolymorphicStructBase> FOGPolymorphicDataBankBase::AllocateEntry(const UScriptStruct* ScriptStruct)
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	const UScriptStruct::ICppStructOps* StructOps = ScriptStruct->GetCppStructOps();
+	FOGPolymorphicStructBase* NewStructPtr = static_cast<FOGPolymorphicStructBase*>(FMemory::MallocZeroed(StructOps->GetSize(), StructOps->GetAlignment()));
+	ScriptStruct->InitializeStruct(NewStructPtr);
+	INC_MEMORY_STAT_BY(STAT_OGCore_EntryMemory, StructOps->GetSize());
+	return TSharedRef<FOGPolymorphicStructBase>(NewStructPtr, [ScriptStruct](FOGPolymorphicStructBase* Entry)
+	{
+		DEC_MEMORY_STAT_BY(STAT_OGCore_EntryMemory, ScriptStruct->GetCppStructOps()->GetSize());
+		ScriptStruct->DestroyStruct(Entry);
+		FMemory::Free(Entry);
+	});
+}
+
+//NetSerialize only gets an FArchive. When replication serializes for a connection that archive is the connection's
+//FNetBitWriter or FNetBitReader, which is the only case its bit position and trace collector are read.
+//Anything else (e.g. a bit stream in tests) reports no position and isn't traced.
+struct FOGNetArchiveStream
+{
+	FOGNetArchiveStream(FArchive& Ar, const UPackageMap* Map)
+	{
+		const UPackageMapClient* MapClient = Cast<UPackageMapClient>(Map);
+		if (!Ar.IsNetArchive() || !MapClient || !MapClient->GetConnection())
+		{
+			return;
+		}
+		if (Ar.IsSaving())
+		{
+			Writer = &static_cast<FNetBitWriter&>(Ar);
+			TraceCollector = GetTraceCollector(*Writer);
+		}
+		else
+		{
+			Reader = &static_cast<FNetBitReader&>(Ar);
+		}
+	}
+
+	int64 GetPosBits() const
+	{
+		return Writer ? Writer->GetNumBits() : Reader ? Reader->GetPosBits() : 0;
+	}
+
+	//The trace scopes only read their stream while they have a collector, untraced writes give them an empty one of their own
+	FNetBitWriter& GetTraceWriter()
+	{
+		return Writer ? *Writer : UntracedWriter.Emplace(0);
+	}
+
+	FNetBitWriter* Writer = nullptr;
+	FNetBitReader* Reader = nullptr;
+	UE::Net::FNetTraceCollector* TraceCollector = nullptr;
+
+private:
+	TOptional<FNetBitWriter> UntracedWriter;
+};
+
+FOGPolymorphicDataBankBase::FOGPolymorphicDataBankBase(const FOGPolymorphicDataBankBase& Other)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::CopyConstruct);
+	LLM_SCOPE_BYTAG(OGCore);
+	INC_DWORD_STAT(STAT_OGCore_LiveBanks);
+	//RPCs send a copy of the bank, which has to continue the original's stream for baselines to ever apply
+	BaselineStreamId = Other.GetOrAllocateBaselineStreamId();
+	DataMap.Reserve(Other.DataMap.Num());
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	for (auto& [Key, SharedRef] : Other.DataMap)
+	{
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		FOGPolymorphicStructBase* DataPtr = &AddUnique_Internal(Key, Struct);
+		CopyEntry_Internal(Key, *DataPtr, SharedRef.Get());
+		MarkDirty(*DataPtr);
+	}
+}
+
+FOGPolymorphicDataBankBase& FOGPolymorphicDataBankBase::operator=(const FOGPolymorphicDataBankBase& Other)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::Assign);
+	LLM_SCOPE_BYTAG(OGCore);
+	DEC_DWORD_STAT_BY(STAT_OGCore_LiveEntries, DataMap.Num());
+	for (const auto& [Key, Entry] : DataMap)
+	{
+		NotifyChanged(Key, false);
+	}
+	DataMap.Empty();
+	EntryHashes.Empty();
+	BaselineStreamId = Other.GetOrAllocateBaselineStreamId();
+	DataMap.Reserve(Other.DataMap.Num());
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	for (auto& [Key, SharedRef] : Other.DataMap)
+	{
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		FOGPolymorphicStructBase* DataPtr = &AddUnique_Internal(Key, Struct);
+		CopyEntry_Internal(Key, *DataPtr, SharedRef.Get());
+		MarkDirty(*DataPtr);
+	}
+	return *this;
+}
+
+void FOGPolymorphicDataBankBase::Empty()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::Empty);
+	DEC_DWORD_STAT_BY(STAT_OGCore_LiveEntries, DataMap.Num());
+	if (ChangeListeners)
+	{
+		for (const auto& [Key, Entry] : DataMap)
+		{
+			ChangeListeners->MarkChanged(Key, false);
+		}
+	}
+	DataMap.Empty();
+	GuidReferencesMap.Empty();
+	EntryHashes.Empty();
+	++LastReplicationKey;
+	++Version;
+#if WITH_EDITOR
+	AvailableDataTypes.Empty();
+#endif
+}
+
+TSharedRef<const FOGPolymorphicDataBankSnapshot> FOGPolymorphicDataBankBase::MakeSnapshot() const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::MakeSnapshot);
+	LLM_SCOPE_BYTAG(OGCore);
+	const TSharedRef<FOGPolymorphicDataBankSnapshot> Snapshot = MakeShared<FOGPolymorphicDataBankSnapshot>();
+	Snapshot->StructCache = GetStructCache();
+	Snapshot->InnerStruct = GetInnerStruct();
+	Snapshot->Entries = DataMap;
+	Snapshot->Version = Version;
+	return Snapshot;
+}
+
+bool FOGPolymorphicDataBankSnapshot::IsStale(const FOGPolymorphicDataBankBase& Bank) const
+{
+	return Version != Bank.GetVersion();
+}
+
+SIZE_T FOGPolymorphicDataBankBase::GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType, TSet<const void*>* InOutCountedEntries) const
+{
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	SIZE_T Size = DataMap.GetAllocatedSize();
+	for (const auto& [Key, Entry] : DataMap)
+	{
+		bool bAlreadyCounted = false;
+		if (InOutCountedEntries)
+		{
+			InOutCountedEntries->Add(&Entry.Get(), &bAlreadyCounted);
+		}
+		if (bAlreadyCounted)
+			continue;
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		const SIZE_T EntrySize = Struct->GetStructureSize() + EntryReferenceControllerSize + FOGPolymorphicStructCache::GetEntryHeapSize(Struct, &Entry.Get());
+		Size += EntrySize;
+		if (OutBytesPerEntryType)
+		{
+			OutBytesPerEntryType->FindOrAdd(Struct) += EntrySize;
+		}
+	}
+	Size += GuidReferencesMap.GetAllocatedSize();
+	for (const auto& [Key, GuidReferences] : GuidReferencesMap)
+	{
+		Size += GuidReferences.UnmappedGUIDs.GetAllocatedSize() + GuidReferences.MappedDynamicGUIDs.GetAllocatedSize() + GuidReferences.Buffer.GetAllocatedSize();
+	}
+	Size += EntryHashes.GetAllocatedSize();
+	if (ChangeListeners)
+	{
+		Size += sizeof(FOGDataBankChangeListeners);
+	}
+#if WITH_EDITORONLY_DATA
+	Size += AvailableDataTypes.GetAllocatedSize();
+	for (const FString& TypeName : AvailableDataTypes)
+	{
+		Size += TypeName.GetAllocatedSize();
+	}
+#endif
+	return Size;
+}
+
+uint32 FOGPolymorphicDataBankBase::GetEntryContentHash_Internal(const uint16 Key) const
+{
+	const FOGPolymorphicStructBase* Entry = GetConst_Internal(Key);
+	if (!Entry)
+		return 0;
+	{
+		UE::TUniqueLock Lock(EntryHashesLock);
+		if (const uint32* Cached = EntryHashes.Find(Key))
+			return *Cached;
+	}
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::HashEntry);
+	const uint32 Hash = FOGPolymorphicStructCache::HashEntry(GetStructCache()->GetTypeForIndex(Key), Entry);
+	UE::TUniqueLock Lock(EntryHashesLock);
+	EntryHashes.Add(Key, Hash);
+	return Hash;
+}
+
+void FOGPolymorphicDataBankBase::InvalidateEntryHash(const uint16 Key)
+{
+	UE::TUniqueLock Lock(EntryHashesLock);
+	EntryHashes.Remove(Key);
+}
+
+uint32 FOGPolymorphicDataBankBase::GetContentHash() const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::GetContentHash);
+	//Summed so the result doesn't depend on map order
+	uint32 Hash = GetTypeHash(DataMap.Num());
+	for (const auto& [Key, Entry] : DataMap)
+	{
+		Hash += HashCombine(GetTypeHash(Key), GetEntryContentHash_Internal(Key));
+	}
+	return Hash;
+}
+
+bool FOGPolymorphicDataBankBase::Equals(const FOGPolymorphicDataBankBase& Other) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::Equals);
+	if (this == &Other)
+		return true;
+	if (DataMap.Num() != Other.DataMap.Num() || GetInnerStruct() != Other.GetInnerStruct() || GetStructCache() != Other.GetStructCache())
+		return false;
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	for (const auto& [Key, Entry] : DataMap)
+	{
+		const TSharedRef<FOGPolymorphicStructBase>* OtherEntry = Other.DataMap.Find(Key);
+		if (!OtherEntry)
+			return false;
+		//Shared with a snapshot, template or the other bank
+		if (&OtherEntry->Get() == &Entry.Get())
+			continue;
+		if (!FOGPolymorphicStructCache::AreEntriesIdentical(StructCache->GetTypeForIndex(Key), &Entry.Get(), &OtherEntry->Get()))
+			return false;
+	}
+	return true;
+}
+
+bool FOGPolymorphicDataBankBase::IsRedundantWrite(const uint16 Key, const UScriptStruct* ScriptStruct, const void* NewValue) const
+{
+	if (!SkipsRedundantWrites())
+		return false;
+	const FOGPolymorphicStructBase* Existing = GetConst_Internal(Key);
+	if (!Existing || !FOGPolymorphicStructCache::AreEntriesIdentical(ScriptStruct, Existing, NewValue))
+		return false;
+	INC_DWORD_STAT(STAT_OGCore_RedundantWrites);
+	return true;
+}
+
+void FOGPolymorphicDataBankBase::AddStructReferencedObjects(FReferenceCollector& Collector)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::AddStructReferencedObjects);
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	if(!ensure(StructCache))
+		return;
+	for (auto& [Key, SharedRef] : DataMap)
+	{
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		if (!ensure(Struct))
+			continue;
+		Collector.AddPropertyReferencesWithStructARO(Struct, &SharedRef.Get());
+	}
+}
+
+uint32 FOGPolymorphicStructCache::ComputeLayoutHash(const UScriptStruct* Type)
+{
+	uint32 Hash = GetTypeHash(Type->GetStructureSize());
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(It->GetFName()));
+		Hash = HashCombine(Hash, GetTypeHash(It->GetCPPType()));
+		Hash = HashCombine(Hash, GetTypeHash(It->GetOffset_ForInternal()));
+		Hash = HashCombine(Hash, GetTypeHash(It->GetSize()));
+	}
+	return Hash;
+}
+
+static bool IsPlainDataProperty(const FProperty* Property)
+{
+	if (Property->IsA<FNumericProperty>() || Property->IsA<FBoolProperty>() || Property->IsA<FEnumProperty>())
+		return true;
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		return FOGPolymorphicStructCache::IsPlainData(StructProperty->Struct);
+	return false;
+}
+
+bool FOGPolymorphicStructCache::IsPlainData(const UScriptStruct* Type)
+{
+	const UScriptStruct::ICppStructOps* StructOps = Type->GetCppStructOps();
+	if (!StructOps || StructOps->HasDestructor())
+		return false;
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		if (!IsPlainDataProperty(*It))
+			return false;
+	}
+	return true;
+}
+
+static uint32 HashStructMembers(const UStruct* Type, const void* Data);
+
+//Floats compare with ==, so 0 and -0 must hash the same. NaNs never compare equal, they only get one hash to keep it stable.
+template <typename FloatType>
+static uint32 HashFloatValue(const FloatType Value)
+{
+	if (Value == 0)
+		return 0;
+	if (FMath::IsNaN(Value))
+		return GetTypeHash(TNumericLimits<uint32>::Max());
+	return GetTypeHash(Value);
+}
+
+static bool HasFloatMembers(const UStruct* Type)
+{
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			Property = ArrayProperty->Inner;
+		}
+		if (Property->IsA<FFloatProperty>() || Property->IsA<FDoubleProperty>())
+			return true;
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (HasFloatMembers(StructProperty->Struct))
+				return true;
+		}
+	}
+	return false;
+}
+
+//Hashes have to agree with Identical: values it considers equal must hash the same
+static uint32 HashPropertyValue(const FProperty* Property, const void* Value)
+{
+	if (Property->IsA<FFloatProperty>())
+		return HashFloatValue(*static_cast<const float*>(Value));
+	if (Property->IsA<FDoubleProperty>())
+		return HashFloatValue(*static_cast<const double*>(Value));
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		//Structs compared member by member hash that way too. Native comparisons of float structs (vectors, rotators...)
+		//are exact, so those are hashed by member as well, their own type hashes are bitwise.
+		const UScriptStruct* Struct = StructProperty->Struct;
+		if (!(Struct->StructFlags & STRUCT_IdenticalNative) || HasFloatMembers(Struct))
+			return HashStructMembers(Struct, Value);
+		//Otherwise the native type hash is expected to agree with the native comparison, without one all values share a hash
+		return (Property->PropertyFlags & CPF_HasGetValueTypeHash) ? Property->GetValueTypeHash(Value) : 0;
+	}
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper Array(ArrayProperty, Value);
+		uint32 Hash = GetTypeHash(Array.Num());
+		for (int32 Index = 0; Index < Array.Num(); ++Index)
+		{
+			Hash = HashCombine(Hash, HashPropertyValue(ArrayProperty->Inner, Array.GetRawPtr(Index)));
+		}
+		return Hash;
+	}
+	//Sets and maps compare regardless of element order, so their element hashes are summed
+	if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		FScriptSetHelper Set(SetProperty, Value);
+		uint32 Hash = GetTypeHash(Set.Num());
+		for (FScriptSetHelper::FIterator It(Set); It; ++It)
+		{
+			Hash += HashPropertyValue(SetProperty->ElementProp, Set.GetElementPtr(It));
+		}
+		return Hash;
+	}
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		FScriptMapHelper Map(MapProperty, Value);
+		uint32 Hash = GetTypeHash(Map.Num());
+		for (FScriptMapHelper::FIterator It(Map); It; ++It)
+		{
+			Hash += HashCombine(HashPropertyValue(MapProperty->KeyProp, Map.GetKeyPtr(It)), HashPropertyValue(MapProperty->ValueProp, Map.GetValuePtr(It)));
+		}
+		return Hash;
+	}
+	if (Property->PropertyFlags & CPF_HasGetValueTypeHash)
+		return Property->GetValueTypeHash(Value);
+	//Anything else without a value hash (texts, delegates) goes through its text form
+	FString Text;
+	Property->ExportTextItem_Direct(Text, Value, nullptr, nullptr, PPF_None);
+	return GetTypeHash(Text);
+}
+
+static bool IsEntryBaseProperty(const FProperty* Property)
+{
+	return Property->GetOwnerStruct() == FOGPolymorphicStructBase::StaticStruct();
+}
+
+static uint32 HashStructMembers(const UStruct* Type, const void* Data)
+{
+	uint32 Hash = 0;
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		if (IsEntryBaseProperty(*It))
+			continue;
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			Hash = HashCombine(Hash, HashPropertyValue(*It, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex)));
+		}
+	}
+	return Hash;
+}
+
+uint32 FOGPolymorphicStructCache::HashEntry(const UScriptStruct* Type, const void* Entry)
+{
+	return HashStructMembers(Type, Entry);
+}
+
+bool FOGPolymorphicStructCache::AreEntriesIdentical(const UScriptStruct* Type, const void* A, const void* B)
+{
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		if (IsEntryBaseProperty(*It))
+			continue;
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			if (!It->Identical_InContainer(A, B, ArrayIndex, PPF_None))
+				return false;
+		}
+	}
+	return true;
+}
+
+static SIZE_T GetStructHeapSize(const UStruct* Type, const void* Data);
+
+static SIZE_T GetPropertyHeapSize(const FProperty* Property, const void* Value)
+{
+	if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+		return StrProperty->GetPropertyValue(Value).GetAllocatedSize();
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		return GetStructHeapSize(StructProperty->Struct, Value);
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper Array(ArrayProperty, Value);
+		SIZE_T Size = static_cast<SIZE_T>(static_cast<const FScriptArray*>(Value)->Max()) * ArrayProperty->Inner->GetSize();
+		for (int32 Index = 0; Index < Array.Num(); ++Index)
+		{
+			Size += GetPropertyHeapSize(ArrayProperty->Inner, Array.GetRawPtr(Index));
+		}
+		return Size;
+	}
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		FScriptMapHelper Map(MapProperty, Value);
+		SIZE_T Size = static_cast<SIZE_T>(Map.GetMaxIndex()) * MapProperty->MapLayout.SetLayout.Size;
+		for (int32 Index = 0; Index < Map.GetMaxIndex(); ++Index)
+		{
+			if (Map.IsValidIndex(Index))
+			{
+				Size += GetPropertyHeapSize(MapProperty->KeyProp, Map.GetKeyPtr(Index));
+				Size += GetPropertyHeapSize(MapProperty->ValueProp, Map.GetValuePtr(Index));
+			}
+		}
+		return Size;
+	}
+	if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		FScriptSetHelper Set(SetProperty, Value);
+		SIZE_T Size = static_cast<SIZE_T>(Set.GetMaxIndex()) * SetProperty->SetLayout.Size;
+		for (int32 Index = 0; Index < Set.GetMaxIndex(); ++Index)
+		{
+			if (Set.IsValidIndex(Index))
+			{
+				Size += GetPropertyHeapSize(SetProperty->ElementProp, Set.GetElementPtr(Index));
+			}
+		}
+		return Size;
+	}
+	//Numbers, names and object references own no heap memory, text is shared
+	return 0;
+}
+
+static SIZE_T GetStructHeapSize(const UStruct* Type, const void* Data)
+{
+	SIZE_T Size = 0;
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			Size += GetPropertyHeapSize(*It, It->ContainerPtrToValuePtr<void>(Data, ArrayIndex));
+		}
+	}
+	return Size;
+}
+
+SIZE_T FOGPolymorphicStructCache::GetEntryHeapSize(const UScriptStruct* Type, const void* Entry)
+{
+	return GetStructHeapSize(Type, Entry);
+}
+
+//Plain data entries are written member by member instead of as a memory image, so padding, members that aren't UPROPERTYs
+//and FOGPolymorphicStructBase's replication key stay out of the archive, and numbers follow the archive's byte order
+static void SerializePlainDataMembers(FArchive& Ar, const UStruct* Type, void* Data)
+{
+	for (TFieldIterator<FProperty> It(Type); It; ++It)
+	{
+		if (IsEntryBaseProperty(*It))
+			continue;
+		const int32 ValueSize = It->GetSize() / It->ArrayDim;
+		for (int32 ArrayIndex = 0; ArrayIndex < It->ArrayDim; ++ArrayIndex)
+		{
+			void* Value = It->ContainerPtrToValuePtr<void>(Data, ArrayIndex);
+			if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(*It))
+			{
+				//Bools may be bitfields, so they go through the property
+				bool bValue = BoolProperty->GetPropertyValue(Value);
+				Ar << bValue;
+				if (Ar.IsLoading())
+				{
+					BoolProperty->SetPropertyValue(Value, bValue);
+				}
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(*It))
+			{
+				SerializePlainDataMembers(Ar, StructProperty->Struct, Value);
+			}
+			else
+			{
+				//Numbers and enums, IsPlainData allows nothing else
+				Ar.ByteOrderSerialize(Value, ValueSize);
+			}
+		}
+	}
+}
+
+bool FOGPolymorphicDataBankBase::Serialize(FArchive& Ar)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::Serialize);
+	LLM_SCOPE_BYTAG(OGCore);
+	Ar.UsingCustomVersion(FOGDataBankCustomVersion::GUID);
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	if (!ensure(StructCache)) [[unlikely]]
+		return false;
+
+	if (!Ar.IsSaving() && !Ar.IsLoading())
+	{
+		//Reference collectors and similar archives only need to visit the entries
+		for (auto& [Key, SharedRef] : DataMap)
+		{
+			StructCache->GetTypeForIndex(Key)->SerializeItem(Ar, &SharedRef.Get(), nullptr);
+		}
+		return true;
+	}
+
+	//Each entry's payload size is patched in after it was written and unknown entries are skipped on load, both seek
+	if (!ensureMsgf(Ar.Tell() != INDEX_NONE, TEXT("Data banks can only be saved to or loaded from archives that can seek, %s can't"), *Ar.GetArchiveName())) [[unlikely]]
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Empty();
+	}
+
+	int32 NumEntries = DataMap.Num();
+	Ar << NumEntries;
+
+	if (Ar.IsSaving())
+	{
+		for (auto& [Key, SharedRef] : DataMap)
+		{
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+			FTopLevelAssetPath TypePath(Struct);
+			uint32 LayoutHash = StructCache->GetLayoutHash(Key);
+			bool bPlainData = StructCache->IsPlainData(Key);
+			Ar << TypePath << LayoutHash << bPlainData;
+
+			//The payload size is patched in afterwards so loading can skip entries it doesn't understand
+			const int64 PayloadSizePos = Ar.Tell();
+			int64 PayloadSize = 0;
+			Ar << PayloadSize;
+			const int64 PayloadStart = Ar.Tell();
+			if (bPlainData)
+			{
+				SerializePlainDataMembers(Ar, Struct, &SharedRef.Get());
+			}
+			else
+			{
+				Struct->SerializeItem(Ar, &SharedRef.Get(), nullptr);
+			}
+			const int64 PayloadEnd = Ar.Tell();
+			PayloadSize = PayloadEnd - PayloadStart;
+			Ar.Seek(PayloadSizePos);
+			Ar << PayloadSize;
+			Ar.Seek(PayloadEnd);
+		}
+		return true;
+	}
+
+	const UScriptStruct* InnerStruct = GetInnerStruct();
+	for (int32 Idx = 0; Idx < NumEntries && !Ar.IsError(); ++Idx)
+	{
+		FTopLevelAssetPath TypePath;
+		uint32 SavedLayoutHash = 0;
+		bool bPlainData = false;
+		int64 PayloadSize = 0;
+		Ar << TypePath << SavedLayoutHash << bPlainData << PayloadSize;
+		const int64 PayloadEnd = Ar.Tell() + PayloadSize;
+
+		UScriptStruct* Struct = StructCache->FindTypeByPath(TypePath);
+		if (!Struct || !Struct->IsChildOf(InnerStruct))
+		{
+			UE_LOG(LogOGCore, Warning, TEXT("Skipping saved data bank entry %s, the type no longer exists or doesn't belong in this bank"), *TypePath.ToString());
+			Ar.Seek(PayloadEnd);
+			continue;
+		}
+
+		const uint16 Key = StructCache->GetIndexForType(Struct);
+		if (bPlainData && SavedLayoutHash != StructCache->GetLayoutHash(Key))
+		{
+			UE_LOG(LogOGCore, Warning, TEXT("Skipping saved data bank entry %s, its layout changed since it was saved"), *TypePath.ToString());
+			Ar.Seek(PayloadEnd);
+			continue;
+		}
+
+		FOGPolymorphicStructBase& Entry = AddUnique_Internal(Key, Struct);
+		if (bPlainData)
+		{
+			SerializePlainDataMembers(Ar, Struct, &Entry);
+		}
+		else
+		{
+			Struct->SerializeItem(Ar, &Entry, nullptr);
+		}
+		//The saved replication key is meaningless now
+		MarkDirty(Entry);
+
+		if (!ensureMsgf(Ar.Tell() == PayloadEnd, TEXT("Data bank entry %s read %lld bytes, expected %lld"), *TypePath.ToString(), Ar.Tell() - (PayloadEnd - PayloadSize), PayloadSize)) [[unlikely]]
+		{
+			Ar.Seek(PayloadEnd);
+		}
+	}
+	return true;
+}
+
+bool FOGPolymorphicDataBankBase::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::NetSerialize);
+	LLM_SCOPE_BYTAG(OGCore);
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	if(!ensure(StructCache)) [[unlikely]]
+		return false;
+	if (UsesRPCBaselines())
+		return NetSerializeWithBaseline(Ar, Map, bOutSuccess);
+	FOGNetArchiveStream NetStream(Ar, Map);
+#if OG_DATABANK_NETSTATS
+	//There is no bank type available here, so the bank is identified by its InnerStruct
+	const FOGDataBankNetStats::EDirection StatsDirection = Ar.IsSaving() ? FOGDataBankNetStats::EDirection::Sent : FOGDataBankNetStats::EDirection::Received;
+	const UStruct* StatsBankType = GetInnerStruct();
+	int64 StatsStartBits = NetStream.GetPosBits();
+	FOGDataBankNetStatsCycleScope StatsCycleScope(StatsDirection);
+#endif
+	ensure(DataMap.Num() <= 255);
+	uint8 DataNum = DataMap.Num();
+	Ar << DataNum;
+#if OG_DATABANK_NETSTATS
+	FOGDataBankNetStats::Get().AddHeader(StatsDirection, StatsBankType, NetStream.GetPosBits() - StatsStartBits);
+#endif
+	
+	if (Ar.IsSaving())
+	{
+		FNetBitWriter& TraceWriter = NetStream.GetTraceWriter();
+		UE::Net::FNetTraceCollector* TraceCollector = NetStream.TraceCollector;
+		for (auto& [StructKey, SharedRef] : DataMap)
+		{
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(StructKey);
+			UE_NET_TRACE_DYNAMIC_NAME_SCOPE(Struct ? Struct->GetFName() : NAME_None, TraceWriter, TraceCollector, ENetTraceVerbosity::Trace);
+#if OG_DATABANK_NETSTATS
+			StatsStartBits = NetStream.GetPosBits();
+#endif
+			{
+				UE_NET_TRACE_SCOPE(KeyHeader, TraceWriter, TraceCollector, ENetTraceVerbosity::VeryVerbose);
+				Ar << StructKey;
+			}
+			if(!ensure(Struct)) [[unlikely]]
+				return false;
+#if OG_DATABANK_NETSTATS
+			const int64 StatsPayloadStartBits = NetStream.GetPosBits();
+#endif
+			{
+				UE_NET_TRACE_SCOPE(Payload, TraceWriter, TraceCollector, ENetTraceVerbosity::VeryVerbose);
+				OGDataBankNet::NetSerializeEntry(Ar, Map, Struct, &SharedRef.Get(), bOutSuccess);
+			}
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddEntry(StatsDirection, StatsBankType, Struct,
+				StatsPayloadStartBits - StatsStartBits, NetStream.GetPosBits() - StatsPayloadStartBits);
+#endif
+		}
+		return true;
+	}
+	else
+	{
+		//When loading, need to clear out the old values first.
+		Empty();
+		bool bHasUnmapped = false;
+		for (uint8 Idx = 0; Idx < DataNum; ++Idx)
+		{
+			uint16 StructKey;
+#if OG_DATABANK_NETSTATS
+			StatsStartBits = NetStream.GetPosBits();
+#endif
+			Ar << StructKey;
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(StructKey);
+			if(!ensure(Struct)) [[unlikely]]
+				return false;
+#if OG_DATABANK_NETSTATS
+			const int64 StatsPayloadStartBits = NetStream.GetPosBits();
+#endif
+			FOGPolymorphicStructBase* NewStructData = &AddUnique_Internal(StructKey, Struct);
+			bHasUnmapped |= OGDataBankNet::NetSerializeEntry(Ar, Map, Struct, NewStructData, bOutSuccess);
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddEntry(StatsDirection, StatsBankType, Struct,
+				StatsPayloadStartBits - StatsStartBits, NetStream.GetPosBits() - StatsPayloadStartBits);
+#endif
+		}
+		return !bHasUnmapped;
+	}
+}
+
+uint32 FOGPolymorphicDataBankBase::GetOrAllocateBaselineStreamId() const
+{
+	if (BaselineStreamId == 0 && UsesRPCBaselines())
+	{
+		BaselineStreamId = FOGDataBankRPCBaselines::Get().AllocateStreamId();
+	}
+	return BaselineStreamId;
+}
+
+bool FOGPolymorphicDataBankBase::NetSerializeWithBaseline(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::NetSerializeWithBaseline);
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	const UScriptStruct* InnerStruct = GetInnerStruct();
+	//The package map stands for the connection, there is one per connection
+	if (!ensureMsgf(Map, TEXT("RPC baselines need a package map, %s was serialized without one"), *GetNameSafe(InnerStruct))) [[unlikely]]
+	{
+		bOutSuccess = false;
+		return false;
+	}
+	FOGDataBankRPCBaselines& Baselines = FOGDataBankRPCBaselines::Get();
+	FOGNetArchiveStream NetStream(Ar, Map);
+#if OG_DATABANK_NETSTATS
+	const FOGDataBankNetStats::EDirection StatsDirection = Ar.IsSaving() ? FOGDataBankNetStats::EDirection::Sent : FOGDataBankNetStats::EDirection::Received;
+	int64 StatsStartBits = NetStream.GetPosBits();
+	FOGDataBankNetStatsCycleScope StatsCycleScope(StatsDirection);
+#endif
+
+	if (Ar.IsSaving())
+	{
+		GetOrAllocateBaselineStreamId();
+		uint16 BaselineId = 0;
+		//No acknowledged baseline, including after the receiver reset the stream, means a full send
+		const FOGDataBankRPCBaselines::FEntries* Baseline = Baselines.FindAcknowledgedBaseline(Map, BaselineStreamId, BaselineId);
+		static const FOGDataBankRPCBaselines::FEntries NoBaseline;
+		const FOGDataBankRPCBaselines::FEntries& BaselineEntries = Baseline ? *Baseline : NoBaseline;
+
+		TArray<uint16, TInlineAllocator<16>> Removed;
+		for (const auto& [Key, Entry] : BaselineEntries)
+		{
+			if (!DataMap.Contains(Key))
+			{
+				Removed.Add(Key);
+			}
+		}
+		TArray<uint16, TInlineAllocator<16>> Changed;
+		for (const auto& [Key, Entry] : DataMap)
+		{
+			const TSharedRef<FOGPolymorphicStructBase>* BaselineEntry = BaselineEntries.Find(Key);
+			if (!BaselineEntry || (&BaselineEntry->Get() != &Entry.Get()
+				&& !FOGPolymorphicStructCache::AreEntriesIdentical(StructCache->GetTypeForIndex(Key), &BaselineEntry->Get(), &Entry.Get())))
+			{
+				Changed.Add(Key);
+			}
+		}
+		ensure(Removed.Num() <= 255 && Changed.Num() <= 255);
+
+		Ar.SerializeIntPacked(BaselineStreamId);
+		uint8 bHasBaseline = Baseline != nullptr;
+		Ar.SerializeBits(&bHasBaseline, 1);
+		if (bHasBaseline)
+		{
+			Ar << BaselineId;
+		}
+		uint16 NewId = Baselines.AddSentBaseline(Map, BaselineStreamId, StructCache, DataMap);
+		Ar << NewId;
+		uint8 NumRemoved = Removed.Num();
+		uint8 NumChanged = Changed.Num();
+		Ar << NumRemoved;
+		Ar << NumChanged;
+#if OG_DATABANK_NETSTATS
+		FOGDataBankNetStats::Get().AddHeader(StatsDirection, InnerStruct, NetStream.GetPosBits() - StatsStartBits);
+#endif
+		FNetBitWriter& TraceWriter = NetStream.GetTraceWriter();
+		UE::Net::FNetTraceCollector* TraceCollector = NetStream.TraceCollector;
+		{
+			UE_NET_TRACE_SCOPE(Removals, TraceWriter, TraceCollector, ENetTraceVerbosity::Trace);
+			for (uint16 Key : Removed)
+			{
+#if OG_DATABANK_NETSTATS
+				StatsStartBits = NetStream.GetPosBits();
+#endif
+				Ar << Key;
+#if OG_DATABANK_NETSTATS
+				FOGDataBankNetStats::Get().AddRemoval(StatsDirection, InnerStruct, StructCache->GetTypeForIndex(Key), NetStream.GetPosBits() - StatsStartBits);
+#endif
+			}
+		}
+		for (uint16 Key : Changed)
+		{
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+			UE_NET_TRACE_DYNAMIC_NAME_SCOPE(Struct ? Struct->GetFName() : NAME_None, TraceWriter, TraceCollector, ENetTraceVerbosity::Trace);
+#if OG_DATABANK_NETSTATS
+			StatsStartBits = NetStream.GetPosBits();
+#endif
+			{
+				UE_NET_TRACE_SCOPE(KeyHeader, TraceWriter, TraceCollector, ENetTraceVerbosity::VeryVerbose);
+				Ar << Key;
+			}
+#if OG_DATABANK_NETSTATS
+			const int64 StatsPayloadStartBits = NetStream.GetPosBits();
+#endif
+			{
+				UE_NET_TRACE_SCOPE(Payload, TraceWriter, TraceCollector, ENetTraceVerbosity::VeryVerbose);
+				OGDataBankNet::NetSerializeEntry(Ar, Map, Struct, &DataMap.FindChecked(Key).Get(), bOutSuccess);
+			}
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddEntry(StatsDirection, InnerStruct, Struct,
+				StatsPayloadStartBits - StatsStartBits, NetStream.GetPosBits() - StatsPayloadStartBits);
+#endif
+		}
+		bOutSuccess = true;
+		return true;
+	}
+
+	uint32 StreamId = 0;
+	Ar.SerializeIntPacked(StreamId);
+	uint8 bHasBaseline = 0;
+	Ar.SerializeBits(&bHasBaseline, 1);
+	uint16 BaselineId = 0;
+	if (bHasBaseline)
+	{
+		Ar << BaselineId;
+	}
+	uint16 NewId = 0;
+	Ar << NewId;
+	uint8 NumRemoved = 0;
+	uint8 NumChanged = 0;
+	Ar << NumRemoved;
+	Ar << NumChanged;
+#if OG_DATABANK_NETSTATS
+	FOGDataBankNetStats::Get().AddHeader(StatsDirection, InnerStruct, NetStream.GetPosBits() - StatsStartBits);
+#endif
+
+	if (Ar.IsError()) [[unlikely]]
+	{
+		bOutSuccess = false;
+		return false;
+	}
+
+	Empty();
+	bool bLostBaseline = false;
+	if (bHasBaseline)
+	{
+		const FOGDataBankRPCBaselines::FEntries* Baseline = Baselines.FindReceivedBaseline(Map, StreamId, StructCache, BaselineId);
+		if (Baseline) [[likely]]
+		{
+			//Shared with the baseline, the bank copies an entry before writing to it
+			for (const auto& [Key, Entry] : *Baseline)
+			{
+				SetShared_Internal(Key, Entry, false);
+			}
+		}
+		else
+		{
+			//Still read the rest so the archive stays in step, but the read fails: the bank only gets what was sent this time.
+			//The sender goes back to a full send once it hears about the reset.
+			UE_LOG(LogOGCore, Warning, TEXT("Received a %s data bank relative to baseline %d, which is no longer held. Resetting its stream"), *GetNameSafe(InnerStruct), BaselineId);
+			Baselines.ResetReceivedStream(Map, StreamId);
+			bLostBaseline = true;
+		}
+	}
+	for (uint8 Idx = 0; Idx < NumRemoved; ++Idx)
+	{
+		uint16 Key = 0;
+#if OG_DATABANK_NETSTATS
+		StatsStartBits = NetStream.GetPosBits();
+#endif
+		Ar << Key;
+#if OG_DATABANK_NETSTATS
+		FOGDataBankNetStats::Get().AddRemoval(StatsDirection, InnerStruct, StructCache->GetTypeForIndex(Key), NetStream.GetPosBits() - StatsStartBits);
+#endif
+		Remove_Internal(Key);
+	}
+	bool bHasUnmapped = false;
+	for (uint8 Idx = 0; Idx < NumChanged; ++Idx)
+	{
+		uint16 Key = 0;
+#if OG_DATABANK_NETSTATS
+		StatsStartBits = NetStream.GetPosBits();
+#endif
+		Ar << Key;
+		UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+		if (!ensure(Struct)) [[unlikely]]
+		{
+			bOutSuccess = false;
+			return false;
+		}
+#if OG_DATABANK_NETSTATS
+		const int64 StatsPayloadStartBits = NetStream.GetPosBits();
+#endif
+		//Always a fresh allocation, the entry in the baseline must not change
+		Remove_Internal(Key);
+		bHasUnmapped |= OGDataBankNet::NetSerializeEntry(Ar, Map, Struct, &AddUnique_Internal(Key, Struct), bOutSuccess);
+#if OG_DATABANK_NETSTATS
+		FOGDataBankNetStats::Get().AddEntry(StatsDirection, InnerStruct, Struct,
+			StatsPayloadStartBits - StatsStartBits, NetStream.GetPosBits() - StatsPayloadStartBits);
+#endif
+	}
+
+	//A bank with unresolved references can't be a baseline, the sender would stop resending the entries that are missing here.
+	//Neither can one missing its baseline's entries.
+	if (!bHasUnmapped && !bLostBaseline && !Ar.IsError())
+	{
+		Baselines.AddReceivedBaseline(Map, StreamId, StructCache, NewId, DataMap);
+	}
+	if (bLostBaseline) [[unlikely]]
+	{
+		bOutSuccess = false;
+		return false;
+	}
+	return !bHasUnmapped;
+}
+
+bool FOGPolymorphicDataBankBase::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::NetDeltaSerialize);
+	LLM_SCOPE_BYTAG(OGCore);
+	if ( DeltaParams.GatherGuidReferences )
+	{
+		OGDataBankNet::GatherGuidReferences(GuidReferencesMap, DeltaParams);
+		return true;
+	}
+
+	if ( DeltaParams.MoveGuidToUnmapped )
+	{
+		return OGDataBankNet::MoveGuidToUnmapped(GuidReferencesMap, *DeltaParams.MoveGuidToUnmapped);
+	}
+
+	if ( DeltaParams.bUpdateUnmappedObjects )
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::UpdateUnmappedObjects);
+		OGDataBankNet::UpdateUnmappedObjects(GuidReferencesMap, DeltaParams,
+			[this](const uint16 StructKey) { return DataMap.Contains(StructKey); },
+			[this, &DeltaParams](const uint16 StructKey, FNetBitReader& Reader)
+			{
+				// Read the entry again, which should serialize the newly mapped objects as well
+				DeltaParams.Struct = GetStructCache()->GetTypeForIndex(StructKey);
+				DeltaParams.Data = GetMutable_Internal(StructKey);
+				DeltaParams.Reader = &Reader;
+				DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
+				NotifyChanged(StructKey);
+#if OG_DATABANK_NETSTATS
+				FOGDataBankNetStats::Get().AddGuidResolution();
+#endif
+			});
+		//TODO: PostReplicatedChange for the entries that were read again, once it is implemented for the data bank
+		return true;
+	}
+
+	//TODO: Optionally delta serialize internal structs, but only after initial replication has completed
+
+	if (DeltaParams.Writer)
+	{
+		//-----------------------------
+		// Saving
+		//-----------------------------	
+		check(DeltaParams.Struct);
+#if OG_DATABANK_NETSTATS
+		const UStruct* StatsBankType = DeltaParams.Struct;
+		FOGDataBankNetStatsCycleScope StatsCycleScope(FOGDataBankNetStats::EDirection::Sent);
+#endif
+		
+		// Get the old map if its there
+		TMap<uint16, uint16> * OldMap = nullptr;
+		TSet<uint16> OldKeys;
+		int32 BaseReplicationKey = INDEX_NONE;
+
+		// See if the array changed at all. If the ArrayReplicationKey matches we can skip checking individual items
+		if (DeltaParams.OldState)
+		{
+			OldMap = &static_cast<FOGPolymorphicDataBankDeltaState*>(DeltaParams.OldState)->IDToRepKeyMap;
+			BaseReplicationKey = static_cast<FOGPolymorphicDataBankDeltaState*>(DeltaParams.OldState)->ContainerReplicationKey;
+			
+			if (BaseReplicationKey == LastReplicationKey) //If the container is not dirty, we're done
+			{
+				*DeltaParams.NewState = DeltaParams.OldState->AsShared();
+				return false;
+			}
+			OldMap->GetKeys(OldKeys);
+		}
+
+		// Create a new map from the current state of the array		
+		FOGPolymorphicDataBankDeltaState * NewState = new FOGPolymorphicDataBankDeltaState();
+		if (const UPackageMapClient* MapClient = Cast<UPackageMapClient>(DeltaParams.Map))
+		{
+			NewState->Connection = MapClient->GetConnection();
+		}
+
+		check(DeltaParams.NewState);
+		*DeltaParams.NewState = MakeShareable( NewState );
+		TMap<uint16, uint16>& NewMap = NewState->IDToRepKeyMap;
+		NewState->ContainerReplicationKey = LastReplicationKey;
+
+		TSet<uint16> ChangedKeys, AllCurrentKeys;
+		for (auto& [Key, DataStruct] : DataMap)
+		{
+			AllCurrentKeys.Add(Key);
+			NewMap.Add(Key, DataStruct->ReplicationKey);
+			if (OldKeys.Contains(Key))
+			{
+				if (DataStruct->ReplicationKey != OldMap->FindChecked(Key))
+				{
+					ChangedKeys.Add(Key);
+				}
+			}
+			else
+			{
+				ChangedKeys.Add(Key);
+			}
+		}
+
+		TSet<uint16> RemovedKeys; 
+		RemovedKeys = OldKeys.Difference(AllCurrentKeys);
+		
+		//----------------------
+		// Write it out.
+		//----------------------
+		FBitWriter& Writer = *DeltaParams.Writer;
+		FOGNetArchiveStream NetStream(Writer, DeltaParams.Map);
+		FNetBitWriter& TraceWriter = NetStream.GetTraceWriter();
+		UE::Net::FNetTraceCollector* TraceCollector = NetStream.TraceCollector;
+		FOGPolymorphicStructCache* StructCache = GetStructCache();
+
+		{
+			UE_NET_TRACE_SCOPE(Removals, TraceWriter, TraceCollector, ENetTraceVerbosity::Trace);
+			uint8 RemovedCount = RemovedKeys.Num();
+			Writer << RemovedCount;
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddHeader(FOGDataBankNetStats::EDirection::Sent, StatsBankType, 8);
+#endif
+			for (uint16& RemovedKey : RemovedKeys)
+			{
+				Writer << RemovedKey;
+#if OG_DATABANK_NETSTATS
+				FOGDataBankNetStats::Get().AddRemoval(FOGDataBankNetStats::EDirection::Sent, StatsBankType, StructCache->GetTypeForIndex(RemovedKey), 16);
+#endif
+			}
+		}
+
+		uint8 ReplicatedCount = ChangedKeys.Num();
+		Writer << ReplicatedCount;
+#if OG_DATABANK_NETSTATS
+		FOGDataBankNetStats::Get().AddHeader(FOGDataBankNetStats::EDirection::Sent, StatsBankType, 8);
+#endif
+		for (uint16& AddOrChangedKey : ChangedKeys)
+		{
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(AddOrChangedKey);
+			ensure(Struct);
+			UE_NET_TRACE_DYNAMIC_NAME_SCOPE(Struct ? Struct->GetFName() : NAME_None, TraceWriter, TraceCollector, ENetTraceVerbosity::Trace);
+
+			{
+				UE_NET_TRACE_SCOPE(KeyHeader, TraceWriter, TraceCollector, ENetTraceVerbosity::VeryVerbose);
+				Writer << AddOrChangedKey;
+			}
+#if OG_DATABANK_NETSTATS
+			const int64 StatsPayloadStartBits = Writer.GetNumBits();
+#endif
+			
+			FOGPolymorphicStructBase* DataPtr = &DataMap.Find(AddOrChangedKey)->Get();
+			DeltaParams.Struct = Struct;
+			DeltaParams.Data = DataPtr;
+			{
+				UE_NET_TRACE_SCOPE(Payload, TraceWriter, TraceCollector, ENetTraceVerbosity::VeryVerbose);
+				DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
+			}
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddEntry(FOGDataBankNetStats::EDirection::Sent, StatsBankType, Struct, 16, Writer.GetNumBits() - StatsPayloadStartBits);
+#endif
+		}
+	}
+	else
+	{
+		//-----------------------------
+		// Loading
+		//-----------------------------	
+		check(DeltaParams.Reader);
+		FBitReader& Reader = *DeltaParams.Reader;
+#if OG_DATABANK_NETSTATS
+		const UStruct* StatsBankType = DeltaParams.Struct;
+		FOGPolymorphicStructCache* StatsStructCache = GetStructCache();
+		FOGDataBankNetStats::Get().AddHeader(FOGDataBankNetStats::EDirection::Received, StatsBankType, 16);
+		FOGDataBankNetStatsCycleScope StatsCycleScope(FOGDataBankNetStats::EDirection::Received);
+#endif
+
+		//---------------
+		// Read Removed elements
+		//---------------
+		uint8 RemovedCount;
+		Reader << RemovedCount;
+		//TODO PreReplicatedRemove callback before any removals take place
+		for (int Idx = 0; Idx < RemovedCount; ++Idx)
+		{
+			uint16 RemovedKey;
+			Reader << RemovedKey;
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddRemoval(FOGDataBankNetStats::EDirection::Received, StatsBankType, StatsStructCache->GetTypeForIndex(RemovedKey), 16);
+#endif
+			Remove_Internal(RemovedKey);
+			GuidReferencesMap.Remove(RemovedKey);
+		}
+
+		//---------------
+		// Read Changed/New elements
+		//---------------
+		FOGPolymorphicStructCache* StructCache = GetStructCache();
+		uint8 AddOrChangedCount;
+		Reader << AddOrChangedCount;
+		TSet<uint16> ChangedKeys, AddedKeys;
+		for (int Idx = 0; Idx < AddOrChangedCount; ++Idx)
+		{
+			uint16 AddedOrChangedKey;
+			Reader << AddedOrChangedKey;
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(AddedOrChangedKey);
+			ensure(Struct);
+
+			FOGPolymorphicStructBase* DataPtr;
+			if (DataMap.Contains(AddedOrChangedKey))
+			{
+				ChangedKeys.Add(AddedOrChangedKey);
+				DataPtr = Get_Internal(AddedOrChangedKey);
+			}
+			else
+			{
+				AddedKeys.Add(AddedOrChangedKey);
+				DataPtr = &AddUnique_Internal(AddedOrChangedKey, Struct);
+			}
+			
+			// Let package map know we want to track and know about any guids that are unmapped during the serialize call
+			DeltaParams.Map->ResetTrackedGuids( true );
+			// Remember where we started reading from, so that if we have unmapped properties, we can re-deserialize from this data later
+			FBitReaderMark Mark( Reader );
+
+			DeltaParams.Struct = Struct;
+			DeltaParams.Data = DataPtr;
+			DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
+#if OG_DATABANK_NETSTATS
+			FOGDataBankNetStats::Get().AddEntry(FOGDataBankNetStats::EDirection::Received, StatsBankType, Struct, 16, Reader.GetPosBits() - Mark.GetPos());
+#endif
+
+			OGDataBankNet::TrackReceivedGuids(GuidReferencesMap, AddedOrChangedKey, DeltaParams, Reader, Mark);
+
+			// Stop tracking unmapped objects
+			DeltaParams.Map->ResetTrackedGuids( false );
+		}
+		//TODO: PostReplicatedChange callback after finished updating data
+	}
+	return true;
+}
+
+FOGPolymorphicStructCache* FOGPolymorphicDataBankBase::GetStructCache() const
+{
+	return FOGCoreModule::GetUniversalStructCache();
+}
+
+bool FOGPolymorphicDataBankBase::UnsubscribeFromChanges(const FOGDataBankSubscriptionHandle& Handle)
+{
+	return ChangeListeners && ChangeListeners->Remove(Handle);
+}
+
+FOGDataBankChangeListeners& FOGPolymorphicDataBankBase::GetOrCreateChangeListeners()
+{
+	if (!ChangeListeners)
+	{
+		ChangeListeners = MakeShared<FOGDataBankChangeListeners>(GetStructCache());
+	}
+	return *ChangeListeners;
+}
+
+const UScriptStruct* FOGPolymorphicDataBankBase::GetInnerStructForBankType(const UScriptStruct* BankType)
+{
+	if (!BankType || BankType == StaticStruct() || !BankType->IsChildOf(StaticStruct()))
+		return nullptr;
+
+	//Keyed by object so a reinstanced or reloaded bank type is asked again instead of matching a stale pointer
+	static FCriticalSection CacheLock;
+	static TMap<TObjectKey<UScriptStruct>, TWeakObjectPtr<const UScriptStruct>> InnerStructCache;
+	{
+		FScopeLock Lock(&CacheLock);
+		if (const TWeakObjectPtr<const UScriptStruct>* Cached = InnerStructCache.Find(BankType))
+		{
+			if (const UScriptStruct* CachedInner = Cached->Get())
+				return CachedInner;
+		}
+	}
+
+	const UScriptStruct::ICppStructOps* StructOps = BankType->GetCppStructOps();
+	if (!ensure(StructOps)) [[unlikely]]
+		return nullptr;
+
+	//GetInnerStruct is virtual, so a temporary instance is the only reliable way to ask
+	void* TempBank = FMemory::Malloc(StructOps->GetSize(), StructOps->GetAlignment());
+	BankType->InitializeStruct(TempBank);
+	const UScriptStruct* InnerStruct = static_cast<const FOGPolymorphicDataBankBase*>(TempBank)->GetInnerStruct();
+	BankType->DestroyStruct(TempBank);
+	FMemory::Free(TempBank);
+
+	FScopeLock Lock(&CacheLock);
+	InnerStructCache.Add(BankType, InnerStruct);
+	return InnerStruct;
+}
+
+FOGPolymorphicStructBase* FOGPolymorphicDataBankBase::Get_Internal(const uint16& Key)
+{
+	FOGPolymorphicStructBase* Existing = GetMutable_Internal(Key);
+	if (!Existing)
+		return nullptr;
+	MarkDirty(*Existing);
+	NotifyChanged(Key);
+	return Existing;
+}
+
+FOGPolymorphicStructBase* FOGPolymorphicDataBankBase::GetMutable_Internal(const uint16& Key)
+{
+	TSharedRef<FOGPolymorphicStructBase>* Existing = DataMap.Find(Key);
+	if (!Existing)
+		return nullptr;
+	//Anyone asking for a mutable entry may write to it
+	InvalidateEntryHash(Key);
+	if (!Existing->IsUnique())
+	{
+		//A snapshot still references this entry, give the bank its own copy to write to
+		TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicDataBankBase::CopyOnWrite);
+		TSharedRef<FOGPolymorphicStructBase> Copy = AllocateEntry(GetStructCache()->GetTypeForIndex(Key));
+		CopyEntry_Internal(Key, Copy.Get(), Existing->Get());
+		*Existing = Copy;
+	}
+	return &Existing->Get();
+}
+
+const FOGPolymorphicStructBase* FOGPolymorphicDataBankBase::GetConst_Internal(const uint16& Key) const
+{
+	const TSharedRef<FOGPolymorphicStructBase>* Existing = DataMap.Find(Key);
+	if (!Existing)
+		return nullptr;
+	const FOGPolymorphicStructBase& ExistingTyped = Existing->Get();
+	return &ExistingTyped;
+}
+
+FOGPolymorphicStructBase& FOGPolymorphicDataBankBase::AddUnique_Internal(const uint16& Key,
+	const UScriptStruct* ScriptStruct)
+{
+	if (!ensureAlwaysMsgf(!DataMap.Contains(Key), TEXT("Tried adding a unique type, but type already exsists"))) [[unlikely]]
+		return *Get_Internal(Key);
+	const TSharedRef<FOGPolymorphicStructBase> NewEntry = AllocateEntry(ScriptStruct);
+	FOGPolymorphicStructBase* NewStructPtr = &NewEntry.Get();
+	MarkDirty(*NewStructPtr);
+	DataMap.Add(Key, NewEntry);
+	INC_DWORD_STAT(STAT_OGCore_LiveEntries);
+	NotifyChanged(Key);
+
+#if WITH_EDITOR
+	AvailableDataTypes.Add(ScriptStruct->GetStructCPPName());
+#endif
+	
+	return *NewStructPtr;
+}
+
+void FOGPolymorphicDataBankBase::SetShared_Internal(const uint16& Key, const TSharedRef<FOGPolymorphicStructBase>& Entry, const bool bMarkEntryDirty)
+{
+	if (TSharedRef<FOGPolymorphicStructBase>* Existing = DataMap.Find(Key))
+	{
+		*Existing = Entry;
+		InvalidateEntryHash(Key);
+	}
+	else
+	{
+		DataMap.Add(Key, Entry);
+		INC_DWORD_STAT(STAT_OGCore_LiveEntries);
+#if WITH_EDITOR
+		AvailableDataTypes.Add(GetStructCache()->GetTypeForIndex(Key)->GetStructCPPName());
+#endif
+	}
+	if (bMarkEntryDirty)
+	{
+		MarkDirty(Entry.Get());
+	}
+	else
+	{
+		++LastReplicationKey;
+		++Version;
+	}
+	NotifyChanged(Key);
+}
+
+void FOGPolymorphicDataBankBase::CopyEntry_Internal(const uint16& Key, FOGPolymorphicStructBase& Dest, const FOGPolymorphicStructBase& Source) const
+{
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	const UScriptStruct* Struct = StructCache->GetTypeForIndex(Key);
+	if (StructCache->IsPlainData(Key))
+	{
+		FMemory::Memcpy(&Dest, &Source, Struct->GetStructureSize());
+	}
+	else
+	{
+		Struct->CopyScriptStruct(&Dest, &Source);
+	}
+}
+
+void FOGPolymorphicDataBankBase::Remove_Internal(const uint16& Key, const UScriptStruct* ScriptStruct)
+{
+	if (DataMap.Remove(Key) > 0)
+	{
+		InvalidateEntryHash(Key);
+		++Version;
+		DEC_DWORD_STAT(STAT_OGCore_LiveEntries);
+		NotifyChanged(Key, false);
+	}
+#if WITH_EDITOR
+	FString NameToRemove;
+	if (ScriptStruct)
+	{
+		NameToRemove = ScriptStruct->GetStructCPPName();
+	}
+	else
+	{
+		NameToRemove = GetStructCache()->GetTypeForIndex(Key)->GetStructCPPName();
+	}
+	AvailableDataTypes.Remove(NameToRemove);
+#endif
+}
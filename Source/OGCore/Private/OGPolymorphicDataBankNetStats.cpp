@@ -0,0 +1,150 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGPolymorphicDataBankNetStats.h"
+
+#if OG_DATABANK_NETSTATS
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Class.h"
+
+static FAutoConsoleCommandWithOutputDevice DumpDataBankNetStatsCommand(
+	TEXT("OGCore.DataBank.NetStats"),
+	TEXT("Dump cumulative data bank replication traffic per entry type and per bank type since the last reset"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		FOGDataBankNetStats::Get().Dump(Ar);
+	}));
+
+static FAutoConsoleCommand ResetDataBankNetStatsCommand(
+	TEXT("OGCore.DataBank.NetStatsReset"),
+	TEXT("Reset the data bank replication traffic counters"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FOGDataBankNetStats::Get().Reset();
+	}));
+
+static FName GetStatsName(const UStruct* Type)
+{
+	return Type ? Type->GetFName() : NAME_None;
+}
+
+FOGDataBankNetStats& FOGDataBankNetStats::Get()
+{
+	static FOGDataBankNetStats Instance;
+	return Instance;
+}
+
+void FOGDataBankNetStats::AddHeader(const EDirection Direction, const UStruct* BankType, const uint64 Bits)
+{
+	FScopeLock ScopeLock(&Lock);
+	PerBankType[static_cast<uint8>(Direction)].FindOrAdd(GetStatsName(BankType)).KeyHeaderBits += Bits;
+}
+
+void FOGDataBankNetStats::AddRemoval(const EDirection Direction, const UStruct* BankType, const UStruct* EntryType, const uint64 Bits)
+{
+	FScopeLock ScopeLock(&Lock);
+	for (FCounters* Counters : {&PerBankType[static_cast<uint8>(Direction)].FindOrAdd(GetStatsName(BankType)),
+		&PerEntryType[static_cast<uint8>(Direction)].FindOrAdd(GetStatsName(EntryType))})
+	{
+		Counters->RemovalBits += Bits;
+		++Counters->NumRemovals;
+	}
+}
+
+void FOGDataBankNetStats::AddEntry(const EDirection Direction, const UStruct* BankType, const UStruct* EntryType, const uint64 KeyHeaderBits, const uint64 PayloadBits)
+{
+	FScopeLock ScopeLock(&Lock);
+	for (FCounters* Counters : {&PerBankType[static_cast<uint8>(Direction)].FindOrAdd(GetStatsName(BankType)),
+		&PerEntryType[static_cast<uint8>(Direction)].FindOrAdd(GetStatsName(EntryType))})
+	{
+		Counters->KeyHeaderBits += KeyHeaderBits;
+		Counters->PayloadBits += PayloadBits;
+		++Counters->NumEntries;
+	}
+}
+
+void FOGDataBankNetStats::AddSerializeCycles(const EDirection Direction, const uint64 Cycles)
+{
+	FScopeLock ScopeLock(&Lock);
+	SerializeCycles[static_cast<uint8>(Direction)] += Cycles;
+}
+
+void FOGDataBankNetStats::AddGuidResolution()
+{
+	FScopeLock ScopeLock(&Lock);
+	++NumGuidResolutions;
+}
+
+FOGDataBankNetStats::FCounters FOGDataBankNetStats::GetTotals(const EDirection Direction) const
+{
+	FScopeLock ScopeLock(&Lock);
+	FCounters Totals;
+	for (const auto& [Name, Counters] : PerBankType[static_cast<uint8>(Direction)])
+	{
+		Totals.RemovalBits += Counters.RemovalBits;
+		Totals.KeyHeaderBits += Counters.KeyHeaderBits;
+		Totals.PayloadBits += Counters.PayloadBits;
+		Totals.NumEntries += Counters.NumEntries;
+		Totals.NumRemovals += Counters.NumRemovals;
+	}
+	return Totals;
+}
+
+double FOGDataBankNetStats::GetSerializeSeconds(const EDirection Direction) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return FPlatformTime::ToSeconds64(SerializeCycles[static_cast<uint8>(Direction)]);
+}
+
+uint32 FOGDataBankNetStats::GetNumGuidResolutions() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumGuidResolutions;
+}
+
+void FOGDataBankNetStats::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	for (uint8 Direction = 0; Direction < static_cast<uint8>(EDirection::Num); ++Direction)
+	{
+		PerEntryType[Direction].Empty();
+		PerBankType[Direction].Empty();
+		SerializeCycles[Direction] = 0;
+	}
+	NumGuidResolutions = 0;
+	LastResetTime = FPlatformTime::Seconds();
+}
+
+void FOGDataBankNetStats::Dump(FOutputDevice& Ar) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const auto DumpTable = [&Ar](const TCHAR* Title, const TMap<FName, FCounters>& Table)
+	{
+		TArray<TPair<FName, FCounters>> Sorted = Table.Array();
+		Sorted.Sort([](const TPair<FName, FCounters>& A, const TPair<FName, FCounters>& B) { return A.Value.GetTotalBits() > B.Value.GetTotalBits(); });
+
+		Ar.Logf(TEXT("  %s"), Title);
+		Ar.Logf(TEXT("    %-48s %12s %12s %12s %12s %8s %8s"), TEXT("Type"), TEXT("TotalBytes"), TEXT("Payload"), TEXT("KeyHeaders"), TEXT("Removals"), TEXT("Entries"), TEXT("Removed"));
+		for (const TPair<FName, FCounters>& Row : Sorted)
+		{
+			Ar.Logf(TEXT("    %-48s %12llu %12llu %12llu %12llu %8u %8u"), *Row.Key.ToString(),
+				(Row.Value.GetTotalBits() + 7) / 8, (Row.Value.PayloadBits + 7) / 8, (Row.Value.KeyHeaderBits + 7) / 8,
+				(Row.Value.RemovalBits + 7) / 8, Row.Value.NumEntries, Row.Value.NumRemovals);
+		}
+	};
+
+	Ar.Logf(TEXT("Data bank replication traffic over the last %.1f seconds"), FPlatformTime::Seconds() - LastResetTime);
+	for (const EDirection Direction : {EDirection::Sent, EDirection::Received})
+	{
+		const uint8 DirectionIndex = static_cast<uint8>(Direction);
+		Ar.Logf(TEXT("%s (%.3f ms serializing):"), Direction == EDirection::Sent ? TEXT("Sent") : TEXT("Received"),
+			FPlatformTime::ToMilliseconds64(SerializeCycles[DirectionIndex]));
+		DumpTable(TEXT("Per bank type"), PerBankType[DirectionIndex]);
+		DumpTable(TEXT("Per entry type"), PerEntryType[DirectionIndex]);
+	}
+	Ar.Logf(TEXT("Entries re-read after object references resolved: %u"), NumGuidResolutions);
+}
+
+#endif
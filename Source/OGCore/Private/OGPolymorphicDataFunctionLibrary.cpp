@@ -1,236 +1,526 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-
-#include "OGPolymorphicDataFunctionLibrary.h"
-#include "Blueprint/BlueprintExceptionInfo.h"
-#include "Iris/ReplicationState/ReplicationStateUtil.h"
-
-#define LOCTEXT_NAMESPACE "FOGCoreModule"
-
-static FTextFormat DataBankTypeError = LOCTEXT("DataBankTypeError", "DataBank of type {0} may only hold types derived from {1}");
-
-void UOGPolymorphicDataFunctionLibrary::AddUniqueGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData)
-{
-	const uint16 Key = DataBank.GetKey(StructType);
-	FOGPolymorphicStructBase& DataRef = DataBank.AddUnique_Internal(Key, StructType);
-	void* RawDataPtr = &DataRef;
-	Prop->CopyCompleteValueFromScriptVM(RawDataPtr, InData);
-	DataBank.MarkDirty(DataRef);
-}
-
-DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execAddUnique)
-{
-	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
-	
-	Stack.MostRecentProperty = nullptr;
-	Stack.MostRecentPropertyAddress = nullptr;
-	Stack.StepCompiledIn<FProperty>(nullptr);
-	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
-	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
-	
-	P_FINISH;
-	//TODO: Could make this error happen at compile time if this function were implemented as a custom node
-	if (!StructProperty)
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::FromString(TEXT("DataBank AddUnique requires a struct derived from Inner type of Data Bank"))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-
-	const UScriptStruct* ScriptStruct = StructProperty->Struct;
-	if (!ScriptStruct || !ScriptStruct->IsChildOf(DataBank.GetInnerStruct()))
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
-				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-	
-	// Get the memory address of the struct
-	const void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
-	
-	P_NATIVE_BEGIN;
-	AddUniqueGeneric(DataBank, ScriptStruct, StructProperty, PropertyData);
-	P_NATIVE_END;
-}
-
-void UOGPolymorphicDataFunctionLibrary::SetGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData)
-{
-	const uint16 Key = DataBank.GetKey(StructType);
-	FOGPolymorphicStructBase* RawDataPtr = DataBank.Get_Internal(Key);
-	if (!RawDataPtr)
-	{
-		RawDataPtr = &DataBank.AddUnique_Internal(Key, StructType);
-	}
-	Prop->CopyCompleteValueFromScriptVM(RawDataPtr, InData);
-	DataBank.MarkDirty(*RawDataPtr);
-}
-
-DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execSet)
-{
-	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
-	
-	Stack.MostRecentProperty = nullptr;
-	Stack.MostRecentPropertyAddress = nullptr;
-	Stack.StepCompiledIn<FProperty>(nullptr);
-	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
-	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
-	
-	P_FINISH;
-	//TODO: Could make this error happen at compile time if this function were implemented as a custom node
-	if (!StructProperty)
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::FromString(TEXT("DataBank AddUnique requires a struct derived from Inner type of Data Bank"))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-
-	const UScriptStruct* ScriptStruct = StructProperty->Struct;
-	if (!ScriptStruct || !ScriptStruct->IsChildOf(DataBank.GetInnerStruct()))
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
-				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-	
-	// Get the memory address of the struct
-	const void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
-	
-	P_NATIVE_BEGIN;
-	SetGeneric(DataBank, ScriptStruct, StructProperty, PropertyData);
-	P_NATIVE_END;
-}
-
-void UOGPolymorphicDataFunctionLibrary::GetGeneric(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, void* OutData)
-{
-	const uint16 Key = DataBank.GetKey(StructType);
-	const void* Existing = DataBank.GetConst_Internal(Key);
-	if (!ensureAlwaysMsgf(Existing, TEXT("Tried getting a value from the data bank that is not present")))
-	{
-		return;
-	}
-	Prop->CopyCompleteValueToScriptVM(OutData, Existing);
-}
-
-DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execGet)
-{
-	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
-	
-	Stack.MostRecentProperty = nullptr;
-	Stack.MostRecentPropertyAddress = nullptr;
-	Stack.StepCompiledIn<FProperty>(nullptr);
-	
-	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
-	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
-
-	P_FINISH;
-
-	//TODO: Could make this error happen at compile time if this function were implemented as a custom node
-	if (!StructProperty)
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::FromString(TEXT("DataBank Get's wildcard pin must connect to a struct derived from FOGPolymorphicStructBase"))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-
-	const UScriptStruct* ScriptStruct = StructProperty->Struct;
-	if (!ScriptStruct || !ScriptStruct->IsChildOf(FOGPolymorphicStructBase::StaticStruct()))
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
-				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-
-	// Get the memory address of the struct
-	void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
-	
-	P_NATIVE_BEGIN;
-	GetGeneric(DataBank, ScriptStruct, StructProperty, PropertyData);
-	P_NATIVE_END;
-}
-
-void UOGPolymorphicDataFunctionLibrary::FindGeneric(const FOGPolymorphicDataBankBase& DataBank, bool& OutFound, const UScriptStruct* StructType, const FStructProperty* Prop,
-	void* OutData)
-{
-	const uint16 Key = DataBank.GetKey(StructType);
-	const void* Existing = DataBank.GetConst_Internal(Key);
-	if (!Existing)
-	{
-		OutFound = false;
-		return;
-	}
-	OutFound = true;
-	Prop->CopyCompleteValueToScriptVM(OutData, Existing);
-}
-
-DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execFind)
-{
-	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
-	P_GET_UBOOL_REF(bOutFound);
-	
-	Stack.MostRecentProperty = nullptr;
-	Stack.MostRecentPropertyAddress = nullptr;
-	Stack.StepCompiledIn<FProperty>(nullptr);
-	
-	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
-	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
-
-	P_FINISH;
-
-	//TODO: Could make this error happen at compile time if this function were implemented as a custom node
-	if (!StructProperty)
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::FromString(TEXT("DataBank Get's wildcard pin must connect to a struct derived from FOGPolymorphicStructBase"))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-
-	const UScriptStruct* ScriptStruct = StructProperty->Struct;
-	if (!ScriptStruct || !ScriptStruct->IsChildOf(FOGPolymorphicStructBase::StaticStruct()))
-	{
-		const FBlueprintExceptionInfo ExceptionInfo(
-			EBlueprintExceptionType::FatalError,
-			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
-				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
-		);
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
-		return;
-	}
-
-	// Get the memory address of the struct
-	void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
-	
-	P_NATIVE_BEGIN;
-	FindGeneric(DataBank, bOutFound, ScriptStruct, StructProperty, PropertyData);
-	P_NATIVE_END;
-}
-
-void UOGPolymorphicDataFunctionLibrary::Empty(FOGPolymorphicDataBankBase& DataBank)
-{
-	DataBank.Empty();
-}
-
-#undef LOCTEXT_NAMESPACE
+/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGPolymorphicDataFunctionLibrary.h"
+#include "Blueprint/BlueprintExceptionInfo.h"
+#include "Iris/ReplicationState/ReplicationStateUtil.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/FieldPath.h"
+#include "UObject/ObjectKey.h"
+
+#define LOCTEXT_NAMESPACE "FOGCoreModule"
+
+static FTextFormat DataBankTypeError = LOCTEXT("DataBankTypeError", "DataBank of type {0} may only hold types derived from {1}");
+static FTextFormat DataBankFieldError = LOCTEXT("DataBankFieldError", "DataBank entry type {1} has no field named {0}");
+static FTextFormat DataBankFieldTypeError = LOCTEXT("DataBankFieldTypeError", "DataBank field {0} must be connected to a value of type {1}");
+
+void UOGPolymorphicDataFunctionLibrary::AddUniqueGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData)
+{
+	AddUniqueByKey(DataBank, DataBank.GetKey(StructType), StructType, Prop, InData);
+}
+
+void UOGPolymorphicDataFunctionLibrary::AddUniqueByKey(FOGPolymorphicDataBankBase& DataBank, const uint16 Key, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData)
+{
+	FOGPolymorphicStructBase& DataRef = DataBank.AddUnique_Internal(Key, StructType);
+	void* RawDataPtr = &DataRef;
+	Prop->CopyCompleteValueFromScriptVM(RawDataPtr, InData);
+	DataBank.MarkDirty(DataRef);
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execAddUnique)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+	
+	P_FINISH;
+	//UK2Node_OGDataBankAccess catches these errors at compile time, this path remains for direct calls to the library function
+	if (!StructProperty)
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::FromString(TEXT("DataBank AddUnique requires a struct derived from Inner type of Data Bank"))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+
+	const UScriptStruct* ScriptStruct = StructProperty->Struct;
+	if (!ScriptStruct || !ScriptStruct->IsChildOf(DataBank.GetInnerStruct()))
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
+				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+	
+	// Get the memory address of the struct
+	const void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+	
+	P_NATIVE_BEGIN;
+	AddUniqueGeneric(DataBank, ScriptStruct, StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+void UOGPolymorphicDataFunctionLibrary::SetGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData)
+{
+	SetByKey(DataBank, DataBank.GetKey(StructType), StructType, Prop, InData);
+}
+
+void UOGPolymorphicDataFunctionLibrary::SetByKey(FOGPolymorphicDataBankBase& DataBank, const uint16 Key, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData)
+{
+	if (DataBank.IsRedundantWrite(Key, StructType, InData))
+		return;
+	FOGPolymorphicStructBase* RawDataPtr = DataBank.Get_Internal(Key);
+	if (!RawDataPtr)
+	{
+		RawDataPtr = &DataBank.AddUnique_Internal(Key, StructType);
+	}
+	Prop->CopyCompleteValueFromScriptVM(RawDataPtr, InData);
+	DataBank.MarkDirty(*RawDataPtr);
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execSet)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+	
+	P_FINISH;
+	//UK2Node_OGDataBankAccess catches these errors at compile time, this path remains for direct calls to the library function
+	if (!StructProperty)
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::FromString(TEXT("DataBank AddUnique requires a struct derived from Inner type of Data Bank"))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+
+	const UScriptStruct* ScriptStruct = StructProperty->Struct;
+	if (!ScriptStruct || !ScriptStruct->IsChildOf(DataBank.GetInnerStruct()))
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
+				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+	
+	// Get the memory address of the struct
+	const void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+	
+	P_NATIVE_BEGIN;
+	SetGeneric(DataBank, ScriptStruct, StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+void UOGPolymorphicDataFunctionLibrary::GetGeneric(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, void* OutData)
+{
+	const uint16 Key = DataBank.GetKey(StructType);
+	const void* Existing = DataBank.GetConst_Internal(Key);
+	if (!ensureAlwaysMsgf(Existing, TEXT("Tried getting a value from the data bank that is not present")))
+	{
+		return;
+	}
+	Prop->CopyCompleteValueToScriptVM(OutData, Existing);
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execGet)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	//UK2Node_OGDataBankAccess catches these errors at compile time, this path remains for direct calls to the library function
+	if (!StructProperty)
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::FromString(TEXT("DataBank Get's wildcard pin must connect to a struct derived from FOGPolymorphicStructBase"))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+
+	const UScriptStruct* ScriptStruct = StructProperty->Struct;
+	if (!ScriptStruct || !ScriptStruct->IsChildOf(FOGPolymorphicStructBase::StaticStruct()))
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
+				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+
+	// Get the memory address of the struct
+	void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+	
+	P_NATIVE_BEGIN;
+	GetGeneric(DataBank, ScriptStruct, StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+void UOGPolymorphicDataFunctionLibrary::FindGeneric(const FOGPolymorphicDataBankBase& DataBank, bool& OutFound, const UScriptStruct* StructType, const FStructProperty* Prop,
+	void* OutData)
+{
+	OutFound = FindByKey(DataBank, DataBank.GetKey(StructType), Prop, OutData);
+}
+
+bool UOGPolymorphicDataFunctionLibrary::FindByKey(const FOGPolymorphicDataBankBase& DataBank, const uint16 Key, const FStructProperty* Prop, void* OutData)
+{
+	const void* Existing = DataBank.GetConst_Internal(Key);
+	if (!Existing)
+	{
+		return false;
+	}
+	Prop->CopyCompleteValueToScriptVM(OutData, Existing);
+	return true;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execFind)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_UBOOL_REF(bOutFound);
+	
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	//UK2Node_OGDataBankAccess catches these errors at compile time, this path remains for direct calls to the library function
+	if (!StructProperty)
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::FromString(TEXT("DataBank Get's wildcard pin must connect to a struct derived from FOGPolymorphicStructBase"))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+
+	const UScriptStruct* ScriptStruct = StructProperty->Struct;
+	if (!ScriptStruct || !ScriptStruct->IsChildOf(FOGPolymorphicStructBase::StaticStruct()))
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
+				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		return;
+	}
+
+	// Get the memory address of the struct
+	void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+	
+	P_NATIVE_BEGIN;
+	FindGeneric(DataBank, bOutFound, ScriptStruct, StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execAddUniqueResolved)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_OBJECT(UScriptStruct, EntryType);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FStructProperty* StructProperty = CastFieldChecked<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	const void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+
+	P_NATIVE_BEGIN;
+	AddUniqueByKey(DataBank, DataBank.GetKeyUnchecked(EntryType), EntryType, StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execSetResolved)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_OBJECT(UScriptStruct, EntryType);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FStructProperty* StructProperty = CastFieldChecked<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	const void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+
+	P_NATIVE_BEGIN;
+	SetByKey(DataBank, DataBank.GetKeyUnchecked(EntryType), EntryType, StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execGetResolved)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_OBJECT(UScriptStruct, EntryType);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FStructProperty* StructProperty = CastFieldChecked<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+
+	P_NATIVE_BEGIN;
+	const bool bFound = FindByKey(DataBank, DataBank.GetKeyUnchecked(EntryType), StructProperty, PropertyData);
+	ensureAlwaysMsgf(bFound, TEXT("Tried getting a value from the data bank that is not present"));
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execFindResolved)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_OBJECT(UScriptStruct, EntryType);
+	P_GET_UBOOL_REF(bOutFound);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	const FStructProperty* StructProperty = CastFieldChecked<FStructProperty>(Stack.MostRecentProperty);
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	void* PropertyData = StructProperty->ContainerPtrToValuePtr<FOGPolymorphicStructBase>(PropertyContainerAddress);
+
+	P_NATIVE_BEGIN;
+	bOutFound = FindByKey(DataBank, DataBank.GetKeyUnchecked(EntryType), StructProperty, PropertyData);
+	P_NATIVE_END;
+}
+
+//Field nodes run every frame, so the by-name lookup is only done once per entry type and field
+static const FProperty* FindEntryField(const UScriptStruct* EntryType, const FName FieldName)
+{
+	static FCriticalSection CacheLock;
+	static TMap<TPair<TObjectKey<UScriptStruct>, FName>, TFieldPath<FProperty>> FieldCache;
+	const TPair<TObjectKey<UScriptStruct>, FName> CacheKey(EntryType, FieldName);
+	{
+		FScopeLock Lock(&CacheLock);
+		if (const TFieldPath<FProperty>* Cached = FieldCache.Find(CacheKey))
+		{
+			//The field path notices a relinked or reinstanced struct and resolves again
+			if (const FProperty* CachedField = Cached->Get(const_cast<UScriptStruct*>(EntryType)))
+			{
+				return CachedField;
+			}
+		}
+	}
+
+	FProperty* Field = FindFProperty<FProperty>(EntryType, FieldName);
+	if (Field)
+	{
+		FScopeLock Lock(&CacheLock);
+		FieldCache.Add(CacheKey, TFieldPath<FProperty>(Field));
+	}
+	return Field;
+}
+
+//Script VM values of bools are whole bools, a bitfield bool member only matches when compared through its property
+static bool IsSameAsScriptVMValue(const FProperty* Field, const void* FieldData, const void* InData)
+{
+	if (const FBoolProperty* BoolField = CastField<FBoolProperty>(Field))
+	{
+		return BoolField->GetPropertyValue(FieldData) == *static_cast<const bool*>(InData);
+	}
+	return Field->Identical(FieldData, InData);
+}
+
+const FProperty* UOGPolymorphicDataFunctionLibrary::ResolveField(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType,
+	const FName FieldName, const FProperty* ValueProperty, UObject* Context, FFrame& Stack)
+{
+	if (!EntryType || !EntryType->IsChildOf(DataBank.GetInnerStruct()))
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankTypeError, FText::FromString(DataBank.StaticStruct()->GetStructCPPName()),
+				FText::FromString(DataBank.GetInnerStruct()->GetStructCPPName()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+		return nullptr;
+	}
+
+	const FProperty* Field = FindEntryField(EntryType, FieldName);
+	if (!Field)
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankFieldError, FText::FromName(FieldName), FText::FromString(EntryType->GetStructCPPName()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+		return nullptr;
+	}
+
+	if (!ValueProperty || !Field->SameType(ValueProperty))
+	{
+		const FBlueprintExceptionInfo ExceptionInfo(
+			EBlueprintExceptionType::FatalError,
+			FText::Format(DataBankFieldTypeError, FText::FromName(FieldName), FText::FromString(Field->GetCPPType()))
+		);
+		FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+		return nullptr;
+	}
+	return Field;
+}
+
+bool UOGPolymorphicDataFunctionLibrary::GetFieldGeneric(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const FProperty* Field, void* OutData)
+{
+	const uint16 Key = DataBank.GetKey(EntryType);
+	const FOGPolymorphicStructBase* Existing = DataBank.GetConst_Internal(Key);
+	if (!Existing)
+	{
+		return false;
+	}
+	Field->CopyCompleteValueToScriptVM(OutData, Field->ContainerPtrToValuePtr<void>(Existing));
+	return true;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execGetField)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_OBJECT(UScriptStruct, EntryType);
+	P_GET_PROPERTY(FNameProperty, FieldName);
+	P_GET_UBOOL_REF(bOutFound);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+
+	const FProperty* ValueProperty = Stack.MostRecentProperty;
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	bOutFound = false;
+	const FProperty* Field = ResolveField(DataBank, EntryType, FieldName, ValueProperty, P_THIS, Stack);
+	if (!Field)
+		return;
+
+	void* PropertyData = ValueProperty->ContainerPtrToValuePtr<void>(PropertyContainerAddress);
+
+	P_NATIVE_BEGIN;
+	bOutFound = GetFieldGeneric(DataBank, EntryType, Field, PropertyData);
+	P_NATIVE_END;
+}
+
+bool UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const FProperty* Field, const void* InData)
+{
+	const uint16 Key = DataBank.GetKey(EntryType);
+	FOGPolymorphicStructBase* RawDataPtr = DataBank.GetMutable_Internal(Key);
+	if (!RawDataPtr)
+	{
+		//A new entry is always a change, AddUnique_Internal has already marked it dirty
+		RawDataPtr = &DataBank.AddUnique_Internal(Key, EntryType);
+		Field->CopyCompleteValueFromScriptVM(Field->ContainerPtrToValuePtr<void>(RawDataPtr), InData);
+		return true;
+	}
+
+	void* FieldData = Field->ContainerPtrToValuePtr<void>(RawDataPtr);
+	if (IsSameAsScriptVMValue(Field, FieldData, InData))
+	{
+		return false;
+	}
+	Field->CopyCompleteValueFromScriptVM(FieldData, InData);
+	DataBank.MarkDirty(*RawDataPtr);
+	DataBank.NotifyChanged(Key);
+	return true;
+}
+
+DEFINE_FUNCTION(UOGPolymorphicDataFunctionLibrary::execSetField)
+{
+	P_GET_STRUCT_REF(FOGPolymorphicDataBankBase, DataBank);
+	P_GET_OBJECT(UScriptStruct, EntryType);
+	P_GET_PROPERTY(FNameProperty, FieldName);
+	P_GET_UBOOL_REF(bOutChanged);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+
+	const FProperty* ValueProperty = Stack.MostRecentProperty;
+	void* PropertyContainerAddress = Stack.MostRecentPropertyContainer;
+
+	P_FINISH;
+
+	bOutChanged = false;
+	const FProperty* Field = ResolveField(DataBank, EntryType, FieldName, ValueProperty, P_THIS, Stack);
+	if (!Field)
+		return;
+
+	const void* PropertyData = ValueProperty->ContainerPtrToValuePtr<void>(PropertyContainerAddress);
+
+	P_NATIVE_BEGIN;
+	bOutChanged = SetFieldGeneric(DataBank, EntryType, Field, PropertyData);
+	P_NATIVE_END;
+}
+
+void UOGPolymorphicDataFunctionLibrary::Empty(FOGPolymorphicDataBankBase& DataBank)
+{
+	DataBank.Empty();
+}
+
+TArray<UScriptStruct*> UOGPolymorphicDataFunctionLibrary::GetEntryTypesDerivedFrom(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* BaseType)
+{
+	TArray<UScriptStruct*> EntryTypes;
+	if (!BaseType || !BaseType->IsChildOf(DataBank.GetInnerStruct()))
+		return EntryTypes;
+	const FOGPolymorphicStructCache* StructCache = DataBank.GetStructCache();
+	DataBank.ForEachKeyDerivedFrom(BaseType, [&EntryTypes, StructCache](const uint16 Key)
+	{
+		EntryTypes.Add(StructCache->GetTypeForIndex(Key));
+	});
+	return EntryTypes;
+}
+
+FOGDataBankSubscriptionHandle UOGPolymorphicDataFunctionLibrary::SubscribeToChanges(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, FOGOnDataBankChangedDynamic OnChanged)
+{
+	if (!EntryType || !EntryType->IsChildOf(DataBank.GetInnerStruct()))
+		return FOGDataBankSubscriptionHandle();
+	return DataBank.GetOrCreateChangeListeners().Add(DataBank.GetKeyUnchecked(EntryType), OnChanged);
+}
+
+bool UOGPolymorphicDataFunctionLibrary::UnsubscribeFromChanges(FOGPolymorphicDataBankBase& DataBank, const FOGDataBankSubscriptionHandle& Subscription)
+{
+	return DataBank.UnsubscribeFromChanges(Subscription);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,385 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGPolymorphicMultiBank.h"
+
+#include "OGCoreModule.h"
+#include "OGDataBankNetSerialization.h"
+#include "Engine/PackageMapClient.h"
+#include "UObject/UnrealType.h"
+
+FOGPolymorphicMultiBankBase::FOGPolymorphicMultiBankBase(const FOGPolymorphicMultiBankBase& Other)
+{
+	CopyFrom(Other);
+}
+
+FOGPolymorphicMultiBankBase& FOGPolymorphicMultiBankBase::operator=(const FOGPolymorphicMultiBankBase& Other)
+{
+	if (this != &Other)
+	{
+		Empty();
+		CopyFrom(Other);
+	}
+	return *this;
+}
+
+SIZE_T FOGPolymorphicMultiBankBase::GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType, TSet<const void*>* InOutCountedEntries) const
+{
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	SIZE_T Size = Elements.GetAllocatedSize();
+	for (const auto& [Id, Element] : Elements)
+	{
+		bool bAlreadyCounted = false;
+		if (InOutCountedEntries)
+		{
+			InOutCountedEntries->Add(&Element.Data.Get(), &bAlreadyCounted);
+		}
+		if (bAlreadyCounted)
+			continue;
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Element.TypeKey);
+		const SIZE_T ElementSize = Struct->GetStructureSize() + FOGPolymorphicDataBankBase::EntryReferenceControllerSize + FOGPolymorphicStructCache::GetEntryHeapSize(Struct, &Element.Data.Get());
+		Size += ElementSize;
+		if (OutBytesPerEntryType)
+		{
+			OutBytesPerEntryType->FindOrAdd(Struct) += ElementSize;
+		}
+	}
+	Size += TypeIndex.GetAllocatedSize();
+	for (const auto& [TypeKey, Handles] : TypeIndex)
+	{
+		Size += Handles.GetAllocatedSize();
+	}
+	Size += GuidReferencesMap.GetAllocatedSize();
+	for (const auto& [Id, GuidReferences] : GuidReferencesMap)
+	{
+		Size += GuidReferences.UnmappedGUIDs.GetAllocatedSize() + GuidReferences.MappedDynamicGUIDs.GetAllocatedSize() + GuidReferences.Buffer.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FOGPolymorphicMultiBankBase::CopyFrom(const FOGPolymorphicMultiBankBase& Other)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicMultiBankBase::CopyFrom);
+	LLM_SCOPE_BYTAG(OGCore);
+	Elements.Reserve(Other.Elements.Num());
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	//Walk the type index rather than the element map so the copy keeps the per type order
+	for (const auto& [TypeKey, Handles] : Other.TypeIndex)
+	{
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(TypeKey);
+		for (const FOGDataBankElementHandle& Handle : Handles)
+		{
+			FOGPolymorphicStructBase& NewElement = AddWithId_Internal(Handle.GetHandleId(), TypeKey, Struct);
+			Struct->CopyScriptStruct(&NewElement, &Other.Elements.FindChecked(Handle.GetHandleId()).Data.Get());
+			MarkDirty(NewElement);
+		}
+	}
+}
+
+bool FOGPolymorphicMultiBankBase::Remove(const FOGDataBankElementHandle& Handle)
+{
+	if (!Elements.Contains(Handle.GetHandleId()))
+		return false;
+	Remove_Internal(Handle.GetHandleId());
+	++LastReplicationKey;
+	return true;
+}
+
+void FOGPolymorphicMultiBankBase::Empty()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicMultiBankBase::Empty);
+	DEC_DWORD_STAT_BY(STAT_OGCore_LiveEntries, Elements.Num());
+	Elements.Empty();
+	TypeIndex.Empty();
+	GuidReferencesMap.Empty();
+	++LastReplicationKey;
+}
+
+void FOGPolymorphicMultiBankBase::AddStructReferencedObjects(FReferenceCollector& Collector)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicMultiBankBase::AddStructReferencedObjects);
+	const FOGPolymorphicStructCache* StructCache = GetStructCache();
+	if(!ensure(StructCache))
+		return;
+	for (auto& [Id, Element] : Elements)
+	{
+		const UScriptStruct* Struct = StructCache->GetTypeForIndex(Element.TypeKey);
+		if (!ensure(Struct))
+			continue;
+		Collector.AddPropertyReferencesWithStructARO(Struct, &Element.Data.Get());
+	}
+}
+
+bool FOGPolymorphicMultiBankBase::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicMultiBankBase::NetSerialize);
+	LLM_SCOPE_BYTAG(OGCore);
+	FOGPolymorphicStructCache* StructCache = GetStructCache();
+	if(!ensure(StructCache)) [[unlikely]]
+		return false;
+	uint32 ElementNum = Elements.Num();
+	Ar.SerializeIntPacked(ElementNum);
+
+	if (Ar.IsSaving())
+	{
+		for (auto& [Id, Element] : Elements)
+		{
+			OGHandleIdType IdToWrite = Id;
+			OGHandle::NetSerializeId(Ar, IdToWrite);
+			Ar << Element.TypeKey;
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(Element.TypeKey);
+			if(!ensure(Struct)) [[unlikely]]
+				return false;
+			OGDataBankNet::NetSerializeEntry(Ar, Map, Struct, &Element.Data.Get(), bOutSuccess);
+		}
+		return true;
+	}
+	else
+	{
+		//When loading, need to clear out the old values first.
+		Empty();
+		bool bHasUnmapped = false;
+		for (uint32 Idx = 0; Idx < ElementNum; ++Idx)
+		{
+			OGHandleIdType Id = 0;
+			OGHandle::NetSerializeId(Ar, Id);
+			uint16 TypeKey;
+			Ar << TypeKey;
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(TypeKey);
+			if(!ensure(Struct) || Ar.IsError()) [[unlikely]]
+				return false;
+			FOGPolymorphicStructBase* NewElement = &AddWithId_Internal(Id, TypeKey, Struct);
+			bHasUnmapped |= OGDataBankNet::NetSerializeEntry(Ar, Map, Struct, NewElement, bOutSuccess);
+		}
+		return !bHasUnmapped;
+	}
+}
+
+bool FOGPolymorphicMultiBankBase::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicMultiBankBase::NetDeltaSerialize);
+	LLM_SCOPE_BYTAG(OGCore);
+	if ( DeltaParams.GatherGuidReferences )
+	{
+		OGDataBankNet::GatherGuidReferences(GuidReferencesMap, DeltaParams);
+		return true;
+	}
+
+	if ( DeltaParams.MoveGuidToUnmapped )
+	{
+		return OGDataBankNet::MoveGuidToUnmapped(GuidReferencesMap, *DeltaParams.MoveGuidToUnmapped);
+	}
+
+	if ( DeltaParams.bUpdateUnmappedObjects )
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicMultiBankBase::UpdateUnmappedObjects);
+		OGDataBankNet::UpdateUnmappedObjects(GuidReferencesMap, DeltaParams,
+			[this](const OGHandleIdType Id) { return Elements.Contains(Id); },
+			[this, &DeltaParams](const OGHandleIdType Id, FNetBitReader& Reader)
+			{
+				FElement& Element = Elements.FindChecked(Id);
+				DeltaParams.Struct = GetStructCache()->GetTypeForIndex(Element.TypeKey);
+				DeltaParams.Data = &Element.Data.Get();
+				DeltaParams.Reader = &Reader;
+				DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
+			});
+		return true;
+	}
+
+	if (DeltaParams.Writer)
+	{
+		//-----------------------------
+		// Saving
+		//-----------------------------
+		TMap<OGHandleIdType, uint16>* OldMap = nullptr;
+		if (DeltaParams.OldState)
+		{
+			FOGPolymorphicMultiBankDeltaState* OldState = static_cast<FOGPolymorphicMultiBankDeltaState*>(DeltaParams.OldState);
+			if (OldState->ContainerReplicationKey == LastReplicationKey) //If the container is not dirty, we're done
+			{
+				*DeltaParams.NewState = DeltaParams.OldState->AsShared();
+				return false;
+			}
+			OldMap = &OldState->IDToRepKeyMap;
+		}
+
+		FOGPolymorphicMultiBankDeltaState* NewState = new FOGPolymorphicMultiBankDeltaState();
+		if (const UPackageMapClient* MapClient = Cast<UPackageMapClient>(DeltaParams.Map))
+		{
+			NewState->Connection = MapClient->GetConnection();
+		}
+		check(DeltaParams.NewState);
+		*DeltaParams.NewState = MakeShareable( NewState );
+		TMap<OGHandleIdType, uint16>& NewMap = NewState->IDToRepKeyMap;
+		NewMap.Reserve(Elements.Num());
+		NewState->ContainerReplicationKey = LastReplicationKey;
+
+		TArray<OGHandleIdType> ChangedIds;
+		for (auto& [Id, Element] : Elements)
+		{
+			const uint16 ElementKey = Element.Data->ReplicationKey;
+			NewMap.Add(Id, ElementKey);
+			const uint16* OldKey = OldMap ? OldMap->Find(Id) : nullptr;
+			if (!OldKey || *OldKey != ElementKey)
+			{
+				ChangedIds.Add(Id);
+			}
+		}
+
+		TArray<OGHandleIdType> RemovedIds;
+		if (OldMap)
+		{
+			for (const auto& [Id, OldKey] : *OldMap)
+			{
+				if (!Elements.Contains(Id))
+				{
+					RemovedIds.Add(Id);
+				}
+			}
+		}
+
+		FBitWriter& Writer = *DeltaParams.Writer;
+		FOGPolymorphicStructCache* StructCache = GetStructCache();
+
+		uint32 RemovedCount = RemovedIds.Num();
+		Writer.SerializeIntPacked(RemovedCount);
+		for (OGHandleIdType& RemovedId : RemovedIds)
+		{
+			OGHandle::NetSerializeId(Writer, RemovedId);
+		}
+
+		uint32 ReplicatedCount = ChangedIds.Num();
+		Writer.SerializeIntPacked(ReplicatedCount);
+		for (OGHandleIdType& ChangedId : ChangedIds)
+		{
+			FElement& Element = Elements.FindChecked(ChangedId);
+			OGHandle::NetSerializeId(Writer, ChangedId);
+			Writer << Element.TypeKey;
+
+			DeltaParams.Struct = StructCache->GetTypeForIndex(Element.TypeKey);
+			DeltaParams.Data = &Element.Data.Get();
+			DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
+		}
+	}
+	else
+	{
+		//-----------------------------
+		// Loading
+		//-----------------------------
+		check(DeltaParams.Reader);
+		FBitReader& Reader = *DeltaParams.Reader;
+
+		uint32 RemovedCount = 0;
+		Reader.SerializeIntPacked(RemovedCount);
+		for (uint32 Idx = 0; Idx < RemovedCount && !Reader.IsError(); ++Idx)
+		{
+			OGHandleIdType RemovedId = 0;
+			OGHandle::NetSerializeId(Reader, RemovedId);
+			Remove_Internal(RemovedId);
+		}
+
+		FOGPolymorphicStructCache* StructCache = GetStructCache();
+		uint32 AddOrChangedCount = 0;
+		Reader.SerializeIntPacked(AddOrChangedCount);
+		for (uint32 Idx = 0; Idx < AddOrChangedCount && !Reader.IsError(); ++Idx)
+		{
+			OGHandleIdType Id = 0;
+			OGHandle::NetSerializeId(Reader, Id);
+			uint16 TypeKey;
+			Reader << TypeKey;
+			UScriptStruct* Struct = StructCache->GetTypeForIndex(TypeKey);
+			if (!ensure(Struct)) [[unlikely]]
+			{
+				Reader.SetError();
+				break;
+			}
+
+			FOGPolymorphicStructBase* DataPtr;
+			FElement* Existing = Elements.Find(Id);
+			if (Existing && Existing->TypeKey == TypeKey)
+			{
+				DataPtr = &Existing->Data.Get();
+				MarkDirty(*DataPtr);
+			}
+			else
+			{
+				//A handle can't change type on the server, but the id may have been reused after a removal we missed
+				if (Existing)
+				{
+					Remove_Internal(Id);
+				}
+				DataPtr = &AddWithId_Internal(Id, TypeKey, Struct);
+			}
+
+			DeltaParams.Map->ResetTrackedGuids( true );
+			FBitReaderMark Mark( Reader );
+
+			DeltaParams.Struct = Struct;
+			DeltaParams.Data = DataPtr;
+			DeltaParams.NetSerializeCB->NetSerializeStruct(DeltaParams);
+
+			OGDataBankNet::TrackReceivedGuids(GuidReferencesMap, Id, DeltaParams, Reader, Mark);
+
+			DeltaParams.Map->ResetTrackedGuids( false );
+		}
+	}
+	return true;
+}
+
+FOGPolymorphicStructCache* FOGPolymorphicMultiBankBase::GetStructCache() const
+{
+	return FOGCoreModule::GetUniversalStructCache();
+}
+
+FOGPolymorphicStructBase& FOGPolymorphicMultiBankBase::Add_Internal(const uint16 TypeKey, const UScriptStruct* ScriptStruct, FOGDataBankElementHandle& OutHandle)
+{
+	OutHandle = FOGHandleBase::GenerateHandle<FOGDataBankElementHandle>();
+	return AddWithId_Internal(OutHandle.GetHandleId(), TypeKey, ScriptStruct);
+}
+
+FOGPolymorphicStructBase& FOGPolymorphicMultiBankBase::AddWithId_Internal(const OGHandleIdType Id, const uint16 TypeKey, const UScriptStruct* ScriptStruct)
+{
+	LLM_SCOPE_BYTAG(OGCore);
+	check(!Elements.Contains(Id));
+	const TSharedRef<FOGPolymorphicStructBase> NewEntry = FOGPolymorphicDataBankBase::AllocateEntry(ScriptStruct);
+	MarkDirty(NewEntry.Get());
+	Elements.Add(Id, FElement{TypeKey, NewEntry});
+	TypeIndex.FindOrAdd(TypeKey).Emplace(Id);
+	INC_DWORD_STAT(STAT_OGCore_LiveEntries);
+	return NewEntry.Get();
+}
+
+FOGPolymorphicStructBase* FOGPolymorphicMultiBankBase::Get_Internal(const OGHandleIdType Id)
+{
+	FElement* Element = Elements.Find(Id);
+	if (!Element)
+		return nullptr;
+	MarkDirty(Element->Data.Get());
+	return &Element->Data.Get();
+}
+
+const FOGPolymorphicStructBase* FOGPolymorphicMultiBankBase::GetConst_Internal(const OGHandleIdType Id) const
+{
+	const FElement* Element = Elements.Find(Id);
+	return Element ? &Element->Data.Get() : nullptr;
+}
+
+void FOGPolymorphicMultiBankBase::Remove_Internal(const OGHandleIdType Id)
+{
+	const FElement* Removed = Elements.Find(Id);
+	if (!Removed)
+		return;
+	const uint16 TypeKey = Removed->TypeKey;
+	Elements.Remove(Id);
+	DEC_DWORD_STAT(STAT_OGCore_LiveEntries);
+	GuidReferencesMap.Remove(Id);
+	if (TArray<FOGDataBankElementHandle>* Handles = TypeIndex.Find(TypeKey))
+	{
+		//Keep the add order, GetHandlesOfType is documented to return it
+		Handles->RemoveSingle(FOGDataBankElementHandle(Id));
+		if (Handles->IsEmpty())
+		{
+			TypeIndex.Remove(TypeKey);
+		}
+	}
+}
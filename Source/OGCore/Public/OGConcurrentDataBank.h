@@ -0,0 +1,95 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGPolymorphicDataBank.h"
+#include "Containers/LockFreeList.h"
+#include <atomic>
+
+/**
+ * Staging area for data bank entries that are written from worker threads, e.g. async physics callbacks or parallel AI tasks.
+ * Every entry type has its own atomic slot. SetByCopy publishes a fresh copy of the entry with release semantics
+ * and Find acquires the latest published copy, neither takes a lock.
+ *
+ * Commit runs on the game thread and moves every entry written since the previous Commit into a regular bank,
+ * marking them dirty so they replicate. Committed entries are shared with the bank rather than copied,
+ * the bank copies an entry before it writes to it.
+ *
+ * Pointers returned by Find stay valid until the next Commit. Commit must not overlap with Find on other threads,
+ * typically it runs once the parallel work that fills the concurrent bank has completed.
+ */
+class OGCORE_API FOGConcurrentDataBank : public FNoncopyable
+{
+public:
+	// Takes InnerStruct and the struct cache from the bank this will commit into
+	explicit FOGConcurrentDataBank(const FOGPolymorphicDataBankBase& TargetBank);
+	~FOGConcurrentDataBank();
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void SetByCopy(const Derived& Source)
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		uint16 Key;
+		if (!TryGetKey(Struct, Key)) [[unlikely]]
+			return;
+		const TSharedRef<FOGPolymorphicStructBase> Entry = FOGPolymorphicDataBankBase::AllocateEntry(Struct);
+		static_cast<Derived&>(Entry.Get()) = Source;
+		Publish(Key, Entry);
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived* Find() const
+	{
+		uint16 Key;
+		if (!TryGetKey(Derived::StaticStruct(), Key)) [[unlikely]]
+			return nullptr;
+		const FSlotValue* Value = Slots[Key].Value.load(std::memory_order_acquire);
+		return Value ? static_cast<const Derived*>(&Value->Entry.Get()) : nullptr;
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	bool Contains() const
+	{
+		uint16 Key;
+		if (!TryGetKey(Derived::StaticStruct(), Key)) [[unlikely]]
+			return false;
+		return Slots[Key].Value.load(std::memory_order_acquire) != nullptr;
+	}
+
+	// Game thread only. Returns the number of entries written into TargetBank.
+	int32 Commit(FOGPolymorphicDataBankBase& TargetBank);
+
+private:
+	struct FSlotValue
+	{
+		TSharedRef<FOGPolymorphicStructBase> Entry;
+	};
+
+	// One cache line per slot so threads writing different entry types don't contend
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+	{
+		std::atomic<FSlotValue*> Value = nullptr;
+		std::atomic<bool> bPendingCommit = false;
+	};
+
+	// False for types outside InnerStruct, which must not touch any slot
+	bool TryGetKey(const UScriptStruct* ScriptStruct, uint16& OutKey) const
+	{
+		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(InnerStruct), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
+			return false;
+		OutKey = StructCache->GetIndexForType(ScriptStruct);
+		check(OutKey < NumSlots);
+		return true;
+	}
+
+	void Publish(const uint16 Key, const TSharedRef<FOGPolymorphicStructBase>& Entry);
+
+	const FOGPolymorphicStructCache* StructCache = nullptr;
+	const UScriptStruct* InnerStruct = nullptr;
+	TUniquePtr<FSlot[]> Slots;
+	int32 NumSlots = 0;
+
+	// Values replaced by SetByCopy, freed on Commit since other threads may still be reading them
+	TLockFreePointerListUnordered<FSlotValue, PLATFORM_CACHE_LINE_SIZE> Retired;
+};
@@ -4,6 +4,8 @@
 
 #include "Modules/ModuleManager.h"
 
+OGCORE_API DECLARE_LOG_CATEGORY_EXTERN(LogOGCore, Log, All);
+
 struct FOGPolymorphicStructCache;
 
 class FOGCoreModule : public IModuleInterface
@@ -16,9 +18,15 @@ public:
 
 	static FOGPolymorphicStructCache* GetUniversalStructCache();
 
+	// Keep GroupType and everything deriving from it out of the universal StructCache, so adding or removing those types
+	// doesn't change the keys of any other type. Banks holding them must return their own cache from GetStructCache.
+	// Must be called before all modules finished loading, e.g. from StartupModule.
+	static void ExcludeFromUniversalStructCache(const UScriptStruct* GroupType);
+
 protected:
 
 	static void OnAllModulesLoaded();
 	
 	FDelegateHandle ModulesLoadedHandle;
+	FDelegateHandle EndFrameHandle;
 };
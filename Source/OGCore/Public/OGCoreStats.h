@@ -0,0 +1,25 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+/**
+ * Stats and memory tracking for OGCore.
+ * View with "stat OGCore" in game, or the OGCore LLM tag in "stat llmfull" and memreports.
+ * Stats, LLM and cpu trace scopes all compile out in Shipping builds.
+ */
+
+DECLARE_STATS_GROUP(TEXT("OGCore"), STATGROUP_OGCore, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Data Banks"), STAT_OGCore_LiveBanks, STATGROUP_OGCore, OGCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Data Bank Entries"), STAT_OGCore_LiveEntries, STATGROUP_OGCore, OGCORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Data Bank Entry Memory"), STAT_OGCore_EntryMemory, STATGROUP_OGCore, OGCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Bank Lookups"), STAT_OGCore_Lookups, STATGROUP_OGCore, OGCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Bank Dirty Marks"), STAT_OGCore_DirtyMarks, STATGROUP_OGCore, OGCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Bank Redundant Writes Skipped"), STAT_OGCore_RedundantWrites, STATGROUP_OGCore, OGCORE_API);
+
+LLM_DECLARE_TAG_API(OGCore, OGCORE_API);
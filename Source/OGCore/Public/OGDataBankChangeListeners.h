@@ -0,0 +1,80 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGFuture.h"
+#include "OGHandleBase.h"
+#include "OGDataBankChangeListeners.generated.h"
+
+struct FOGPolymorphicStructCache;
+
+/** Identifies a change subscription on a data bank, see FOGPolymorphicDataBankBase::SubscribeToChanges */
+USTRUCT(BlueprintType)
+struct OGCORE_API FOGDataBankSubscriptionHandle : public FOGHandleBase
+{
+	GENERATED_BODY()
+
+	FOGDataBankSubscriptionHandle() : FOGHandleBase() {}
+	FOGDataBankSubscriptionHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGDataBankSubscriptionHandle> : public TOGHandleStructOpsTypeTraits<FOGDataBankSubscriptionHandle>
+{
+};
+
+// Receives the entry types that were added, written or removed since the last delivery
+DECLARE_DELEGATE_OneParam(FOGOnDataBankChanged, TConstArrayView<UScriptStruct*> /*ChangedTypes*/);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOGOnDataBankChangedDynamic, const TArray<UScriptStruct*>&, ChangedTypes);
+
+/**
+ * The change subscriptions and pending futures of one data bank. The bank only creates this once something subscribes
+ * or waits, banks nobody listens to pay for a null pointer check per mutation.
+ *
+ * Changes are coalesced per entry type and delivered once per frame at the end of the frame, each subscription only gets
+ * called if one of the changed types is the type it subscribed to or derives from it.
+ * Futures are fulfilled in the same flush, so continuations always see the entry after the writes of that frame.
+ * Game thread only.
+ */
+class OGCORE_API FOGDataBankChangeListeners : public TSharedFromThis<FOGDataBankChangeListeners>
+{
+public:
+	explicit FOGDataBankChangeListeners(const FOGPolymorphicStructCache* InStructCache) : StructCache(InStructCache) {}
+
+	FOGDataBankSubscriptionHandle Add(const uint16 TypeKey, FOGOnDataBankChanged&& Delegate);
+	FOGDataBankSubscriptionHandle Add(const uint16 TypeKey, const FOGOnDataBankChangedDynamic& Delegate);
+	bool Remove(const FOGDataBankSubscriptionHandle& Handle);
+
+	// Fulfilled at the next flush after an entry of exactly TypeKey was added (or written, for WhenChanged)
+	TOGFuture<void> WhenContains(const uint16 TypeKey);
+	TOGFuture<void> WhenChanged(const uint16 TypeKey);
+
+	// Called by the bank for every added, written or removed key. bPresent is false for removals.
+	void MarkChanged(const uint16 Key, const bool bPresent);
+
+	// Deliver the pending changes of every bank, called by the module at the end of each frame
+	static void FlushAll();
+
+private:
+	void Flush();
+
+	struct FSubscription
+	{
+		FOGDataBankSubscriptionHandle Handle;
+		// Keys of the subscribed type and everything deriving from it
+		TPair<uint16, uint16> KeyRange;
+		FOGOnDataBankChanged Delegate;
+		FOGOnDataBankChangedDynamic DynamicDelegate;
+	};
+
+	FOGDataBankSubscriptionHandle Add_Internal(const uint16 TypeKey, FSubscription&& Subscription);
+	bool HasListeners() const { return !Subscriptions.IsEmpty() || !ContainsWaiters.IsEmpty() || !ChangedWaiters.IsEmpty(); }
+
+	const FOGPolymorphicStructCache* StructCache;
+	TArray<FSubscription> Subscriptions;
+	TArray<TPair<uint16, TOGPromise<void>>> ContainsWaiters;
+	TArray<TPair<uint16, TOGPromise<void>>> ChangedWaiters;
+	// Changed keys since the last flush and whether the entry was still there after the last change
+	TMap<uint16, bool> PendingKeys;
+};
@@ -0,0 +1,178 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGPolymorphicDataBank.h"
+#include "Async/ParallelFor.h"
+#include "UObject/GCObject.h"
+
+/**
+ * Many logical data banks stored column-wise, for systems that want "every bank that has FMyVelocityData".
+ * Each entry type gets one contiguous column indexed by entity, plus a presence bit per entity. Visiting every entity that
+ * has a type is a linear walk of that column, and slots of entities without the entry are zeroed so whole columns can be
+ * processed with SIMD and masked afterwards.
+ *
+ * A single entity can be handed to code that works on regular banks with CopyToBank, and written back with CopyFromBank.
+ * The bank holds copies of the entries, so it stays valid however the store changes afterwards.
+ *
+ * Pointers into columns are invalidated when entities are added beyond the current capacity.
+ *
+ * Entry types that don't derive from the store's InnerStruct are rejected: lookups return nothing, AddUnique asserts.
+ * Objects referenced by present entries are reported to garbage collection, like entries in a bank.
+ * Not thread-safe, except that ParallelForEach workers may each write to their own entity.
+ */
+class OGCORE_API FOGDataBankColumnStore : public FGCObject
+{
+public:
+	// Takes InnerStruct and the struct cache from the kind of bank this store holds
+	explicit FOGDataBankColumnStore(const FOGPolymorphicDataBankBase& BankPrototype);
+	virtual ~FOGDataBankColumnStore() override;
+	FOGDataBankColumnStore(const FOGDataBankColumnStore&) = delete;
+	FOGDataBankColumnStore& operator=(const FOGDataBankColumnStore&) = delete;
+
+	int32 AddEntity();
+	void RemoveEntity(const int32 Entity);
+	bool IsValidEntity(const int32 Entity) const { return Entities.IsValidIndex(Entity) && Entities[Entity]; }
+	int32 GetNumEntities() const { return NumLiveEntities; }
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived& AddUnique(const int32 Entity)
+	{
+		const int32 Key = GetKey(Derived::StaticStruct());
+		checkf(Key != INDEX_NONE, TEXT("%s can't be stored in this column store"), *Derived::StaticStruct()->GetName());
+		return *static_cast<Derived*>(AddRaw(Key, Entity));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void Remove(const int32 Entity)
+	{
+		const int32 Key = GetKey(Derived::StaticStruct());
+		if (Key != INDEX_NONE) [[likely]]
+		{
+			RemoveRaw(Key, Entity);
+		}
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived* Find(const int32 Entity)
+	{
+		const int32 Key = GetKey(Derived::StaticStruct());
+		return Key != INDEX_NONE ? static_cast<Derived*>(FindRaw(Key, Entity)) : nullptr;
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived* FindConst(const int32 Entity) const
+	{
+		return const_cast<FOGDataBankColumnStore*>(this)->Find<Derived>(Entity);
+	}
+
+	// The whole column, indexed by entity. Slots whose presence bit is clear are zeroed.
+	// Empty if no entity ever had Derived.
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	TArrayView<Derived> GetColumn()
+	{
+		const FColumn* Column = FindColumn(Derived::StaticStruct());
+		if (!Column || !Column->Data)
+			return TArrayView<Derived>();
+		checkf(Column->Stride == sizeof(Derived), TEXT("Column access requires the exact entry type"));
+		return TArrayView<Derived>(reinterpret_cast<Derived*>(Column->Data), EntityCapacity);
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const TBitArray<>& GetPresence() const
+	{
+		static const TBitArray<> NoPresence;
+		const FColumn* Column = FindColumn(Derived::StaticStruct());
+		return Column ? Column->Presence : NoPresence;
+	}
+
+	// Func(int32 Entity, Derived& Entry) for every entity that has Derived, in entity order
+	template <typename Derived, typename FuncType UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void ForEach(FuncType&& Func)
+	{
+		const FColumn* Column = FindColumn(Derived::StaticStruct());
+		if (!Column || !Column->Data)
+			return;
+		for (TConstSetBitIterator<> It(Column->Presence); It; ++It)
+		{
+			Func(It.GetIndex(), *reinterpret_cast<Derived*>(Column->Data + It.GetIndex() * Column->Stride));
+		}
+	}
+
+	// As ForEach, with the column split across worker threads
+	template <typename Derived, typename FuncType UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void ParallelForEach(FuncType&& Func, const int32 MinBatchSize = 256)
+	{
+		const FColumn* ColumnPtr = FindColumn(Derived::StaticStruct());
+		if (!ColumnPtr || !ColumnPtr->Data)
+			return;
+		const FColumn& Column = *ColumnPtr;
+		const int32 NumBatches = FMath::DivideAndRoundUp(EntityCapacity, MinBatchSize);
+		ParallelFor(NumBatches, [&Column, &Func, MinBatchSize, this](const int32 Batch)
+		{
+			const int32 End = FMath::Min((Batch + 1) * MinBatchSize, EntityCapacity);
+			for (int32 Entity = Batch * MinBatchSize; Entity < End; ++Entity)
+			{
+				if (Column.Presence[Entity])
+				{
+					Func(Entity, *reinterpret_cast<Derived*>(Column.Data + Entity * Column.Stride));
+				}
+			}
+		});
+	}
+
+	// Replace the contents of OutBank with copies of every entry of Entity. OutBank must be the kind of bank this store was created for.
+	void CopyToBank(const int32 Entity, FOGPolymorphicDataBankBase& OutBank) const;
+
+	// Make Entity hold exactly the entries of Bank: entries are copied in, entries Bank doesn't have are removed from Entity
+	void CopyFromBank(const int32 Entity, const FOGPolymorphicDataBankBase& Bank);
+
+	// Heap memory used by the store: the columns, including memory owned by the entries' members, and the entity bookkeeping.
+	// OutBytesPerEntryType, if given, accumulates the size of each column by entry type.
+	SIZE_T GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType = nullptr) const;
+
+	// Stores aren't reflected, so "OGCore.DataBank.MemReport" finds them through this instead
+	static void ForEachLiveStore(TFunctionRef<void(const FOGDataBankColumnStore&)> Func);
+
+	//~ FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FOGDataBankColumnStore"); }
+	//~ End FGCObject interface
+
+private:
+	struct FColumn
+	{
+		uint8* Data = nullptr;
+		int32 Stride = 0;
+		TBitArray<> Presence;
+	};
+
+	// INDEX_NONE for types this store can't hold
+	int32 GetKey(const UScriptStruct* ScriptStruct) const
+	{
+		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(InnerStruct), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
+			return INDEX_NONE;
+		const uint16 Key = StructCache->GetIndexForType(ScriptStruct);
+		return Columns.IsValidIndex(Key) ? Key : INDEX_NONE;
+	}
+
+	const FColumn* FindColumn(const UScriptStruct* ScriptStruct) const
+	{
+		const int32 Key = GetKey(ScriptStruct);
+		return Key != INDEX_NONE ? &Columns[Key] : nullptr;
+	}
+
+	void* AddRaw(const uint16 Key, const int32 Entity);
+	void RemoveRaw(const uint16 Key, const int32 Entity);
+	void* FindRaw(const uint16 Key, const int32 Entity);
+	void GrowColumn(const uint16 Key, const int32 OldCapacity);
+
+	const FOGPolymorphicStructCache* StructCache = nullptr;
+	const UScriptStruct* InnerStruct = nullptr;
+	TArray<FColumn> Columns;
+	TBitArray<> Entities;
+	TArray<int32> FreeEntities;
+	int32 EntityCapacity = 0;
+	int32 NumLiveEntities = 0;
+};
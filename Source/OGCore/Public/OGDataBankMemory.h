@@ -0,0 +1,25 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+
+class UNetConnection;
+
+/**
+ * Base of the data bank delta states. Live states are tracked so "OGCore.DataBank.MemReport" can total them per connection,
+ * the engine only counts them as part of each connection's replicators.
+ * Delta states are created and destroyed by replication on the game thread.
+ */
+class OGCORE_API FOGDataBankDeltaStateBase : public INetDeltaBaseState
+{
+public:
+	FOGDataBankDeltaStateBase();
+	virtual ~FOGDataBankDeltaStateBase() override;
+
+	// The connection the state was created for, only used to group memory reports
+	TWeakObjectPtr<UNetConnection> Connection;
+
+	static void ForEachLiveState(TFunctionRef<void(const FOGDataBankDeltaStateBase&)> Func);
+};
@@ -0,0 +1,168 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGPolymorphicDataBank.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNet.h"
+
+/**
+ * Replication plumbing shared by the data bank and the multi bank. Both keep the guid references of their entries in a
+ * map, the data bank keyed by type key and the multi bank by element id, so the helpers are templated on the key.
+ */
+namespace OGDataBankNet
+{
+	// Serialize one entry with its native NetSerialize, or through its rep layout if it has none.
+	// Returns true if the entry has object references that couldn't be resolved yet.
+	OGCORE_API bool NetSerializeEntry(FArchive& Ar, UPackageMap* Map, UScriptStruct* Struct, FOGPolymorphicStructBase* Data, bool& bOutSuccess);
+
+	template <typename KeyType>
+	void GatherGuidReferences(const TMap<KeyType, FOGPolymorphicDataBankSerializerGuidReferences>& GuidReferencesMap, FNetDeltaSerializeInfo& DeltaParams)
+	{
+		for (const auto& [Key, GuidReferences] : GuidReferencesMap)
+		{
+			DeltaParams.GatherGuidReferences->Append(GuidReferences.UnmappedGUIDs);
+			DeltaParams.GatherGuidReferences->Append(GuidReferences.MappedDynamicGUIDs);
+
+			if (DeltaParams.TrackedGuidMemoryBytes)
+			{
+				*DeltaParams.TrackedGuidMemoryBytes += GuidReferences.Buffer.Num();
+			}
+		}
+	}
+
+	// Returns true if any entry referenced the guid
+	template <typename KeyType>
+	bool MoveGuidToUnmapped(TMap<KeyType, FOGPolymorphicDataBankSerializerGuidReferences>& GuidReferencesMap, const FNetworkGUID& GUID)
+	{
+		bool bFound = false;
+		for (auto& [Key, GuidReferences] : GuidReferencesMap)
+		{
+			if (GuidReferences.MappedDynamicGUIDs.Remove(GUID) > 0)
+			{
+				GuidReferences.UnmappedGUIDs.Add(GUID);
+				bFound = true;
+			}
+		}
+		return bFound;
+	}
+
+	/**
+	 * Check every entry with unmapped guids for guids that resolved since, and read those entries again from their buffered bits.
+	 * Contains(Key) tells whether the entry still exists, entries that don't or that have no guids left stop being tracked.
+	 * Reread(Key, Reader) must point DeltaParams at the entry and NetSerializeStruct it from Reader.
+	 */
+	template <typename KeyType, typename ContainsFuncType, typename RereadFuncType>
+	void UpdateUnmappedObjects(TMap<KeyType, FOGPolymorphicDataBankSerializerGuidReferences>& GuidReferencesMap, FNetDeltaSerializeInfo& DeltaParams,
+		ContainsFuncType&& Contains, RereadFuncType&& Reread)
+	{
+		TArray<KeyType, TInlineAllocator<8>> KeysToStopTracking;
+
+		for (auto& [Key, GuidReferences] : GuidReferencesMap)
+		{
+			if ((GuidReferences.UnmappedGUIDs.Num() == 0 && GuidReferences.MappedDynamicGUIDs.Num() == 0) || !Contains(Key))
+			{
+				// The entry is gone (or all guids were removed), stop tracking it
+				KeysToStopTracking.Add(Key);
+				continue;
+			}
+
+			bool bMappedSomeGUIDs = false;
+			for (auto UnmappedIt = GuidReferences.UnmappedGUIDs.CreateIterator(); UnmappedIt; ++UnmappedIt)
+			{
+				const FNetworkGUID& GUID = *UnmappedIt;
+				if (DeltaParams.Map->IsGUIDBroken(GUID, false))
+				{
+					// Stop trying to load broken guids
+					UnmappedIt.RemoveCurrent();
+					continue;
+				}
+				if (DeltaParams.Map->GetObjectFromNetGUID(GUID, false) != nullptr)
+				{
+					if (GUID.IsDynamic())
+					{
+						GuidReferences.MappedDynamicGUIDs.Add(GUID);
+					}
+					UnmappedIt.RemoveCurrent();
+					bMappedSomeGUIDs = true;
+				}
+			}
+
+			// Read the entry again now that some of its objects can be resolved
+			if (bMappedSomeGUIDs)
+			{
+				DeltaParams.bOutSomeObjectsWereMapped = true;
+				if (!DeltaParams.bCalledPreNetReceive)
+				{
+					// Some game code needs to think this is an actual replicated value
+					DeltaParams.Object->PreNetReceive();
+					DeltaParams.bCalledPreNetReceive = true;
+				}
+
+				FNetBitReader Reader(DeltaParams.Map, GuidReferences.Buffer.GetData(), GuidReferences.NumBufferBits);
+				Reread(Key, Reader);
+			}
+
+			if (GuidReferences.UnmappedGUIDs.Num() == 0 && GuidReferences.MappedDynamicGUIDs.Num() == 0)
+			{
+				KeysToStopTracking.Add(Key);
+			}
+		}
+
+		//Only the tracking goes away, the entry itself stays in the bank
+		for (const KeyType& Key : KeysToStopTracking)
+		{
+			GuidReferencesMap.Remove(Key);
+		}
+
+		if (GuidReferencesMap.Num() > 0)
+		{
+			DeltaParams.bOutHasMoreUnmapped = true;
+		}
+	}
+
+	/**
+	 * Call after an entry was read by NetDeltaSerialize, between ResetTrackedGuids(true) and ResetTrackedGuids(false).
+	 * Remembers the guids the entry couldn't resolve along with its bits from Mark to the reader position, so
+	 * UpdateUnmappedObjects can read it again later, or stops tracking the entry if everything resolved.
+	 */
+	template <typename KeyType>
+	void TrackReceivedGuids(TMap<KeyType, FOGPolymorphicDataBankSerializerGuidReferences>& GuidReferencesMap, const KeyType& Key,
+		FNetDeltaSerializeInfo& DeltaParams, FBitReader& Reader, FBitReaderMark& Mark)
+	{
+		if (Reader.IsError())
+			return;
+
+		const TSet<FNetworkGUID>& TrackedUnmappedGuids = DeltaParams.Map->GetTrackedUnmappedGuids();
+		const TSet<FNetworkGUID>& TrackedMappedDynamicGuids = DeltaParams.Map->GetTrackedDynamicMappedGuids();
+		if (!TrackedUnmappedGuids.Num() && !TrackedMappedDynamicGuids.Num())
+		{
+			GuidReferencesMap.Remove(Key);
+			return;
+		}
+
+		FOGPolymorphicDataBankSerializerGuidReferences& GuidReferences = GuidReferencesMap.FindOrAdd(Key);
+		if (!NetworkGuidSetsAreSame(GuidReferences.UnmappedGUIDs, TrackedUnmappedGuids))
+		{
+			GuidReferences.UnmappedGUIDs = TrackedUnmappedGuids;
+			DeltaParams.bGuidListsChanged = true;
+		}
+		if (!NetworkGuidSetsAreSame(GuidReferences.MappedDynamicGUIDs, TrackedMappedDynamicGuids))
+		{
+			GuidReferences.MappedDynamicGUIDs = TrackedMappedDynamicGuids;
+			DeltaParams.bGuidListsChanged = true;
+		}
+
+		GuidReferences.Buffer.Empty();
+		check(Reader.GetPosBits() - Mark.GetPos() <= TNumericLimits<int32>::Max());
+		GuidReferences.NumBufferBits = int32(Reader.GetPosBits() - Mark.GetPos());
+		Mark.Copy(Reader, GuidReferences.Buffer);
+
+		// Tells the caller this bank needs to be tracked for unmapped guids
+		if (TrackedUnmappedGuids.Num())
+		{
+			DeltaParams.bOutHasMoreUnmapped = true;
+		}
+	}
+}
@@ -0,0 +1,125 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "Components/ActorComponent.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+#include "OGDataBankRPCBaselines.generated.h"
+
+class UPackageMap;
+struct FOGPolymorphicStructBase;
+struct FOGPolymorphicStructCache;
+
+/**
+ * Banks recently sent and received on each connection by data banks that use RPC baselines,
+ * see FOGPolymorphicDataBankBase::UsesRPCBaselines.
+ *
+ * Every bank instance that sends is its own stream, identified by an id it sends along. Copies of a bank continue its
+ * stream, since an RPC sends a copy of its parameters rather than the bank it was called with. Every send is recorded as a
+ * baseline with an id unique to the connection. Once the receiver acknowledges an id the sender encodes later sends of
+ * that bank as the difference to it, until then it sends everything. Both sides keep the last RingSize baselines per
+ * stream, so any baseline the sender still references is still held by the receiver. A receiver that lost the baseline
+ * anyway (e.g. the stream was evicted) fails that read and resets the stream, and the sender's next send of it is a full one again.
+ * Connections are identified by their package map, of which there is one per connection.
+ * Baselines share their entries with the banks, like snapshots, and keep the objects they reference alive until they
+ * drop out of the ring.
+ * Game thread only.
+ */
+class OGCORE_API FOGDataBankRPCBaselines : public FGCObject
+{
+public:
+	using FEntries = TMap<uint16, TSharedRef<FOGPolymorphicStructBase>>;
+
+	static constexpr int32 RingSize = 8;
+	// Least recently used streams are dropped past this, sends on a dropped stream start over with a full send
+	static constexpr int32 MaxStreamsPerConnection = 64;
+
+	static FOGDataBankRPCBaselines& Get();
+
+	// A new stream id for a sending bank, never 0. Safe to call from any thread, banks allocate one when they are copied.
+	uint32 AllocateStreamId();
+
+	// Sender side. The most recent baseline of the stream the receiver has acknowledged, null if there is none.
+	const FEntries* FindAcknowledgedBaseline(const UPackageMap* Connection, const uint32 StreamId, uint16& OutId) const;
+	uint16 AddSentBaseline(UPackageMap* Connection, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache, const FEntries& Entries);
+	void Acknowledge(const UPackageMap* Connection, TConstArrayView<uint16> Ids);
+	// The receiver lost these streams' baselines, their next sends go out in full
+	void ResetSentStreams(const UPackageMap* Connection, TConstArrayView<uint32> StreamIds);
+
+	// Receiver side. Null if the baseline is no longer held, or was received for a bank with another struct cache.
+	const FEntries* FindReceivedBaseline(const UPackageMap* Connection, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache, const uint16 Id) const;
+	void AddReceivedBaseline(UPackageMap* Connection, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache, const uint16 Id, const FEntries& Entries);
+	// Drops the stream's baselines and asks the sender to send the stream in full again
+	void ResetReceivedStream(UPackageMap* Connection, const uint32 StreamId);
+
+	// Ids received and streams reset on Connection since the last call, for UOGDataBankBaselineAckComponent to send back.
+	// Only the most recent ones are kept, older ones are of no use to the sender anymore.
+	void ConsumePendingAcks(const UPackageMap* Connection, TArray<uint16>& OutIds, TArray<uint32>& OutResetStreams);
+
+	//~ FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FOGDataBankRPCBaselines"); }
+	//~ End FGCObject interface
+
+private:
+	struct FBaseline
+	{
+		uint16 Id = 0;
+		bool bAcknowledged = false;
+		FEntries Entries;
+	};
+
+	struct FStream
+	{
+		const FOGPolymorphicStructCache* StructCache = nullptr;
+		// Oldest first
+		TArray<FBaseline> Baselines;
+		uint64 LastUsed = 0;
+	};
+
+	struct FConnection
+	{
+		TWeakObjectPtr<UPackageMap> Connection;
+		// Keyed by stream id. Ids of sent streams are allocated here, those of received streams by the other end.
+		TMap<uint32, FStream> SentStreams;
+		TMap<uint32, FStream> ReceivedStreams;
+		TArray<uint16> PendingAcks;
+		TArray<uint32> PendingResets;
+		uint16 NextId = 0;
+		uint64 UseCounter = 0;
+	};
+
+	FConnection& FindOrAddConnection(UPackageMap* Connection);
+	static FStream& FindOrAddStream(FConnection& Connection, TMap<uint32, FStream>& Streams, const uint32 StreamId, const FOGPolymorphicStructCache* StructCache);
+	static void AddToRing(FStream& Stream, const uint16 Id, const FEntries& Entries);
+
+	TMap<TObjectKey<UPackageMap>, FConnection> Connections;
+	std::atomic<uint32> NextStreamId = 1;
+};
+
+/**
+ * Sends the acknowledgements for data bank RPC baselines back to the other end of the owner's connection.
+ * Add it to the PlayerController, without it banks sent by RPC never get a baseline acknowledged and always send every entry.
+ */
+UCLASS(ClassGroup=(OGCore), meta=(BlueprintSpawnableComponent))
+class OGCORE_API UOGDataBankBaselineAckComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UOGDataBankBaselineAckComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	// Acknowledgements are only an optimization, a lost one just means a later send uses an older baseline.
+	// A lost reset means the receiver resets the stream again on the next send that refers to a baseline it doesn't hold.
+	UFUNCTION(Server, Unreliable)
+	void ServerAcknowledgeBaselines(const TArray<uint16>& Ids, const TArray<uint32>& ResetStreams);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientAcknowledgeBaselines(const TArray<uint16>& Ids, const TArray<uint32>& ResetStreams);
+};
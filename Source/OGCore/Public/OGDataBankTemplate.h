@@ -0,0 +1,58 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "InstancedStruct.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGDataBankTemplate.generated.h"
+
+/**
+ * Designer authored default contents for a data bank, e.g. the context bank of a weapon or ability.
+ * Instantiating shares the template's entries with the target bank instead of copying them. The bank copies an entry
+ * the first time it writes to it, plain data entries with a memcpy and everything else through CopyScriptStruct,
+ * so entries that are only ever read never get copied at all.
+ *
+ * The shared entries are built from the authored list on first use, since entry keys are only known at runtime.
+ */
+UCLASS(BlueprintType)
+class OGCORE_API UOGDataBankTemplate : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Replaces the contents of DataBank with the template entries
+	UFUNCTION(BlueprintCallable, Category="DataBank")
+	void Instantiate(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank) const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
+	// The data bank type this template is for, entries must derive from its InnerStruct
+	UPROPERTY(EditDefaultsOnly, Category="DataBank", meta=(MetaStruct="/Script/OGCore.OGPolymorphicDataBankBase"))
+	TObjectPtr<UScriptStruct> BankType;
+
+	UPROPERTY(EditDefaultsOnly, Category="DataBank", meta=(BaseStruct="/Script/OGCore.OGPolymorphicStructBase", ExcludeBaseStruct))
+	TArray<FInstancedStruct> Entries;
+
+	// The shared entries as keyed for a bank with the given InnerStruct and struct cache, sorted by key.
+	// Safe from any thread, the entries for one kind of bank stay valid for the life of the template (outside of editor edits).
+	TConstArrayView<TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>> GetSharedEntries(const UScriptStruct* InnerStruct, const FOGPolymorphicStructCache* StructCache) const;
+
+	// The shared entry for Key or null, FOGOverlayDataBankBase reads through to its parent with this
+	const TSharedRef<FOGPolymorphicStructBase>* FindSharedEntry(const uint16 Key, const UScriptStruct* InnerStruct, const FOGPolymorphicStructCache* StructCache) const;
+
+private:
+	using FSharedEntryArray = TArray<TPair<uint16, TSharedRef<FOGPolymorphicStructBase>>>;
+	using FSharedEntriesKey = TPair<const UScriptStruct*, const FOGPolymorphicStructCache*>;
+
+	void BuildSharedEntries(const UScriptStruct* InnerStruct, const FOGPolymorphicStructCache* StructCache, FSharedEntryArray& OutEntries) const;
+
+	// Keys depend on the bank's struct cache, so the shared entries are built once per kind of bank that uses the template.
+	// Overlays hold pointers into these, building for another kind of bank must never touch the existing arrays.
+	mutable TMap<FSharedEntriesKey, FSharedEntryArray> SharedEntriesByBank;
+	mutable FCriticalSection SharedEntriesLock;
+};
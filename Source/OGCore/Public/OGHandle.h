@@ -0,0 +1,123 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGHandleBase.h"
+
+/**
+ * Lightweight handle for native code that stores large numbers of handles.
+ * Exactly the size of OGHandleIdType with no vtable, trivially copyable, so containers of handles can be memcpy'd.
+ * Tag only exists at compile time to keep handles of different kinds from mixing, any type can be used:
+ * struct FMyThingTag;
+ * using FMyThingHandle = TOGHandle<FMyThingTag>;
+ *
+ * If Tag is an FOGHandleBase subclass, both share the same id counter and convert into each other,
+ * so the USTRUCT handle can be used wherever Blueprint or reflection is needed.
+ */
+template<typename Tag>
+struct TOGHandle
+{
+	constexpr TOGHandle() = default;
+	explicit constexpr TOGHandle(const OGHandleIdType InHandle) : Handle(InHandle) {}
+
+	// Only the Tag handle itself converts, handles of other kinds (even other FOGHandleBase subclasses) don't mix
+	template<typename U UE_REQUIRES(std::is_same_v<U, Tag> && std::is_base_of_v<FOGHandleBase, U>)>
+	explicit TOGHandle(const U& InHandle) : Handle(InHandle.GetHandleId()) {}
+
+	// Safe to call from any thread
+	static TOGHandle GenerateHandle()
+	{
+		return TOGHandle(OGHandle::Private::GenerateId<Tag>());
+	}
+
+	// Reserve Num consecutive ids in a single operation and append their handles to OutHandles.
+	static void GenerateHandles(const int32 Num, TArray<TOGHandle>& OutHandles)
+	{
+		if (Num <= 0)
+			return;
+		const OGHandleIdType First = OGHandle::Private::ReserveIdRange<Tag>(Num);
+		OutHandles.Reserve(OutHandles.Num() + Num);
+		for (int32 Offset = 0; Offset < Num; ++Offset)
+		{
+			OutHandles.Emplace(First + Offset);
+		}
+	}
+
+	static constexpr TOGHandle EmptyHandle()
+	{
+		return TOGHandle();
+	}
+
+	template<typename U = Tag UE_REQUIRES(std::is_same_v<U, Tag> && std::is_base_of_v<FOGHandleBase, U>)>
+	U ToHandle() const
+	{
+		return U(Handle);
+	}
+
+	constexpr bool IsValid() const
+	{
+		return Handle != 0;
+	}
+
+	void Reset()
+	{
+		Handle = 0;
+	}
+
+	constexpr OGHandleIdType GetHandleId() const
+	{
+		return Handle;
+	}
+
+	constexpr bool operator==(const TOGHandle& Other) const
+	{
+		return Handle == Other.Handle;
+	}
+
+	constexpr bool operator!=(const TOGHandle& Other) const
+	{
+		return Handle != Other.Handle;
+	}
+
+	friend uint32 GetTypeHash(const TOGHandle& InHandle)
+	{
+		return InHandle.Handle;
+	}
+
+	friend FArchive& operator <<(FArchive& Ar, TOGHandle& InHandle)
+	{
+		Ar << InHandle.Handle;
+		return Ar;
+	}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		OGHandle::NetSerializeId(Ar, Handle);
+		bOutSuccess = true;
+		return true;
+	}
+
+	FString ToString() const
+	{
+		return IsValid() ? FString::Printf(TEXT("Handle(%u)"), Handle) : TEXT("Handle(INVALID)");
+	}
+
+private:
+	OGHandleIdType Handle = 0;
+};
+
+template<typename Tag>
+struct TIsZeroConstructType<TOGHandle<Tag>>
+{
+	enum { Value = true };
+};
+
+template<typename Tag>
+struct TCanBulkSerialize<TOGHandle<Tag>>
+{
+	enum { Value = true };
+};
+
+static_assert(sizeof(TOGHandle<FOGHandleBase>) == sizeof(OGHandleIdType), "TOGHandle must not carry anything besides the id");
+static_assert(std::is_trivially_copyable_v<TOGHandle<FOGHandleBase>>, "TOGHandle must stay trivially copyable");
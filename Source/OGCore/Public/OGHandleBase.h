@@ -1,105 +1,215 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "OGHandleBase.generated.h"
-
-typedef uint32 OGHandleIdType;
-
-/**
- * Base class for Generic Locally Unique handles
- * To use, create a subclass of FOGHandleBase and implement a default constructor and constructor with a OGHandleIdType param.
- * EX:
- * FOGHandle() : FOGHandleBase() {}
- * FOGHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
- *
- * Each subclass will have a unique internal counter.
- *
- * Note: GenerateHandle must never be called within an inline function or from multiple DLLs/modules
- */
-USTRUCT(BlueprintType)
-struct OGCORE_API FOGHandleBase
-{
-	GENERATED_BODY()
-
-public:
-
-	FOGHandleBase() {}
-	virtual ~FOGHandleBase() {}
-	FOGHandleBase(OGHandleIdType InHandle) : Handle(InHandle) {}
-	FOGHandleBase(const FOGHandleBase& Other) : Handle(Other.Handle) {}
-	FOGHandleBase(const FOGHandleBase&& Other) noexcept : Handle(Other.Handle) {}
-
-	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
-	FORCENOINLINE static T GenerateHandle()
-	{
-		static OGHandleIdType NextHandleID = 1;
-
-		//Explicitly skip 0, as 0 is reserved for invalid handle.
-		if (NextHandleID == 0) [[unlikely]]
-		{
-			++NextHandleID;
-		}
-		return T(NextHandleID++);
-	}
-
-	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
-	static const T& EmptyHandle()
-	{
-		static const T EmptyHandle;
-		return EmptyHandle;
-	}
-
-	virtual bool IsValid() const
-	{
-		return Handle != 0;
-	}
-
-	virtual void Reset()
-	{
-		Handle = 0;
-	}
-
-	void operator=(const FOGHandleBase& Other)
-	{
-		Handle = Other.Handle;
-	}
-
-	void operator=(const FOGHandleBase&& Other)
-	{
-		Handle = Other.Handle;
-	}
-
-	bool operator==(const FOGHandleBase& Other) const
-	{
-		return Handle == Other.Handle
-			&& StaticStruct() == Other.StaticStruct();
-	}
-
-	bool operator!=(const FOGHandleBase& Other) const
-	{
-		return !FOGHandleBase::operator==(Other);
-	}
-
-	friend OGHandleIdType GetTypeHash(const FOGHandleBase& InHandle)
-	{
-		return InHandle.Handle;
-	}
-
-	friend FArchive& operator <<(FArchive& Ar, FOGHandleBase& InHandle)
-	{
-		Ar << InHandle.Handle;
-		return Ar;
-	}
-
-	FString ToString() const
-	{
-		return FString::Format(TEXT("{0}({1})"),{
-			StaticStruct()->GetStructCPPName(),
-			IsValid() ? FString::FromInt(Handle) : TEXT("INVALID")});
-	}
-
-private:
-	OGHandleIdType Handle = 0;
-};
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "OGHandleBase.generated.h"
+
+typedef uint32 OGHandleIdType;
+
+class UPackageMap;
+class UScriptStruct;
+
+namespace OGHandle::Private
+{
+	struct FThreadHandleBlock
+	{
+		OGHandleIdType Next = 0;
+		OGHandleIdType End = 0;
+	};
+
+	inline constexpr OGHandleIdType HandleBlockSize = 1024;
+
+	// Lives outside FOGHandleBase, thread_local data can't be part of an exported type
+	template<typename T>
+	FORCENOINLINE FThreadHandleBlock& GetThreadHandleBlock()
+	{
+		static thread_local FThreadHandleBlock Block;
+		return Block;
+	}
+
+	// Returns the first of Num consecutive ids for T, none of which is 0.
+	template<typename T>
+	FORCENOINLINE OGHandleIdType ReserveIdRange(const OGHandleIdType Num)
+	{
+		static std::atomic<OGHandleIdType> NextHandleID = 1;
+		while (true)
+		{
+			const OGHandleIdType First = NextHandleID.fetch_add(Num, std::memory_order_relaxed);
+			//Explicitly skip any range containing 0, as 0 is reserved for invalid handle.
+			if (First != 0 && static_cast<OGHandleIdType>(First + Num - 1) >= First) [[likely]]
+				return First;
+		}
+	}
+
+	// Each thread reserves a block of ids from the shared counter and hands them out locally,
+	// so ids are unique but not ordered by creation time across threads.
+	template<typename T>
+	FORCENOINLINE OGHandleIdType GenerateId()
+	{
+		FThreadHandleBlock& Block = GetThreadHandleBlock<T>();
+		if (Block.Next == Block.End) [[unlikely]]
+		{
+			Block.Next = ReserveIdRange<T>(HandleBlockSize);
+			Block.End = Block.Next + HandleBlockSize;
+		}
+		return Block.Next++;
+	}
+}
+
+namespace OGHandle
+{
+	// Writes a fixed 6 bit length followed by only the significant bits of Id, so small ids cost the prefix and a few bits instead of 32
+	OGCORE_API void NetSerializeId(FArchive& Ar, OGHandleIdType& Id);
+
+	// As NetSerializeId, translating through the FOGHandleNetIdMap registered for HandleType on the client, if there is one
+	OGCORE_API void NetSerializeMappedId(FArchive& Ar, UPackageMap* Map, const UScriptStruct* HandleType, OGHandleIdType& Id);
+}
+
+/**
+ * Base class for Generic Locally Unique handles
+ * To use, create a subclass of FOGHandleBase and implement a default constructor and constructor with a OGHandleIdType param.
+ * EX:
+ * FOGHandle() : FOGHandleBase() {}
+ * FOGHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+ *
+ * Each subclass will have a unique internal counter. Handles can be generated from any thread.
+ *
+ * Handles replicate with a variable length encoding. To get it in a subclass, give it the type traits of the base:
+ * template<> struct TStructOpsTypeTraits<FOGHandle> : public TOGHandleStructOpsTypeTraits<FOGHandle> {};
+ * Since handles are only locally unique, server and client ids don't correspond. If clients create handles of their own
+ * for replicated objects, also shadow NetSerialize in the subclass to go through the FOGHandleNetIdMap:
+ * bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) { return NetSerializeMapped(*this, Ar, Map, bOutSuccess); }
+ *
+ * Note: GenerateHandle must never be called within an inline function or from multiple DLLs/modules
+ */
+USTRUCT(BlueprintType)
+struct OGCORE_API FOGHandleBase
+{
+	GENERATED_BODY()
+
+public:
+
+	FOGHandleBase() {}
+	virtual ~FOGHandleBase() {}
+	FOGHandleBase(OGHandleIdType InHandle) : Handle(InHandle) {}
+	FOGHandleBase(const FOGHandleBase& Other) : Handle(Other.Handle) {}
+	FOGHandleBase(const FOGHandleBase&& Other) noexcept : Handle(Other.Handle) {}
+
+	// Safe to call from any thread, see OGHandle::Private::GenerateId
+	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
+	FORCENOINLINE static T GenerateHandle()
+	{
+		return T(OGHandle::Private::GenerateId<T>());
+	}
+
+	// Reserve Num consecutive ids in a single operation and append their handles to OutHandles.
+	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
+	static void GenerateHandles(const int32 Num, TArray<T>& OutHandles)
+	{
+		if (Num <= 0)
+			return;
+		const OGHandleIdType First = OGHandle::Private::ReserveIdRange<T>(Num);
+		OutHandles.Reserve(OutHandles.Num() + Num);
+		for (int32 Offset = 0; Offset < Num; ++Offset)
+		{
+			OutHandles.Emplace(First + Offset);
+		}
+	}
+
+	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
+	static const T& EmptyHandle()
+	{
+		static const T EmptyHandle;
+		return EmptyHandle;
+	}
+
+	virtual bool IsValid() const
+	{
+		return Handle != 0;
+	}
+
+	virtual void Reset()
+	{
+		Handle = 0;
+	}
+
+	void operator=(const FOGHandleBase& Other)
+	{
+		Handle = Other.Handle;
+	}
+
+	void operator=(const FOGHandleBase&& Other)
+	{
+		Handle = Other.Handle;
+	}
+
+	bool operator==(const FOGHandleBase& Other) const
+	{
+		return Handle == Other.Handle;
+	}
+
+	bool operator!=(const FOGHandleBase& Other) const
+	{
+		return !FOGHandleBase::operator==(Other);
+	}
+
+	friend OGHandleIdType GetTypeHash(const FOGHandleBase& InHandle)
+	{
+		return InHandle.Handle;
+	}
+
+	friend FArchive& operator <<(FArchive& Ar, FOGHandleBase& InHandle)
+	{
+		Ar << InHandle.Handle;
+		return Ar;
+	}
+
+	FString ToString() const
+	{
+		return FString::Format(TEXT("{0}({1})"),{
+			StaticStruct()->GetStructCPPName(),
+			IsValid() ? FString::FromInt(Handle) : TEXT("INVALID")});
+	}
+
+	OGHandleIdType GetHandleId() const
+	{
+		return Handle;
+	}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		OGHandle::NetSerializeId(Ar, Handle);
+		bOutSuccess = true;
+		return true;
+	}
+
+	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
+	static bool NetSerializeMapped(T& InHandle, FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		OGHandle::NetSerializeMappedId(Ar, Map, T::StaticStruct(), InHandle.Handle);
+		bOutSuccess = true;
+		return true;
+	}
+
+private:
+	OGHandleIdType Handle = 0;
+};
+
+template<typename T>
+struct TOGHandleStructOpsTypeTraits : public TStructOpsTypeTraitsBase2<T>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		// The server never translates ids, so what it writes is the same for every connection
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGHandleBase> : public TOGHandleStructOpsTypeTraits<FOGHandleBase>
+{
+};
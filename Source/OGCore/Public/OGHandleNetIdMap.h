@@ -0,0 +1,46 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGHandleBase.h"
+#include "UObject/ObjectKey.h"
+
+class UNetDriver;
+
+/**
+ * Client side translation between server handle ids and the client's own handles of one handle type.
+ * Handles are only locally unique, so when both sides generate handles for the same logical object the client registers
+ * the pair here and handles replicated through FOGHandleBase::NetSerializeMapped arrive as the client's local handle.
+ * Handles the client sends to the server are translated back.
+ *
+ * Maps live per net driver, so listen servers and multiple PIE clients in one process don't share them.
+ * The server never has a map and always writes its ids unchanged. On a client with a map, ids that have not been
+ * registered resolve to the invalid handle rather than to an unrelated local handle with the same id.
+ */
+class OGCORE_API FOGHandleNetIdMap
+{
+public:
+	template<typename T UE_REQUIRES(std::is_base_of_v<FOGHandleBase, T>)>
+	static FOGHandleNetIdMap& FindOrAdd(const UObject* WorldContextObject)
+	{
+		return FindOrAdd(T::StaticStruct(), WorldContextObject);
+	}
+
+	static FOGHandleNetIdMap& FindOrAdd(const UScriptStruct* HandleType, const UObject* WorldContextObject);
+	static const FOGHandleNetIdMap* Find(const UScriptStruct* HandleType, const UNetDriver* NetDriver);
+
+	void Register(const OGHandleIdType ServerId, const OGHandleIdType LocalId);
+	void UnregisterLocal(const OGHandleIdType LocalId);
+	void Empty();
+
+	// Both return 0 (the invalid id) for ids that were never registered
+	OGHandleIdType ServerToLocal(const OGHandleIdType ServerId) const;
+	OGHandleIdType LocalToServer(const OGHandleIdType LocalId) const;
+
+private:
+	TMap<OGHandleIdType, OGHandleIdType> ServerToLocalMap;
+	TMap<OGHandleIdType, OGHandleIdType> LocalToServerMap;
+
+	static TMap<TPair<FObjectKey, FObjectKey>, FOGHandleNetIdMap>& GetMaps();
+};
@@ -0,0 +1,190 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGPolymorphicDataBank.h"
+#include "Misc/NetworkGuid.h"
+#include "OGOverlayDataBank.generated.h"
+
+class UOGDataBankTemplate;
+
+/**
+ * A data bank that reads through to a shared, immutable parent and only stores what it overrides.
+ * Meant for the case where many actors start from the same UOGDataBankTemplate and change only a few entries each,
+ * memory per instance then scales with the number of overrides rather than the size of the template.
+ *
+ * Lookups check the local overrides first and fall through to the parent. Mutable access to an entry that only exists in
+ * the parent copies it into an override first. Removing an entry the parent has leaves a tombstone so the merged view
+ * stops showing it, RevertToParent drops both the override and the tombstone.
+ * Contains, Num and ForEachConst all work on the merged view.
+ * Reading through to the parent is safe from any thread, entries read from the parent stay valid as long as the parent does.
+ *
+ * Replication sends the parent as an object reference plus the tombstones and the overrides, parent entries are never sent.
+ * The parent asset must be loadable on clients. An overlay that arrives before its parent can be resolved reads through to
+ * nothing until the parent is mapped, like entries waiting on their object references.
+ *
+ * Use it like the data bank: extend it, implement GetInnerStruct (and optionally GetStructCache), and apply the
+ * WithAddStructReferencedObjects and WithNetDeltaSerializer / WithNetSerializer type traits.
+ */
+USTRUCT(BlueprintType)
+struct OGCORE_API FOGOverlayDataBankBase
+{
+	GENERATED_BODY()
+
+	FOGOverlayDataBankBase() {}
+	virtual ~FOGOverlayDataBankBase() {}
+
+	// Keeps the overrides, entries that were only read through are not copied
+	void SetParent(const UOGDataBankTemplate* NewParent);
+	const UOGDataBankTemplate* GetParent() const { return Parent; }
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	bool Contains() const
+	{
+		return Contains_Internal(GetKey(Derived::StaticStruct()));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	bool IsOverridden() const
+	{
+		return GetOverrides().DataMap.Contains(GetKey(Derived::StaticStruct()));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived* FindConst() const
+	{
+		return static_cast<const Derived*>(FindConst_Internal(GetKey(Derived::StaticStruct())));
+	}
+
+	// Mutable access creates an override if the entry is only in the parent, and marks it dirty
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived* Find()
+	{
+		return static_cast<Derived*>(Find_Internal(GetKey(Derived::StaticStruct())));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void SetByCopy(const Derived& Source)
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		FOGPolymorphicStructBase& Override = FindOrAddOverride_Internal(GetKey(Struct), Struct);
+		static_cast<Derived&>(Override) = Source;
+		GetOverrides().MarkDirty(Override);
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void Remove()
+	{
+		Remove_Internal(GetKey(Derived::StaticStruct()));
+	}
+
+	// Drop the local override or tombstone, the parent's entry (if any) shows through again
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void RevertToParent()
+	{
+		RevertToParent_Internal(GetKey(Derived::StaticStruct()));
+	}
+
+	// Call Func on every entry of the merged view deriving from TBase, in key order
+	template <typename TBase, typename FuncType UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, TBase>)>
+	void ForEachConst(FuncType&& Func) const
+	{
+		TArray<uint16, TInlineAllocator<16>> Keys;
+		GatherKeys(GetStructCache()->GetSubtreeRange(GetKey(TBase::StaticStruct())), Keys);
+		for (const uint16 Key : Keys)
+		{
+			Func(static_cast<const TBase&>(*FindConst_Internal(Key)));
+		}
+	}
+
+	// Number of entries in the merged view
+	int32 Num() const;
+	int32 NumOverrides() const { return GetOverrides().DataMap.Num(); }
+
+	// Clears the overrides and tombstones, the bank shows exactly its parent afterwards
+	void Empty();
+
+	// Heap memory used by the overrides and tombstones, see FOGPolymorphicDataBankBase::GetAllocatedSize.
+	// Entries only read through to the parent belong to the parent template and are not counted.
+	SIZE_T GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType = nullptr, TSet<const void*>* InOutCountedEntries = nullptr) const;
+
+	void AddStructReferencedObjects(class FReferenceCollector& Collector);
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+private:
+	virtual UScriptStruct* GetInnerStruct() const PURE_VIRTUAL(FOGOverlayDataBankBase::GetInnerStruct, return nullptr;);
+	// Same as FOGPolymorphicDataBankBase::GetStructCache
+	virtual FOGPolymorphicStructCache* GetStructCache() const;
+
+	/**
+	 * The overrides are a regular data bank, so they get its copy on write, persistence and delta replication.
+	 * It can't call back into the overlay (the overlay may be relocated in memory), so it keeps its own copy of
+	 * the overlay's InnerStruct and struct cache, filled in on first mutable use.
+	 */
+	struct FOverrideBank final : public FOGPolymorphicDataBankBase
+	{
+		FOverrideBank() {}
+		FOverrideBank(const FOverrideBank& Other) : InnerStruct(Other.InnerStruct), StructCache(Other.StructCache) { FOGPolymorphicDataBankBase::operator=(Other); }
+		FOverrideBank& operator=(const FOverrideBank& Other)
+		{
+			InnerStruct = Other.InnerStruct;
+			StructCache = Other.StructCache;
+			FOGPolymorphicDataBankBase::operator=(Other);
+			return *this;
+		}
+
+		virtual UScriptStruct* GetInnerStruct() const override { return InnerStruct; }
+		virtual FOGPolymorphicStructCache* GetStructCache() const override { return StructCache; }
+
+		UScriptStruct* InnerStruct = nullptr;
+		FOGPolymorphicStructCache* StructCache = nullptr;
+	};
+
+	FOverrideBank& GetOverrides()
+	{
+		if (!Overrides.InnerStruct) [[unlikely]]
+		{
+			Overrides.InnerStruct = GetInnerStruct();
+			Overrides.StructCache = GetStructCache();
+		}
+		return Overrides;
+	}
+
+	// Entries only get into the overrides through mutable access, so until that filled in the type info they are empty
+	// and const reads don't need it. Const reads never write, which keeps reading through to the parent thread safe.
+	const FOverrideBank& GetOverrides() const
+	{
+		return Overrides;
+	}
+
+	FORCEINLINE uint16 GetKey(const UScriptStruct* ScriptStruct) const
+	{
+		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(GetInnerStruct()), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
+			return 0;
+		return GetStructCache()->GetIndexForType(ScriptStruct);
+	}
+
+	const TSharedRef<FOGPolymorphicStructBase>* FindParentEntry(const uint16 Key) const;
+	bool Contains_Internal(const uint16 Key) const;
+	const FOGPolymorphicStructBase* FindConst_Internal(const uint16 Key) const;
+	FOGPolymorphicStructBase* Find_Internal(const uint16 Key);
+	FOGPolymorphicStructBase& FindOrAddOverride_Internal(const uint16 Key, const UScriptStruct* ScriptStruct);
+	void Remove_Internal(const uint16 Key);
+	void RevertToParent_Internal(const uint16 Key);
+	void GatherKeys(const TPair<uint16, uint16>& Range, TArray<uint16, TInlineAllocator<16>>& OutKeys) const;
+	void SerializeParentAndTombstones(FArchive& Ar, UPackageMap* Map);
+	void UpdateUnmappedParent(FNetDeltaSerializeInfo& DeltaParams);
+
+	UPROPERTY()
+	TObjectPtr<const UOGDataBankTemplate> Parent;
+
+	FOverrideBank Overrides;
+
+	/** Keys the parent has that were removed locally */
+	TSet<uint16> Tombstones;
+
+	/** Guid of a received parent that couldn't be resolved yet, invalid otherwise */
+	FNetworkGUID UnmappedParentGUID;
+};
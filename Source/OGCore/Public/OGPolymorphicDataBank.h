@@ -1,304 +1,688 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UObject/Object.h"
-#include "OGPolymorphicDataBank.generated.h"
-
-struct OGCORE_API FOGPolymorphicStructCache
-{
-	void InitTypeCache(const UScriptStruct* PolymorphicGroupType)
-	{
-		if (!CachedStructTypes.IsEmpty()) [[likely]]
-			return;
-		
-		// Find all script structs of this type and add them to the list
-		// (not sure of a better way to do this but it should only happen once at startup)
-		for (TObjectIterator<UScriptStruct> It; It; ++It)
-		{
-			if (It->IsChildOf(PolymorphicGroupType))
-			{
-				CachedStructTypes.Add(TWeakObjectPtr<UScriptStruct>(*It));
-			}
-		}
-	
-		CachedStructTypes.Sort([](const TWeakObjectPtr<UScriptStruct>& A, const TWeakObjectPtr<UScriptStruct>& B) { return A->GetName().ToLower() > B->GetName().ToLower(); });
-	}
-	
-	uint16 GetIndexForType(const UScriptStruct* Type) const
-	{
-		const int Index = Algo::BinarySearchBy(CachedStructTypes, Type->GetName().ToLower(),
-			[](const TWeakObjectPtr<UScriptStruct>& A){return A->GetName().ToLower();},
-			[](const FString& Rhs, const FString& Lhs){return Rhs > Lhs;});
-		ensureAlways(Index != INDEX_NONE);
-		return Index;
-	}
-	
-	UScriptStruct* GetTypeForIndex(const uint16& Index) const
-	{
-		ensureAlways(CachedStructTypes.Num() > Index);
-		return CachedStructTypes[Index].Get();
-	}
-
-private:
-	TArray<TWeakObjectPtr<UScriptStruct>> CachedStructTypes;
-};
-
-/** Custom INetDeltaBaseState used by DataBank Serialization */
-class FOGPolymorphicDataBankDeltaState : public INetDeltaBaseState
-{
-public:
-
-	FOGPolymorphicDataBankDeltaState()
-	: ContainerReplicationKey(INDEX_NONE)
-	{}
-
-	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
-	{
-		FOGPolymorphicDataBankDeltaState * Other = static_cast<FOGPolymorphicDataBankDeltaState*>(OtherState);
-		for (auto It = IDToRepKeyMap.CreateIterator(); It; ++It)
-		{
-			const auto Ptr = Other->IDToRepKeyMap.Find(It.Key());
-			if (!Ptr || *Ptr != It.Value())
-			{
-				return false;
-			}
-		}
-		return true;
-	}
-
-	virtual void CountBytes(FArchive& Ar) const override
-	{
-		IDToRepKeyMap.CountBytes(Ar);
-	}
-
-	/** Maps an element's StructId to ReplicationKey. */
-	TMap<uint16, uint16> IDToRepKeyMap;
-
-	uint16 ContainerReplicationKey;
-};
-
-/** Struct for holding guid references */
-struct FOGPolymorphicDataBankSerializerGuidReferences
-{
-	/** List of guids that were unmapped so we can quickly check */
-	TSet<FNetworkGUID> UnmappedGUIDs;
-
-	/** List of guids that were mapped so we can move them to unmapped when necessary (i.e. actor channel closes) */
-	TSet<FNetworkGUID> MappedDynamicGUIDs;
-
-	/** Buffer of data to re-serialize when the guids are mapped */
-	TArray<uint8> Buffer;
-
-	/** Number of bits in the buffer */
-	int32 NumBufferBits;
-};
-
-/**
- * Base type for structs that will be put into polymorphic data structures
- * Create a new struct that goes into the data structure
- */
-USTRUCT(NotBlueprintType)
-struct OGCORE_API FOGPolymorphicStructBase
-{
-	friend struct FOGPolymorphicDataBankBase;
-	GENERATED_BODY()
-
-	void SetReplicationKey(const uint16 NewKey)
-	{
-		ReplicationKey = NewKey;
-	}
-	
-protected:
-	UPROPERTY(NotReplicated)
-	uint16 ReplicationKey = 0;
-};
-
-/**
- * Base type for a collection of polymorphic structs stored in a map using the struct type itself as a key
- * This is intended primarily as a way to give projects an easy method to add a layer of game specific parameters
- * to the internal structs created for general purpose plugins.
- * For example, a TriggerContext struct containing information about a gameplay event could be provided different structs
- * based on the type of event.
- * The tradeoff for being able to access the data by struct type is that there can only ever be one instance
- * of each struct can be in the collection.
- *
- * Use:
- * Create a new struct, e.g. MyDataBank, that extends this one, and one that extends FOGPolymorphicStructBase, e.g. MyDataStructBase
- * Create additional structs extending MyDataStructBase - these are the specific data structures MyDataBank will be able to hold
- * The structs that derive from MyDataStructBase must EACH use the BlueprintType USTRUCT trait. If they don't each have it, they won't
- * have Make and Break blueprint nodes, which are necessary for using a DataBank in blueprint.
- *
- * Your implementation of MyDataBank must implement these two methods
- * GetInnerStruct must return the UScriptStruct of the root type of the structs this will hold.
- * Optionally implement GetStructCache to return a single FOGPolymorphicStructCache that is maintained by the module for this class.
- *	The default implementation of GetStructCache returns a universal StructCache that maps every struct which derives from FOGPolymorphicStructBase
- *
- * In order for garbage collection to work properly with structs inside the data bank (i.e. respect object pointers in UPROPERTY in stored structs)
- * MyDataBank must use the WithAddStructReferencedObjects type trait.
- *
- * If MyDataBank is going to replicate, you must apply the type trait WithNetSerializer or WithNetDeltaSerializer (Or both)
- * The actual implementations for delta and non-delta serialization are already done, you only need the trait to inform the engine.
- * If the data bank is going to be replicated via RPC, you must use WithNetSerializer - RPCs will never use delta serialization
- * If the data bank is going to replicate by value, either trait will work but WithNetDeltaSerializer is generally preferred
- * it reduces bandwidth and has better handling for object references that cannot be resolved by the client at the time of replication.
- *
- * You may apply both type traits, it will just trigger an engine warning if you do so. As far as I can tell it will correctly
- * use delta serialization for value replication and non-delta serialization RPCs without any issues, but the warning itself can interfere
- * with automated tests.
- *
- * Iris replication is not yet supported
- */
-USTRUCT(BlueprintType)
-struct OGCORE_API FOGPolymorphicDataBankBase
-{
-	GENERATED_BODY()
-
-	friend class UOGPolymorphicDataFunctionLibrary;
-	
-	FOGPolymorphicDataBankBase() {}
-	virtual ~FOGPolymorphicDataBankBase() {}
-
-	//Deep copy the data bank
-	FOGPolymorphicDataBankBase(const FOGPolymorphicDataBankBase& Other);
-	FOGPolymorphicDataBankBase& operator=(const FOGPolymorphicDataBankBase& Other);
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	bool Contains() const
-	{
-		const uint16 Key = GetKey(Derived::StaticStruct());
-		return DataMap.Contains(Key);
-	}
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	Derived& AddUnique()
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		return static_cast<Derived&>(AddUnique_Internal(GetKey(Struct),Struct));
-	}
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	void Remove()
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Struct);
-		Remove_Internal(Key, Struct);
-	}
-	
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	void SetByCopy(const Derived& Source)
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Derived::StaticStruct());
-		Derived* Existing = static_cast<Derived*>(Get_Internal(Key));
-		if (!Existing)
-		{
-			Existing = static_cast<Derived*>(&AddUnique_Internal(Key, Struct));
-		}
-		*Existing = Source;
-		//Override replication key in source
-		MarkDirty(*Existing);
-#if WITH_EDITOR
-		AvailableDataTypes.Add(Derived::StaticStruct()->GetStructCPPName());
-#endif
-	}
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	Derived& GetSafe()
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Struct);
-		if (Derived* Existing = static_cast<Derived*>(Get_Internal(Key)))
-		{
-			return *Existing;
-		}
-		return static_cast<Derived&>(AddUnique_Internal(Key, Struct));
-	}
-	
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	const Derived& GetConstChecked() const
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Struct);
-		const Derived* Existing = static_cast<const Derived*>(GetConst_Internal(Key));
-		if (!ensureAlwaysMsgf(Existing, TEXT("Tried getting a ref for a type that's not in the bank"))) [[unlikely]]
-			return static_cast<Derived&>(const_cast<FOGPolymorphicDataBankBase*>(this)->AddUnique_Internal(Key, Struct));
-		return *Existing;
-	}
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	Derived& GetChecked()
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Struct);
-		Derived* Existing = static_cast<Derived*>(Get_Internal(Key));
-		if (!ensureAlwaysMsgf(Existing, TEXT("Tried getting a ref for a type that's not in the bank"))) [[unlikely]]
-			return static_cast<Derived&>(AddUnique_Internal(Key, Struct));
-		Derived& ExistingRef = *Existing;
-		return ExistingRef;
-	}
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	const Derived* FindConst() const
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Struct);
-		return static_cast<const Derived*>(GetConst_Internal(Key));
-	}
-
-	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
-	Derived* Find()
-	{
-		const UScriptStruct* Struct = Derived::StaticStruct();
-		const uint16 Key = GetKey(Struct);
-		return static_cast<Derived*>(Get_Internal(Key));
-	}
-
-	void Empty();
-
-	void AddStructReferencedObjects(class FReferenceCollector& Collector);
-	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool&bOutSuccess);
-	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
-
-private:
-
-	virtual UScriptStruct* GetInnerStruct() const PURE_VIRTUAL(FOGPolymorphicDataBankBase::GetInnerStruct, return nullptr;);
-	// Get the specific cache that translates a UScriptStruct to index and back.
-	// default implementation gives a cache that covers every struct type that inherits from FOGPolymorphicStructBase.
-	// Provide your own cache to improve lookup performance.
-	virtual FOGPolymorphicStructCache* GetStructCache() const;
-	
-	FORCEINLINE uint16 GetKey(const UScriptStruct* ScriptStruct) const
-	{
-		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(GetInnerStruct()), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
-			return 0;
-		return GetStructCache()->GetIndexForType(ScriptStruct);
-	}
-
-	FORCEINLINE void MarkDirty(FOGPolymorphicStructBase& Entry)
-	{
-		Entry.SetReplicationKey(++LastReplicationKey);
-	}
-	
-	FOGPolymorphicStructBase* Get_Internal(const uint16& Key);
-
-	const FOGPolymorphicStructBase* GetConst_Internal(const uint16& Key) const;
-	
-	FOGPolymorphicStructBase& AddUnique_Internal(const uint16& Key, const UScriptStruct* ScriptStruct);
-	
-	void Remove_Internal(const uint16& Key, const UScriptStruct* ScriptStruct = nullptr);
-	TMap<uint16, TSharedRef<FOGPolymorphicStructBase>> DataMap;
-
-	/** List of items that need to be re-serialized when the referenced objects are mapped */
-	TMap<uint16, FOGPolymorphicDataBankSerializerGuidReferences> GuidReferencesMap;
-	
-	UPROPERTY()
-	uint16 LastReplicationKey = 0;
-
-#if WITH_EDITORONLY_DATA
-	//This set is maintained in editor to make it easy to tell what structs are currently in the data bank
-	UPROPERTY(Transient, NotReplicated)
-	TSet<FString> AvailableDataTypes;
-#endif
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGCoreStats.h"
+#include "OGDataBankChangeListeners.h"
+#include "OGDataBankMemory.h"
+#include "Async/Mutex.h"
+#include "UObject/Object.h"
+#include "OGPolymorphicDataBank.generated.h"
+
+struct OGCORE_API FOGPolymorphicStructCache
+{
+	// Types deriving from any of ExcludedGroupTypes are left out, they belong to a bank that maintains its own cache
+	void InitTypeCache(const UScriptStruct* PolymorphicGroupType, TConstArrayView<const UScriptStruct*> ExcludedGroupTypes = {})
+	{
+		if (!CachedStructTypes.IsEmpty()) [[likely]]
+			return;
+		TRACE_CPUPROFILER_EVENT_SCOPE(FOGPolymorphicStructCache::InitTypeCache);
+		LLM_SCOPE_BYTAG(OGCore);
+		
+		// Find all script structs of this type and add them to the list
+		// (not sure of a better way to do this but it should only happen once at startup)
+		TMap<const UStruct*, TArray<UScriptStruct*>> ChildTypes;
+		for (TObjectIterator<UScriptStruct> It; It; ++It)
+		{
+			if (It->IsChildOf(PolymorphicGroupType) && *It != PolymorphicGroupType
+				&& !ExcludedGroupTypes.ContainsByPredicate([&It](const UScriptStruct* Excluded) { return It->IsChildOf(Excluded); }))
+			{
+				ChildTypes.FindOrAdd(It->GetSuperStruct()).Add(*It);
+			}
+		}
+		for (auto& [Parent, Children] : ChildTypes)
+		{
+			Children.Sort([](const UScriptStruct& A, const UScriptStruct& B) { return A.GetName().ToLower() < B.GetName().ToLower(); });
+		}
+
+		// Keys are assigned depth first, so every type and everything deriving from it form one contiguous key range
+		TArray<TPair<UScriptStruct*, int32>> Stack;
+		Stack.Emplace(const_cast<UScriptStruct*>(PolymorphicGroupType), INDEX_NONE);
+		while (!Stack.IsEmpty())
+		{
+			const TPair<UScriptStruct*, int32> Next = Stack.Pop(EAllowShrinking::No);
+			if (Next.Value != INDEX_NONE)
+			{
+				// Every descendant of this type has been visited, its subtree ends here
+				SubtreeEnds[Next.Value] = CachedStructTypes.Num();
+				continue;
+			}
+			const int32 Index = CachedStructTypes.Add(TWeakObjectPtr<UScriptStruct>(Next.Key));
+			SubtreeEnds.Add(INDEX_NONE);
+			Stack.Emplace(Next.Key, Index);
+			if (const TArray<UScriptStruct*>* Children = ChildTypes.Find(Next.Key))
+			{
+				for (int32 ChildIdx = Children->Num() - 1; ChildIdx >= 0; --ChildIdx)
+				{
+					Stack.Emplace((*Children)[ChildIdx], INDEX_NONE);
+				}
+			}
+		}
+
+		// Resolving a type is a pointer lookup, the sorted list only determines which index each type gets
+		TypeToIndex.Reserve(CachedStructTypes.Num());
+		PathToType.Reserve(CachedStructTypes.Num());
+		LayoutHashes.Reserve(CachedStructTypes.Num());
+		PlainDataTypes.Init(false, CachedStructTypes.Num());
+		for (int32 Index = 0; Index < CachedStructTypes.Num(); ++Index)
+		{
+			UScriptStruct* Type = CachedStructTypes[Index].Get();
+			TypeToIndex.Add(Type, Index);
+			PathToType.Add(FTopLevelAssetPath(Type), Type);
+			LayoutHashes.Add(ComputeLayoutHash(Type));
+			PlainDataTypes[Index] = IsPlainData(Type);
+		}
+	}
+	
+	uint16 GetIndexForType(const UScriptStruct* Type) const
+	{
+		const uint16* Index = TypeToIndex.Find(Type);
+		if (!ensureAlways(Index)) [[unlikely]]
+			return static_cast<uint16>(INDEX_NONE);
+		return *Index;
+	}
+	
+	UScriptStruct* GetTypeForIndex(const uint16& Index) const
+	{
+		ensureAlways(CachedStructTypes.Num() > Index);
+		return CachedStructTypes[Index].Get();
+	}
+
+	int32 GetNumTypes() const
+	{
+		return CachedStructTypes.Num();
+	}
+
+	// Keys of Index and every type deriving from it, as the half open range [Begin, End)
+	TPair<uint16, uint16> GetSubtreeRange(const uint16& Index) const
+	{
+		return TPair<uint16, uint16>(Index, SubtreeEnds[Index]);
+	}
+
+	// Stable identity of a type across builds, unlike the index
+	UScriptStruct* FindTypeByPath(const FTopLevelAssetPath& Path) const
+	{
+		UScriptStruct* const* Type = PathToType.Find(Path);
+		return Type ? *Type : nullptr;
+	}
+
+	// Changes whenever the memory layout of the type changes, used to version persisted entries
+	uint32 GetLayoutHash(const uint16& Index) const
+	{
+		return LayoutHashes[Index];
+	}
+
+	// Whether entries of this type can be copied as raw memory and persisted without property tags, see IsPlainData(const UScriptStruct*)
+	bool IsPlainData(const uint16& Index) const
+	{
+		return PlainDataTypes[Index];
+	}
+
+	static uint32 ComputeLayoutHash(const UScriptStruct* Type);
+
+	// True for types that only hold numbers, bools, enums and structs of those, and have no native destructor.
+	static bool IsPlainData(const UScriptStruct* Type);
+
+	// Hash and comparison of an entry's reflected members. FOGPolymorphicStructBase's own members (the replication key) are ignored.
+	static uint32 HashEntry(const UScriptStruct* Type, const void* Entry);
+	static bool AreEntriesIdentical(const UScriptStruct* Type, const void* A, const void* B);
+
+	// Heap memory owned by the entry's members: strings, arrays, maps and sets, recursing into nested structs
+	static SIZE_T GetEntryHeapSize(const UScriptStruct* Type, const void* Entry);
+
+private:
+	TArray<TWeakObjectPtr<UScriptStruct>> CachedStructTypes;
+	TMap<const UScriptStruct*, uint16> TypeToIndex;
+	TArray<uint16> SubtreeEnds;
+	TMap<FTopLevelAssetPath, UScriptStruct*> PathToType;
+	TArray<uint32> LayoutHashes;
+	TBitArray<> PlainDataTypes;
+};
+
+/** Custom INetDeltaBaseState used by DataBank Serialization */
+class FOGPolymorphicDataBankDeltaState : public FOGDataBankDeltaStateBase
+{
+public:
+
+	FOGPolymorphicDataBankDeltaState()
+	: ContainerReplicationKey(INDEX_NONE)
+	{}
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		FOGPolymorphicDataBankDeltaState * Other = static_cast<FOGPolymorphicDataBankDeltaState*>(OtherState);
+		for (auto It = IDToRepKeyMap.CreateIterator(); It; ++It)
+		{
+			const auto Ptr = Other->IDToRepKeyMap.Find(It.Key());
+			if (!Ptr || *Ptr != It.Value())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	virtual void CountBytes(FArchive& Ar) const override
+	{
+		//The engine doesn't count the state object itself
+		Ar.CountBytes(sizeof(*this), sizeof(*this));
+		IDToRepKeyMap.CountBytes(Ar);
+	}
+
+	/** Maps an element's StructId to ReplicationKey. */
+	TMap<uint16, uint16> IDToRepKeyMap;
+
+	uint16 ContainerReplicationKey;
+};
+
+/** Struct for holding guid references */
+struct FOGPolymorphicDataBankSerializerGuidReferences
+{
+	/** List of guids that were unmapped so we can quickly check */
+	TSet<FNetworkGUID> UnmappedGUIDs;
+
+	/** List of guids that were mapped so we can move them to unmapped when necessary (i.e. actor channel closes) */
+	TSet<FNetworkGUID> MappedDynamicGUIDs;
+
+	/** Buffer of data to re-serialize when the guids are mapped */
+	TArray<uint8> Buffer;
+
+	/** Number of bits in the buffer */
+	int32 NumBufferBits;
+};
+
+/**
+ * Base type for structs that will be put into polymorphic data structures
+ * Create a new struct that goes into the data structure
+ */
+USTRUCT(NotBlueprintType)
+struct OGCORE_API FOGPolymorphicStructBase
+{
+	friend struct FOGPolymorphicDataBankBase;
+	GENERATED_BODY()
+
+	void SetReplicationKey(const uint16 NewKey)
+	{
+		ReplicationKey = NewKey;
+	}
+	
+protected:
+	UPROPERTY(NotReplicated)
+	uint16 ReplicationKey = 0;
+};
+
+/**
+ * Immutable view of a data bank at the moment MakeSnapshot was called.
+ * Snapshots share the entry allocations with the bank, so taking one only copies the key map. The bank copies an entry
+ * before it next writes to it, a snapshot never observes later changes and is safe to read from any thread without locks.
+ *
+ * Version is the bank's version when the snapshot was taken. Any mutable access, addition or removal on the bank bumps it,
+ * so a snapshot whose version differs from FOGPolymorphicDataBankBase::GetVersion may be stale.
+ *
+ * Object references inside a snapshot are not reported to garbage collection. Take a fresh snapshot each frame
+ * rather than keeping one alive across frames.
+ */
+struct OGCORE_API FOGPolymorphicDataBankSnapshot
+{
+	friend struct FOGPolymorphicDataBankBase;
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	bool Contains() const
+	{
+		return Entries.Contains(GetKey(Derived::StaticStruct()));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived* Find() const
+	{
+		const TSharedRef<FOGPolymorphicStructBase>* Existing = Entries.Find(GetKey(Derived::StaticStruct()));
+		if (!Existing)
+			return nullptr;
+		return static_cast<const Derived*>(&Existing->Get());
+	}
+
+	uint32 GetVersion() const { return Version; }
+	int32 Num() const { return Entries.Num(); }
+	bool IsStale(const struct FOGPolymorphicDataBankBase& Bank) const;
+
+private:
+	FORCEINLINE uint16 GetKey(const UScriptStruct* ScriptStruct) const
+	{
+		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(InnerStruct), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
+			return 0;
+		return StructCache->GetIndexForType(ScriptStruct);
+	}
+
+	const FOGPolymorphicStructCache* StructCache = nullptr;
+	const UScriptStruct* InnerStruct = nullptr;
+	TMap<uint16, TSharedRef<FOGPolymorphicStructBase>> Entries;
+	uint32 Version = 0;
+};
+
+/**
+ * Base type for a collection of polymorphic structs stored in a map using the struct type itself as a key
+ * This is intended primarily as a way to give projects an easy method to add a layer of game specific parameters
+ * to the internal structs created for general purpose plugins.
+ * For example, a TriggerContext struct containing information about a gameplay event could be provided different structs
+ * based on the type of event.
+ * The tradeoff for being able to access the data by struct type is that there can only ever be one instance
+ * of each struct can be in the collection.
+ *
+ * Use:
+ * Create a new struct, e.g. MyDataBank, that extends this one, and one that extends FOGPolymorphicStructBase, e.g. MyDataStructBase
+ * Create additional structs extending MyDataStructBase - these are the specific data structures MyDataBank will be able to hold
+ * The structs that derive from MyDataStructBase must EACH use the BlueprintType USTRUCT trait. If they don't each have it, they won't
+ * have Make and Break blueprint nodes, which are necessary for using a DataBank in blueprint.
+ *
+ * Your implementation of MyDataBank must implement these two methods
+ * GetInnerStruct must return the UScriptStruct of the root type of the structs this will hold.
+ * Optionally implement GetStructCache to return a single FOGPolymorphicStructCache that is maintained by the module for this class.
+ *	The default implementation of GetStructCache returns a universal StructCache that maps every struct which derives from FOGPolymorphicStructBase
+ * Optionally implement SkipsRedundantWrites to return true if gameplay code tends to set values that haven't changed,
+ *	identical writes are then dropped instead of being replicated again.
+ *
+ * In order for garbage collection to work properly with structs inside the data bank (i.e. respect object pointers in UPROPERTY in stored structs)
+ * MyDataBank must use the WithAddStructReferencedObjects type trait.
+ *
+ * If MyDataBank is going to replicate, you must apply the type trait WithNetSerializer or WithNetDeltaSerializer (Or both)
+ * The actual implementations for delta and non-delta serialization are already done, you only need the trait to inform the engine.
+ * If the data bank is going to be replicated via RPC, you must use WithNetSerializer - RPCs will never use delta serialization
+ * Banks sent by RPC over and over with mostly the same contents can override UsesRPCBaselines to only send the entries that changed
+ * since an earlier send of the same bank instance that the receiver acknowledged, this needs a UOGDataBankBaselineAckComponent on the PlayerController.
+ * If the data bank is going to replicate by value, either trait will work but WithNetDeltaSerializer is generally preferred
+ * it reduces bandwidth and has better handling for object references that cannot be resolved by the client at the time of replication.
+ *
+ * To save MyDataBank to disk or in a SaveGame, apply the WithSerializer type trait. Entries are written by type path with
+ * a layout hash per type, so saves survive entry types being added, removed or reordered between builds.
+ * Plain data entries (see FOGPolymorphicStructCache::IsPlainData) are written member by member without tags, everything else goes through
+ * tagged property serialization and tolerates fields being added or removed. A plain data entry whose layout changed since
+ * it was saved can't be read back and is dropped with a warning.
+ *
+ * You may apply both type traits, it will just trigger an engine warning if you do so. As far as I can tell it will correctly
+ * use delta serialization for value replication and non-delta serialization RPCs without any issues, but the warning itself can interfere
+ * with automated tests.
+ *
+ * Iris replication is not yet supported
+ */
+USTRUCT(BlueprintType)
+struct OGCORE_API FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	friend class UOGPolymorphicDataFunctionLibrary;
+	friend class FOGConcurrentDataBank;
+	friend class UOGDataBankTemplate;
+	friend class FOGDataBankColumnStore;
+	friend struct FOGPolymorphicMultiBankBase;
+	friend struct FOGOverlayDataBankBase;
+	
+	FOGPolymorphicDataBankBase()
+	{
+		INC_DWORD_STAT(STAT_OGCore_LiveBanks);
+	}
+	virtual ~FOGPolymorphicDataBankBase()
+	{
+		DEC_DWORD_STAT(STAT_OGCore_LiveBanks);
+		DEC_DWORD_STAT_BY(STAT_OGCore_LiveEntries, DataMap.Num());
+	}
+
+	//Deep copy the data bank
+	FOGPolymorphicDataBankBase(const FOGPolymorphicDataBankBase& Other);
+	FOGPolymorphicDataBankBase& operator=(const FOGPolymorphicDataBankBase& Other);
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	bool Contains() const
+	{
+		const uint16 Key = GetKey(Derived::StaticStruct());
+		return DataMap.Contains(Key);
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived& AddUnique()
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		return static_cast<Derived&>(AddUnique_Internal(GetKey(Struct),Struct));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void Remove()
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Struct);
+		Remove_Internal(Key, Struct);
+	}
+	
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void SetByCopy(const Derived& Source)
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Derived::StaticStruct());
+		if (IsRedundantWrite(Key, Struct, &Source))
+			return;
+		Derived* Existing = static_cast<Derived*>(Get_Internal(Key));
+		if (!Existing)
+		{
+			Existing = static_cast<Derived*>(&AddUnique_Internal(Key, Struct));
+		}
+		*Existing = Source;
+		//Override replication key in source
+		MarkDirty(*Existing);
+#if WITH_EDITOR
+		AvailableDataTypes.Add(Derived::StaticStruct()->GetStructCPPName());
+#endif
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived& GetSafe()
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Struct);
+		if (Derived* Existing = static_cast<Derived*>(Get_Internal(Key)))
+		{
+			return *Existing;
+		}
+		return static_cast<Derived&>(AddUnique_Internal(Key, Struct));
+	}
+	
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived& GetConstChecked() const
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Struct);
+		const Derived* Existing = static_cast<const Derived*>(GetConst_Internal(Key));
+		if (!ensureAlwaysMsgf(Existing, TEXT("Tried getting a ref for a type that's not in the bank"))) [[unlikely]]
+			return static_cast<Derived&>(const_cast<FOGPolymorphicDataBankBase*>(this)->AddUnique_Internal(Key, Struct));
+		return *Existing;
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived& GetChecked()
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Struct);
+		Derived* Existing = static_cast<Derived*>(Get_Internal(Key));
+		if (!ensureAlwaysMsgf(Existing, TEXT("Tried getting a ref for a type that's not in the bank"))) [[unlikely]]
+			return static_cast<Derived&>(AddUnique_Internal(Key, Struct));
+		Derived& ExistingRef = *Existing;
+		return ExistingRef;
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived* FindConst() const
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Struct);
+		return static_cast<const Derived*>(GetConst_Internal(Key));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived* Find()
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		const uint16 Key = GetKey(Struct);
+		return static_cast<Derived*>(Get_Internal(Key));
+	}
+
+	// Call Func on every entry deriving from TBase. Keys of a type hierarchy are contiguous, so this only looks at that range.
+	// Like Find, every visited entry is marked dirty.
+	template <typename TBase, typename FuncType UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, TBase>)>
+	void ForEach(FuncType&& Func)
+	{
+		ForEachKeyDerivedFrom(TBase::StaticStruct(), [this, &Func](const uint16 Key)
+		{
+			if (FOGPolymorphicStructBase* Entry = Get_Internal(Key))
+			{
+				Func(static_cast<TBase&>(*Entry));
+			}
+		});
+	}
+
+	template <typename TBase, typename FuncType UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, TBase>)>
+	void ForEachConst(FuncType&& Func) const
+	{
+		ForEachKeyDerivedFrom(TBase::StaticStruct(), [this, &Func](const uint16 Key)
+		{
+			if (const FOGPolymorphicStructBase* Entry = GetConst_Internal(Key))
+			{
+				Func(static_cast<const TBase&>(*Entry));
+			}
+		});
+	}
+
+	void Empty();
+
+	// Get told once per frame which entries deriving from Derived were added, written or removed locally or by replication.
+	// Mutable access counts as a write, same as for replication. Subscriptions are not copied with the bank.
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	FOGDataBankSubscriptionHandle SubscribeToChanges(FOGOnDataBankChanged&& Delegate)
+	{
+		return GetOrCreateChangeListeners().Add(GetKey(Derived::StaticStruct()), MoveTemp(Delegate));
+	}
+
+	bool UnsubscribeFromChanges(const FOGDataBankSubscriptionHandle& Handle);
+
+	// Fulfilled once the bank holds a Derived, at the end of the frame it was added in (locally, by replication or when
+	// its object references resolve). Already fulfilled if the bank holds one now. Never fulfilled if the bank goes away first.
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	TOGFuture<void> WhenContains()
+	{
+		const uint16 Key = GetKey(Derived::StaticStruct());
+		if (DataMap.Contains(Key))
+		{
+			TOGPromise<void> Fulfilled;
+			Fulfilled->Fulfill();
+			return Fulfilled;
+		}
+		return GetOrCreateChangeListeners().WhenContains(Key);
+	}
+
+	// Fulfilled at the end of the next frame in which the Derived entry is added or written, same sources as WhenContains
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	TOGFuture<void> WhenChanged()
+	{
+		return GetOrCreateChangeListeners().WhenChanged(GetKey(Derived::StaticStruct()));
+	}
+
+	// The entry's replication key, or 0 if it isn't in the bank. Any write changes it, so listeners can compare it
+	// against the version they last processed and skip entries that weren't touched.
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	uint16 GetEntryVersion() const
+	{
+		const FOGPolymorphicStructBase* Existing = GetConst_Internal(GetKey(Derived::StaticStruct()));
+		return Existing ? Existing->ReplicationKey : 0;
+	}
+
+	// Capture the current contents for lock-free reads on other threads. Must be called from the thread that owns the bank.
+	// Pointers returned by Find/Get before this call must not be written through afterwards, they may now belong to the snapshot.
+	TSharedRef<const FOGPolymorphicDataBankSnapshot> MakeSnapshot() const;
+
+	// Changes whenever the bank might have changed, compare against FOGPolymorphicDataBankSnapshot::GetVersion
+	uint32 GetVersion() const { return Version; }
+
+	// Hash of the entry's contents, 0 if it isn't in the bank. Replication keys don't contribute.
+	// Safe to call from several threads at once, but not while the bank is written.
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	uint32 GetEntryContentHash() const
+	{
+		return GetEntryContentHash_Internal(GetKey(Derived::StaticStruct()));
+	}
+
+	// Hash of every entry's contents, independent of the order they were added in and of replication keys.
+	// Entry hashes are cached and only recomputed for entries written since, so a write through a pointer from Find/Get
+	// after the hash was taken is missed. Fetch the pointer again before writing, the same as for MakeSnapshot.
+	// Safe to call from several threads at once, but not while the bank is written.
+	// Banks that compare equal hash the same, floats are hashed so 0 and -0 agree and sets and maps regardless of order.
+	uint32 GetContentHash() const;
+
+	// Same entry types holding identical values, replication keys are ignored
+	bool Equals(const FOGPolymorphicDataBankBase& Other) const;
+	bool operator==(const FOGPolymorphicDataBankBase& Other) const { return Equals(Other); }
+	bool operator!=(const FOGPolymorphicDataBankBase& Other) const { return !Equals(Other); }
+	friend uint32 GetTypeHash(const FOGPolymorphicDataBankBase& Bank) { return Bank.GetContentHash(); }
+
+	// Heap memory used by the bank: entries with their shared reference blocks and member allocations, pending GUID
+	// references and caches. Entries shared with snapshots or templates are counted by every bank holding them, unless
+	// InOutCountedEntries is given: entries already in it are skipped and the rest are added, so passing the same set
+	// for several banks charges each shared entry to the first bank that holds it.
+	// OutBytesPerEntryType, if given, accumulates the size of each entry by type.
+	SIZE_T GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType = nullptr, TSet<const void*>* InOutCountedEntries = nullptr) const;
+
+	void AddStructReferencedObjects(class FReferenceCollector& Collector);
+	// Saving and loading need an archive that can Seek and Tell (files, memory archives), other archives fail with an error
+	bool Serialize(FArchive& Ar);
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool&bOutSuccess);
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+	// Resolve the InnerStruct of a data bank type without an instance, e.g. for validating Blueprint nodes at compile time.
+	// Returns null for the abstract base type. The result is cached per bank type, so this is cheap to call from editor UI.
+	static const UScriptStruct* GetInnerStructForBankType(const UScriptStruct* BankType);
+
+private:
+
+	virtual UScriptStruct* GetInnerStruct() const PURE_VIRTUAL(FOGPolymorphicDataBankBase::GetInnerStruct, return nullptr;);
+	// Get the specific cache that translates a UScriptStruct to index and back.
+	// default implementation gives a cache that covers every struct type that inherits from FOGPolymorphicStructBase.
+	// Provide your own cache to improve lookup performance.
+	virtual FOGPolymorphicStructCache* GetStructCache() const;
+
+	// When true, SetByCopy and the Blueprint Set skip writes of a value identical to the current entry. The entry keeps its
+	// replication key and nothing is sent or notified. Off by default because the comparison costs a full member walk per write.
+	virtual bool SkipsRedundantWrites() const { return false; }
+
+	// When true, NetSerialize encodes the bank relative to the last send of this same bank instance that the receiver
+	// acknowledged on this connection, see FOGDataBankRPCBaselines. Meant for banks sent by RPC, NetDeltaSerialize is unaffected.
+	// Until an acknowledgement arrives, or without a UOGDataBankBaselineAckComponent, every entry is sent.
+	// Copies and assignments carry the source's stream of baselines along, RPCs send a copy of their parameters.
+	// Sharing a stream between banks with different contents is safe, they just diff against each other's sends.
+	virtual bool UsesRPCBaselines() const { return false; }
+	
+	FORCEINLINE uint16 GetKey(const UScriptStruct* ScriptStruct) const
+	{
+		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(GetInnerStruct()), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
+			return 0;
+		INC_DWORD_STAT(STAT_OGCore_Lookups);
+		return GetStructCache()->GetIndexForType(ScriptStruct);
+	}
+
+	// Key lookup for types already validated against InnerStruct, e.g. by a Blueprint node at compile time
+	FORCEINLINE uint16 GetKeyUnchecked(const UScriptStruct* ScriptStruct) const
+	{
+		INC_DWORD_STAT(STAT_OGCore_Lookups);
+		return GetStructCache()->GetIndexForType(ScriptStruct);
+	}
+
+	FORCEINLINE void MarkDirty(FOGPolymorphicStructBase& Entry)
+	{
+		INC_DWORD_STAT(STAT_OGCore_DirtyMarks);
+		Entry.SetReplicationKey(++LastReplicationKey);
+		++Version;
+	}
+
+	FORCEINLINE void NotifyChanged(const uint16 Key, const bool bPresent = true)
+	{
+		if (ChangeListeners) [[unlikely]]
+		{
+			ChangeListeners->MarkChanged(Key, bPresent);
+		}
+	}
+
+	FOGDataBankChangeListeners& GetOrCreateChangeListeners();
+
+	bool NetSerializeWithBaseline(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	// BaselineStreamId, allocated first if this bank uses RPC baselines and doesn't have one yet
+	uint32 GetOrAllocateBaselineStreamId() const;
+
+	// Whether writing NewValue to Key can be skipped, see SkipsRedundantWrites
+	bool IsRedundantWrite(const uint16 Key, const UScriptStruct* ScriptStruct, const void* NewValue) const;
+
+	uint32 GetEntryContentHash_Internal(const uint16 Key) const;
+	// Drop Key's cached content hash, called wherever the entry is handed out for writing, replaced or removed
+	void InvalidateEntryHash(const uint16 Key);
+	
+	// Calls Func with the key of every entry in the bank that is BaseType or derives from it
+	template <typename FuncType>
+	void ForEachKeyDerivedFrom(const UScriptStruct* BaseType, FuncType&& Func) const
+	{
+		const TPair<uint16, uint16> Range = GetStructCache()->GetSubtreeRange(GetKey(BaseType));
+		TArray<uint16, TInlineAllocator<16>> Keys;
+		if (Range.Value - Range.Key < DataMap.Num())
+		{
+			for (uint16 Key = Range.Key; Key < Range.Value; ++Key)
+			{
+				if (DataMap.Contains(Key))
+				{
+					Keys.Add(Key);
+				}
+			}
+		}
+		else
+		{
+			for (const auto& [Key, Entry] : DataMap)
+			{
+				if (Key >= Range.Key && Key < Range.Value)
+				{
+					Keys.Add(Key);
+				}
+			}
+			Keys.Sort();
+		}
+		// Collected first so Func may add or remove entries
+		for (const uint16 Key : Keys)
+		{
+			Func(Key);
+		}
+	}
+
+	FOGPolymorphicStructBase* Get_Internal(const uint16& Key);
+
+	// Mutable access that leaves the replication key alone, for callers that only mark dirty when something actually changed.
+	// Entries still shared with a snapshot are copied first.
+	FOGPolymorphicStructBase* GetMutable_Internal(const uint16& Key);
+
+	const FOGPolymorphicStructBase* GetConst_Internal(const uint16& Key) const;
+	
+	FOGPolymorphicStructBase& AddUnique_Internal(const uint16& Key, const UScriptStruct* ScriptStruct);
+	
+	// Store an entry allocated elsewhere without copying it, replacing any existing entry for Key.
+	// Entries shared with many banks must not have their replication key written, only the bank's own key is bumped then.
+	void SetShared_Internal(const uint16& Key, const TSharedRef<FOGPolymorphicStructBase>& Entry, const bool bMarkEntryDirty = true);
+
+	// Copy the contents of one entry of type Key into another, plain data types are copied as raw memory
+	void CopyEntry_Internal(const uint16& Key, FOGPolymorphicStructBase& Dest, const FOGPolymorphicStructBase& Source) const;
+	
+	void Remove_Internal(const uint16& Key, const UScriptStruct* ScriptStruct = nullptr);
+
+	static TSharedRef<FOGPolymorphicStructBase> AllocateEntry(const UScriptStruct* ScriptStruct);
+	// Size of AllocateEntry's reference controller: the counts plus the deleter capturing the script struct
+	static constexpr SIZE_T EntryReferenceControllerSize = sizeof(SharedPointerInternals::TReferenceControllerBase<ESPMode::ThreadSafe>) + sizeof(UScriptStruct*);
+	TMap<uint16, TSharedRef<FOGPolymorphicStructBase>> DataMap;
+
+	/** List of items that need to be re-serialized when the referenced objects are mapped */
+	TMap<uint16, FOGPolymorphicDataBankSerializerGuidReferences> GuidReferencesMap;
+
+	/** Created on the first subscription, see SubscribeToChanges */
+	TSharedPtr<FOGDataBankChangeListeners> ChangeListeners;
+
+	/** Content hash of each entry, dropped whenever the entry is handed out for writing, replaced or removed */
+	mutable TMap<uint16, uint32> EntryHashes;
+	/** Const hash reads fill in EntryHashes. A one byte mutex, there is one in every bank. */
+	mutable UE::FMutex EntryHashesLock;
+
+	/** Identifies this instance's sends to FOGDataBankRPCBaselines, allocated on the first send or copy. Copies share it.
+	 * Mutable so copying a bank can allocate it on the source, which later copies then carry along too. */
+	mutable uint32 BaselineStreamId = 0;
+
+	/** Bumped by every change, including removals, for snapshots to compare against. Unlike the 16 bit replication keys it
+	 * only wraps after 2^32 changes, so a snapshot can't come back around to look fresh */
+	uint32 Version = 0;
+	
+	UPROPERTY()
+	uint16 LastReplicationKey = 0;
+
+#if WITH_EDITORONLY_DATA
+	//This set is maintained in editor to make it easy to tell what structs are currently in the data bank
+	UPROPERTY(Transient, NotReplicated)
+	TSet<FString> AvailableDataTypes;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef OG_DATABANK_NETSTATS
+#define OG_DATABANK_NETSTATS !UE_BUILD_SHIPPING
+#endif
+
+#if OG_DATABANK_NETSTATS
+
+/**
+ * Cumulative data bank replication traffic, split per entry type and per bank type.
+ * Bits are attributed to removals, key headers (entry keys and counts) and payload (the entry itself).
+ *
+ * OGCore.DataBank.NetStats dumps everything recorded since the last reset, OGCore.DataBank.NetStatsReset clears it.
+ * Banks serialized through NetSerialize (i.e. RPCs) have no bank type available, they are recorded under their InnerStruct.
+ * Also tracks the CPU time spent serializing banks and how often entries were re-read after their object references resolved.
+ */
+struct OGCORE_API FOGDataBankNetStats
+{
+	enum class EDirection : uint8
+	{
+		Sent,
+		Received,
+		Num
+	};
+
+	struct FCounters
+	{
+		uint64 RemovalBits = 0;
+		uint64 KeyHeaderBits = 0;
+		uint64 PayloadBits = 0;
+		uint32 NumEntries = 0;
+		uint32 NumRemovals = 0;
+
+		uint64 GetTotalBits() const { return RemovalBits + KeyHeaderBits + PayloadBits; }
+	};
+
+	static FOGDataBankNetStats& Get();
+
+	void AddHeader(const EDirection Direction, const UStruct* BankType, const uint64 Bits);
+	void AddRemoval(const EDirection Direction, const UStruct* BankType, const UStruct* EntryType, const uint64 Bits);
+	void AddEntry(const EDirection Direction, const UStruct* BankType, const UStruct* EntryType, const uint64 KeyHeaderBits, const uint64 PayloadBits);
+	void AddSerializeCycles(const EDirection Direction, const uint64 Cycles);
+	void AddGuidResolution();
+
+	// Sum over every bank type
+	FCounters GetTotals(const EDirection Direction) const;
+	double GetSerializeSeconds(const EDirection Direction) const;
+	uint32 GetNumGuidResolutions() const;
+
+	void Reset();
+	void Dump(FOutputDevice& Ar) const;
+
+private:
+	mutable FCriticalSection Lock;
+	TMap<FName, FCounters> PerEntryType[static_cast<uint8>(EDirection::Num)];
+	TMap<FName, FCounters> PerBankType[static_cast<uint8>(EDirection::Num)];
+	uint64 SerializeCycles[static_cast<uint8>(EDirection::Num)] = {};
+	uint32 NumGuidResolutions = 0;
+	double LastResetTime = 0;
+};
+
+// Adds the time until the end of the scope to the serialize time of Direction
+struct FOGDataBankNetStatsCycleScope
+{
+	explicit FOGDataBankNetStatsCycleScope(const FOGDataBankNetStats::EDirection InDirection)
+		: Direction(InDirection), StartCycles(FPlatformTime::Cycles64()) {}
+	~FOGDataBankNetStatsCycleScope()
+	{
+		FOGDataBankNetStats::Get().AddSerializeCycles(Direction, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	FOGDataBankNetStats::EDirection Direction;
+	uint64 StartCycles;
+};
+
+#endif
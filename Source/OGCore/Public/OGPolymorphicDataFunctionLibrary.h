@@ -1,41 +1,91 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Kismet/BlueprintFunctionLibrary.h"
-#include "OGPolymorphicDataBank.h"
-#include "OGPolymorphicDataFunctionLibrary.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class OGCORE_API UOGPolymorphicDataFunctionLibrary : public UBlueprintFunctionLibrary
-{
-	GENERATED_BODY()
-
-public:
-	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="NewStruct", DefaultToSelf="DataBankOwner", AdvancedDisplay="DataBankOwner"))
-	static void AddUnique(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const int& NewStruct) {check(0);}
-	DECLARE_FUNCTION(execAddUnique);
-	static void AddUniqueGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData);
-
-	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="InStruct"))
-	static void Set(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const int& InStruct) {check(0);}
-	DECLARE_FUNCTION(execSet);
-	static void SetGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData);
-	
-	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="OutStruct"))
-	static void Get(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, int& OutStruct) {check(0);}
-	DECLARE_FUNCTION(execGet);
-	static void GetGeneric(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, void* OutData);
-
-	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="OutStruct"))
-	static void Find(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, bool& bOutFound, int& OutStruct) {check(0);}
-	DECLARE_FUNCTION(execFind);
-	static void FindGeneric(const FOGPolymorphicDataBankBase& DataBank, bool& OutFound, const UScriptStruct* StructType, const FStructProperty* Prop, void* OutData);
-
-	UFUNCTION(BlueprintCallable, Category="DataBank")
-	static void Empty(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank);
-};
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGPolymorphicDataFunctionLibrary.generated.h"
+
+/**
+ * 
+ */
+UCLASS()
+class OGCORE_API UOGPolymorphicDataFunctionLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="NewStruct", DefaultToSelf="DataBankOwner", AdvancedDisplay="DataBankOwner"))
+	static void AddUnique(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const int& NewStruct) {check(0);}
+	DECLARE_FUNCTION(execAddUnique);
+	static void AddUniqueGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="InStruct"))
+	static void Set(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const int& InStruct) {check(0);}
+	DECLARE_FUNCTION(execSet);
+	static void SetGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData);
+	
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="OutStruct"))
+	static void Get(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, int& OutStruct) {check(0);}
+	DECLARE_FUNCTION(execGet);
+	static void GetGeneric(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* StructType, const FStructProperty* Prop, void* OutData);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="OutStruct"))
+	static void Find(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, bool& bOutFound, int& OutStruct) {check(0);}
+	DECLARE_FUNCTION(execFind);
+	static void FindGeneric(const FOGPolymorphicDataBankBase& DataBank, bool& OutFound, const UScriptStruct* StructType, const FStructProperty* Prop, void* OutData);
+
+	// Targets for UK2Node_OGDataBankAccess. The node validates EntryType against the data bank at Blueprint compile time
+	// and bakes it in, so these skip the wildcard type checks and resolve the key straight from the struct cache.
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(BlueprintInternalUseOnly="true", CustomStructureParam="NewStruct"))
+	static void AddUniqueResolved(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const int& NewStruct) {check(0);}
+	DECLARE_FUNCTION(execAddUniqueResolved);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(BlueprintInternalUseOnly="true", CustomStructureParam="InStruct"))
+	static void SetResolved(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const int& InStruct) {check(0);}
+	DECLARE_FUNCTION(execSetResolved);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(BlueprintInternalUseOnly="true", CustomStructureParam="OutStruct"))
+	static void GetResolved(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, int& OutStruct) {check(0);}
+	DECLARE_FUNCTION(execGetResolved);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, meta=(BlueprintInternalUseOnly="true", CustomStructureParam="OutStruct"))
+	static void FindResolved(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, bool& bOutFound, int& OutStruct) {check(0);}
+	DECLARE_FUNCTION(execFindResolved);
+
+	//Reads a single member of an entry in place, without copying the rest of the entry
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="OutValue"))
+	static void GetField(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, FName FieldName, bool& bOutFound, int& OutValue) {check(0);}
+	DECLARE_FUNCTION(execGetField);
+	static bool GetFieldGeneric(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const FProperty* Field, void* OutData);
+
+	//Writes a single member of an entry in place. The entry is only marked dirty if the value actually changed.
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="DataBank", meta=(CustomStructureParam="Value"))
+	static void SetField(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, FName FieldName, bool& bOutChanged, const int& Value) {check(0);}
+	DECLARE_FUNCTION(execSetField);
+	static bool SetFieldGeneric(FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const FProperty* Field, const void* InData);
+
+	UFUNCTION(BlueprintCallable, Category="DataBank")
+	static void Empty(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank);
+
+	//Types of the entries in the bank that are BaseType or derive from it, in key order. Use with GetField/SetField.
+	UFUNCTION(BlueprintPure, Category="DataBank")
+	static TArray<UScriptStruct*> GetEntryTypesDerivedFrom(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* BaseType);
+
+	//OnChanged fires at most once per frame with the changed types that are EntryType or derive from it
+	UFUNCTION(BlueprintCallable, Category="DataBank")
+	static FOGDataBankSubscriptionHandle SubscribeToChanges(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, FOGOnDataBankChangedDynamic OnChanged);
+
+	UFUNCTION(BlueprintCallable, Category="DataBank")
+	static bool UnsubscribeFromChanges(UPARAM(ref) FOGPolymorphicDataBankBase& DataBank, const FOGDataBankSubscriptionHandle& Subscription);
+
+private:
+	static void AddUniqueByKey(FOGPolymorphicDataBankBase& DataBank, const uint16 Key, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData);
+	static void SetByKey(FOGPolymorphicDataBankBase& DataBank, const uint16 Key, const UScriptStruct* StructType, const FStructProperty* Prop, const void* InData);
+	static bool FindByKey(const FOGPolymorphicDataBankBase& DataBank, const uint16 Key, const FStructProperty* Prop, void* OutData);
+
+	//Shared validation for the field accessors, returns the member of EntryType matching ValueProperty or throws a script exception
+	static const FProperty* ResolveField(const FOGPolymorphicDataBankBase& DataBank, const UScriptStruct* EntryType, const FName FieldName,
+		const FProperty* ValueProperty, UObject* Context, FFrame& Stack);
+};
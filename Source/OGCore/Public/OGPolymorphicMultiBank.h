@@ -0,0 +1,197 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGHandleBase.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGPolymorphicMultiBank.generated.h"
+
+/** Identifies one element of an FOGPolymorphicMultiBankBase. Ids are assigned by whoever adds the element and replicate as is. */
+USTRUCT(BlueprintType)
+struct OGCORE_API FOGDataBankElementHandle : public FOGHandleBase
+{
+	GENERATED_BODY()
+
+	FOGDataBankElementHandle() : FOGHandleBase() {}
+	FOGDataBankElementHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGDataBankElementHandle> : public TOGHandleStructOpsTypeTraits<FOGDataBankElementHandle>
+{
+};
+
+/** Custom INetDeltaBaseState used by MultiBank Serialization */
+class FOGPolymorphicMultiBankDeltaState : public FOGDataBankDeltaStateBase
+{
+public:
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		FOGPolymorphicMultiBankDeltaState* Other = static_cast<FOGPolymorphicMultiBankDeltaState*>(OtherState);
+		if (IDToRepKeyMap.Num() != Other->IDToRepKeyMap.Num())
+			return false;
+		for (auto It = IDToRepKeyMap.CreateConstIterator(); It; ++It)
+		{
+			const uint16* Ptr = Other->IDToRepKeyMap.Find(It.Key());
+			if (!Ptr || *Ptr != It.Value())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	virtual void CountBytes(FArchive& Ar) const override
+	{
+		//The engine doesn't count the state object itself
+		Ar.CountBytes(sizeof(*this), sizeof(*this));
+		IDToRepKeyMap.CountBytes(Ar);
+	}
+
+	/** Maps an element's handle id to ReplicationKey. */
+	TMap<OGHandleIdType, uint16> IDToRepKeyMap;
+
+	int32 ContainerReplicationKey = INDEX_NONE;
+};
+
+/**
+ * Sibling of FOGPolymorphicDataBankBase that can hold any number of instances of each struct type.
+ * Every element is identified by an FOGDataBankElementHandle, and all the elements of a type can be looked up directly.
+ * Replication works per element the same way the data bank works per type: only added, changed and removed elements are
+ * sent, and elements with unresolved object references are re-read once the objects arrive.
+ *
+ * Use it like the data bank: extend it, implement GetInnerStruct (and optionally GetStructCache), and apply the
+ * WithAddStructReferencedObjects and WithNetDeltaSerializer / WithNetSerializer type traits.
+ *
+ * Handles are generated where elements are added. A replicated multi bank should only be modified by the server,
+ * clients receive the server's handles.
+ */
+USTRUCT(BlueprintType)
+struct OGCORE_API FOGPolymorphicMultiBankBase
+{
+	GENERATED_BODY()
+
+	FOGPolymorphicMultiBankBase() {}
+	virtual ~FOGPolymorphicMultiBankBase()
+	{
+		DEC_DWORD_STAT_BY(STAT_OGCore_LiveEntries, Elements.Num());
+	}
+
+	//Deep copy the multi bank, handles are kept
+	FOGPolymorphicMultiBankBase(const FOGPolymorphicMultiBankBase& Other);
+	FOGPolymorphicMultiBankBase& operator=(const FOGPolymorphicMultiBankBase& Other);
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived& Add(FOGDataBankElementHandle& OutHandle)
+	{
+		const UScriptStruct* Struct = Derived::StaticStruct();
+		return static_cast<Derived&>(Add_Internal(GetKey(Struct), Struct, OutHandle));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	FOGDataBankElementHandle AddByCopy(const Derived& Source)
+	{
+		FOGDataBankElementHandle Handle;
+		Derived& Element = Add<Derived>(Handle);
+		Element = Source;
+		MarkDirty(Element);
+		return Handle;
+	}
+
+	// Mutable access marks the element dirty. Returns null if the handle is stale or the element isn't a Derived.
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	Derived* Find(const FOGDataBankElementHandle& Handle)
+	{
+		if (!IsA(Handle, Derived::StaticStruct()))
+			return nullptr;
+		return static_cast<Derived*>(Get_Internal(Handle.GetHandleId()));
+	}
+
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	const Derived* FindConst(const FOGDataBankElementHandle& Handle) const
+	{
+		if (!IsA(Handle, Derived::StaticStruct()))
+			return nullptr;
+		return static_cast<const Derived*>(GetConst_Internal(Handle.GetHandleId()));
+	}
+
+	// Handles of every element of exactly type Derived, in the order they were added
+	template <typename Derived UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	TConstArrayView<FOGDataBankElementHandle> GetHandlesOfType() const
+	{
+		const TArray<FOGDataBankElementHandle>* Handles = TypeIndex.Find(GetKey(Derived::StaticStruct()));
+		return Handles ? TConstArrayView<FOGDataBankElementHandle>(*Handles) : TConstArrayView<FOGDataBankElementHandle>();
+	}
+
+	template <typename Derived, typename FuncType UE_REQUIRES(std::is_base_of_v<FOGPolymorphicStructBase, Derived>)>
+	void ForEachConst(FuncType&& Func) const
+	{
+		for (const FOGDataBankElementHandle& Handle : GetHandlesOfType<Derived>())
+		{
+			Func(Handle, static_cast<const Derived&>(*GetConst_Internal(Handle.GetHandleId())));
+		}
+	}
+
+	bool Contains(const FOGDataBankElementHandle& Handle) const { return Elements.Contains(Handle.GetHandleId()); }
+	int32 Num() const { return Elements.Num(); }
+
+	bool Remove(const FOGDataBankElementHandle& Handle);
+	void Empty();
+
+	// Same as FOGPolymorphicDataBankBase::GetAllocatedSize
+	SIZE_T GetAllocatedSize(TMap<const UScriptStruct*, SIZE_T>* OutBytesPerEntryType = nullptr, TSet<const void*>* InOutCountedEntries = nullptr) const;
+
+	void AddStructReferencedObjects(class FReferenceCollector& Collector);
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+private:
+	virtual UScriptStruct* GetInnerStruct() const PURE_VIRTUAL(FOGPolymorphicMultiBankBase::GetInnerStruct, return nullptr;);
+	// Same as FOGPolymorphicDataBankBase::GetStructCache
+	virtual FOGPolymorphicStructCache* GetStructCache() const;
+
+	struct FElement
+	{
+		uint16 TypeKey;
+		TSharedRef<FOGPolymorphicStructBase> Data;
+	};
+
+	FORCEINLINE uint16 GetKey(const UScriptStruct* ScriptStruct) const
+	{
+		if (!ensureAlwaysMsgf(ScriptStruct->IsChildOf(GetInnerStruct()), TEXT("Derived type must inherit from InnerStruct"))) [[unlikely]]
+			return 0;
+		return GetStructCache()->GetIndexForType(ScriptStruct);
+	}
+
+	bool IsA(const FOGDataBankElementHandle& Handle, const UScriptStruct* ScriptStruct) const
+	{
+		const FElement* Element = Elements.Find(Handle.GetHandleId());
+		return Element && GetStructCache()->GetTypeForIndex(Element->TypeKey)->IsChildOf(ScriptStruct);
+	}
+
+	FORCEINLINE void MarkDirty(FOGPolymorphicStructBase& Element)
+	{
+		Element.SetReplicationKey(++LastReplicationKey);
+	}
+
+	// Generates the handle out of line, GenerateHandle must not be inlined into other modules
+	FOGPolymorphicStructBase& Add_Internal(const uint16 TypeKey, const UScriptStruct* ScriptStruct, FOGDataBankElementHandle& OutHandle);
+	FOGPolymorphicStructBase& AddWithId_Internal(const OGHandleIdType Id, const uint16 TypeKey, const UScriptStruct* ScriptStruct);
+	FOGPolymorphicStructBase* Get_Internal(const OGHandleIdType Id);
+	const FOGPolymorphicStructBase* GetConst_Internal(const OGHandleIdType Id) const;
+	void Remove_Internal(const OGHandleIdType Id);
+	void CopyFrom(const FOGPolymorphicMultiBankBase& Other);
+
+	TMap<OGHandleIdType, FElement> Elements;
+
+	/** Handles of all elements of each type, keyed by the struct cache key */
+	TMap<uint16, TArray<FOGDataBankElementHandle>> TypeIndex;
+
+	/** List of items that need to be re-serialized when the referenced objects are mapped */
+	TMap<OGHandleIdType, FOGPolymorphicDataBankSerializerGuidReferences> GuidReferencesMap;
+
+	UPROPERTY()
+	uint16 LastReplicationKey = 0;
+};
@@ -0,0 +1,179 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGHandleBase.h"
+
+/**
+ * Container that issues its own handles for the values it stores.
+ * A handle id packs the slot index with a generation counter that is bumped whenever the slot is freed,
+ * so lookups are O(1) array accesses and a handle to a removed value never resolves to whatever reused the slot.
+ * Freed slots are reused oldest first, so generations advance evenly across all free slots. A slot whose generation
+ * is exhausted is retired rather than wrapping back to a generation that stale handles may still hold, it counts
+ * towards MaxSlots from then on.
+ * Values are kept densely packed for iteration, removal swaps the last value into the gap.
+ *
+ * HandleType can be any OG handle: an FOGHandleBase subclass or a TOGHandle. Handles from the slot map are not created
+ * through GenerateHandle, they are only meaningful to the slot map that issued them. Invalid handles
+ * (EmptyHandle, id 0) are never issued.
+ *
+ * Pointers and references to values are invalidated by Add and Remove, handles are not.
+ */
+template<typename HandleType, typename ValueType>
+class TOGSlotMap
+{
+public:
+	static constexpr uint32 IndexBits = 20;
+	static constexpr uint32 GenerationBits = 32 - IndexBits;
+	static constexpr uint32 MaxSlots = 1u << IndexBits;
+
+	template<typename... ArgTypes>
+	HandleType Emplace(ArgTypes&&... Args)
+	{
+		uint32 SlotIndex;
+		if (FreeListHead != NoFreeSlot)
+		{
+			SlotIndex = FreeListHead;
+			FreeListHead = Slots[SlotIndex].DenseIndexOrNextFree;
+			if (FreeListHead == NoFreeSlot)
+			{
+				FreeListTail = NoFreeSlot;
+			}
+		}
+		else
+		{
+			checkf(static_cast<uint32>(Slots.Num()) < MaxSlots, TEXT("TOGSlotMap is limited to %u values"), MaxSlots);
+			SlotIndex = Slots.Emplace();
+		}
+
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.DenseIndexOrNextFree = Values.Emplace(Forward<ArgTypes>(Args)...);
+		DenseToSlot.Add(SlotIndex);
+		return HandleType(MakeId(SlotIndex, Slot.Generation));
+	}
+
+	HandleType Add(const ValueType& Value) { return Emplace(Value); }
+	HandleType Add(ValueType&& Value) { return Emplace(MoveTemp(Value)); }
+
+	ValueType* Find(const HandleType& Handle)
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? &Values[DenseIndex] : nullptr;
+	}
+
+	const ValueType* Find(const HandleType& Handle) const
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? &Values[DenseIndex] : nullptr;
+	}
+
+	bool Contains(const HandleType& Handle) const
+	{
+		return GetDenseIndex(Handle) != INDEX_NONE;
+	}
+
+	bool Remove(const HandleType& Handle)
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		if (DenseIndex == INDEX_NONE)
+			return false;
+
+		const uint32 SlotIndex = GetSlotIndex(Handle.GetHandleId());
+		Values.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+		DenseToSlot.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+		if (DenseIndex < Values.Num())
+		{
+			Slots[DenseToSlot[DenseIndex]].DenseIndexOrNextFree = DenseIndex;
+		}
+
+		FSlot& Slot = Slots[SlotIndex];
+		//Generation 0 is never issued, it marks retired slots
+		if (Slot.Generation == GenerationMask)
+		{
+			Slot.Generation = 0;
+			Slot.DenseIndexOrNextFree = NoFreeSlot;
+			return true;
+		}
+		++Slot.Generation;
+		Slot.DenseIndexOrNextFree = NoFreeSlot;
+		if (FreeListTail != NoFreeSlot)
+		{
+			Slots[FreeListTail].DenseIndexOrNextFree = SlotIndex;
+		}
+		else
+		{
+			FreeListHead = SlotIndex;
+		}
+		FreeListTail = SlotIndex;
+		return true;
+	}
+
+	// Removes all values. Slots are kept with bumped generations, so handles issued before stay stale.
+	void Reset()
+	{
+		for (int32 DenseIndex = Values.Num() - 1; DenseIndex >= 0; --DenseIndex)
+		{
+			Remove(GetHandleAt(DenseIndex));
+		}
+	}
+
+	int32 Num() const { return Values.Num(); }
+	void Reserve(const int32 Number) { Values.Reserve(Number); DenseToSlot.Reserve(Number); Slots.Reserve(Number); }
+
+	// Dense iteration, the order changes when values are removed
+	TArrayView<ValueType> GetValues() { return Values; }
+	TArrayView<const ValueType> GetValues() const { return Values; }
+	HandleType GetHandleAt(const int32 DenseIndex) const
+	{
+		const uint32 SlotIndex = DenseToSlot[DenseIndex];
+		return HandleType(MakeId(SlotIndex, Slots[SlotIndex].Generation));
+	}
+
+	auto begin() { return Values.begin(); }
+	auto end() { return Values.end(); }
+	auto begin() const { return Values.begin(); }
+	auto end() const { return Values.end(); }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Slots.GetAllocatedSize() + Values.GetAllocatedSize() + DenseToSlot.GetAllocatedSize();
+	}
+
+private:
+	static constexpr uint32 IndexMask = MaxSlots - 1;
+	static constexpr uint32 GenerationMask = (1u << GenerationBits) - 1;
+	static constexpr uint32 NoFreeSlot = MAX_uint32;
+
+	struct FSlot
+	{
+		// Position in Values while occupied, next free slot while on the free list
+		uint32 DenseIndexOrNextFree = 0;
+		uint32 Generation = 1;
+	};
+
+	static OGHandleIdType MakeId(const uint32 SlotIndex, const uint32 Generation)
+	{
+		return (Generation << IndexBits) | SlotIndex;
+	}
+
+	static uint32 GetSlotIndex(const OGHandleIdType Id) { return Id & IndexMask; }
+	static uint32 GetGeneration(const OGHandleIdType Id) { return Id >> IndexBits; }
+
+	int32 GetDenseIndex(const HandleType& Handle) const
+	{
+		const OGHandleIdType Id = Handle.GetHandleId();
+		const uint32 SlotIndex = GetSlotIndex(Id);
+		const uint32 Generation = GetGeneration(Id);
+		if (Generation == 0 || SlotIndex >= static_cast<uint32>(Slots.Num()) || Slots[SlotIndex].Generation != Generation)
+			return INDEX_NONE;
+		return Slots[SlotIndex].DenseIndexOrNextFree;
+	}
+
+	TArray<FSlot> Slots;
+	TArray<ValueType> Values;
+	TArray<uint32> DenseToSlot;
+	// Free slots are reused in the order they were freed, the list runs from head to tail
+	uint32 FreeListHead = NoFreeSlot;
+	uint32 FreeListTail = NoFreeSlot;
+};
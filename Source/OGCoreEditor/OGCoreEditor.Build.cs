@@ -0,0 +1,30 @@
+using UnrealBuildTool;
+
+public class OGCoreEditor : ModuleRules
+{
+	public OGCoreEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"BlueprintGraph"
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"OGCore",
+				"KismetCompiler",
+				"UnrealEd",
+				"Slate",
+				"SlateCore"
+			}
+		);
+	}
+}
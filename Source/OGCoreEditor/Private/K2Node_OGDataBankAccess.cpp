@@ -0,0 +1,285 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "K2Node_OGDataBankAccess.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGPolymorphicDataFunctionLibrary.h"
+#include "Styling/AppStyle.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_OGDataBankAccess"
+
+namespace OGDataBankAccessPins
+{
+	static const FName DataBank(TEXT("DataBank"));
+	static const FName Value(TEXT("Value"));
+	static const FName Found(TEXT("bFound"));
+	static const FName EntryType(TEXT("EntryType"));
+}
+
+void UK2Node_OGDataBankAccess::AllocateDefaultPins()
+{
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+
+	FCreatePinParams DataBankPinParams;
+	DataBankPinParams.bIsReference = true;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, FOGPolymorphicDataBankBase::StaticStruct(), OGDataBankAccessPins::DataBank, DataBankPinParams);
+
+	if (Operation == EOGDataBankAccessOp::Find)
+	{
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Boolean, OGDataBankAccessPins::Found);
+	}
+
+	CreatePin(IsValueInput() ? EGPD_Input : EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, OGDataBankAccessPins::Value);
+	RefreshValuePinType();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_OGDataBankAccess::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	FText OperationTitle;
+	switch (Operation)
+	{
+	case EOGDataBankAccessOp::AddUnique:
+		OperationTitle = LOCTEXT("AddUniqueTitle", "Add Unique Data Bank Entry");
+		break;
+	case EOGDataBankAccessOp::Set:
+		OperationTitle = LOCTEXT("SetTitle", "Set Data Bank Entry");
+		break;
+	case EOGDataBankAccessOp::Get:
+		OperationTitle = LOCTEXT("GetTitle", "Get Data Bank Entry");
+		break;
+	case EOGDataBankAccessOp::Find:
+		OperationTitle = LOCTEXT("FindTitle", "Find Data Bank Entry");
+		break;
+	}
+
+	if (TitleType == ENodeTitleType::MenuTitle || !EntryType)
+		return OperationTitle;
+	return FText::Format(LOCTEXT("TypedTitle", "{0}\n{1}"), OperationTitle, EntryType->GetDisplayNameText());
+}
+
+FText UK2Node_OGDataBankAccess::GetTooltipText() const
+{
+	return LOCTEXT("Tooltip", "Access a data bank entry by type. The entry type is taken from the struct connected to the value pin and is checked against the data bank when the Blueprint compiles.");
+}
+
+FSlateIcon UK2Node_OGDataBankAccess::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon(FAppStyle::GetAppStyleSetName(), "Kismet.AllClasses.FunctionIcon");
+	return Icon;
+}
+
+void UK2Node_OGDataBankAccess::ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const
+{
+	Super::ValidateNodeDuringCompilation(MessageLog);
+
+	if (!EntryType)
+	{
+		MessageLog.Error(*LOCTEXT("MissingEntryType", "@@ needs a data bank entry struct connected to its value pin").ToString(), this);
+		return;
+	}
+
+	if (!EntryType->IsChildOf(FOGPolymorphicStructBase::StaticStruct()))
+	{
+		MessageLog.Error(*FText::Format(LOCTEXT("NotAnEntryType", "@@: {0} does not derive from FOGPolymorphicStructBase"),
+			FText::FromString(EntryType->GetStructCPPName())).ToString(), this);
+		return;
+	}
+
+	const UScriptStruct* BankType = GetConnectedBankType();
+	const UScriptStruct* InnerStruct = FOGPolymorphicDataBankBase::GetInnerStructForBankType(BankType);
+	if (InnerStruct && !EntryType->IsChildOf(InnerStruct))
+	{
+		MessageLog.Error(*FText::Format(LOCTEXT("EntryTypeMismatch", "@@: DataBank of type {0} may only hold types derived from {1}, {2} does not"),
+			FText::FromString(BankType->GetStructCPPName()),
+			FText::FromString(InnerStruct->GetStructCPPName()),
+			FText::FromString(EntryType->GetStructCPPName())).ToString(), this);
+	}
+}
+
+void UK2Node_OGDataBankAccess::NotifyPinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::NotifyPinConnectionListChanged(Pin);
+
+	if (Pin != GetValuePin())
+		return;
+
+	UScriptStruct* NewEntryType = nullptr;
+	if (Pin->LinkedTo.Num() > 0 && Pin->LinkedTo[0]->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct)
+	{
+		NewEntryType = Cast<UScriptStruct>(Pin->LinkedTo[0]->PinType.PinSubCategoryObject.Get());
+	}
+
+	if (NewEntryType != EntryType)
+	{
+		Modify();
+		EntryType = NewEntryType;
+		RefreshValuePinType();
+		GetGraph()->NotifyGraphChanged();
+	}
+}
+
+bool UK2Node_OGDataBankAccess::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (MyPin == GetValuePin() && OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		const UScriptStruct* OtherStruct = Cast<UScriptStruct>(OtherPin->PinType.PinSubCategoryObject.Get());
+		if (OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Struct || !OtherStruct || !OtherStruct->IsChildOf(FOGPolymorphicStructBase::StaticStruct()))
+		{
+			OutReason = LOCTEXT("ValueNotEntry", "Value must be a struct derived from FOGPolymorphicStructBase").ToString();
+			return true;
+		}
+
+		const UScriptStruct* InnerStruct = FOGPolymorphicDataBankBase::GetInnerStructForBankType(GetConnectedBankType());
+		if (InnerStruct && !OtherStruct->IsChildOf(InnerStruct))
+		{
+			OutReason = FText::Format(LOCTEXT("ValueNotInner", "The connected data bank may only hold types derived from {0}"),
+				FText::FromString(InnerStruct->GetStructCPPName())).ToString();
+			return true;
+		}
+	}
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_OGDataBankAccess::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	if (!EntryType)
+	{
+		//Already reported by ValidateNodeDuringCompilation
+		BreakAllNodeLinks();
+		return;
+	}
+
+	//Only bake in the type when the concrete bank type is known, otherwise the runtime has to check it
+	const bool bIsResolved = FOGPolymorphicDataBankBase::GetInnerStructForBankType(GetConnectedBankType()) != nullptr;
+
+	FName FunctionName;
+	FName ValueParamName;
+	switch (Operation)
+	{
+	case EOGDataBankAccessOp::AddUnique:
+		FunctionName = bIsResolved ? GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, AddUniqueResolved) : GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, AddUnique);
+		ValueParamName = TEXT("NewStruct");
+		break;
+	case EOGDataBankAccessOp::Set:
+		FunctionName = bIsResolved ? GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, SetResolved) : GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, Set);
+		ValueParamName = TEXT("InStruct");
+		break;
+	case EOGDataBankAccessOp::Get:
+		FunctionName = bIsResolved ? GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, GetResolved) : GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, Get);
+		ValueParamName = TEXT("OutStruct");
+		break;
+	case EOGDataBankAccessOp::Find:
+		FunctionName = bIsResolved ? GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, FindResolved) : GET_FUNCTION_NAME_CHECKED(UOGPolymorphicDataFunctionLibrary, Find);
+		ValueParamName = TEXT("OutStruct");
+		break;
+	}
+
+	UK2Node_CallFunction* CallFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFunction->FunctionReference.SetExternalMember(FunctionName, UOGPolymorphicDataFunctionLibrary::StaticClass());
+	CallFunction->AllocateDefaultPins();
+
+	if (bIsResolved)
+	{
+		UEdGraphPin* EntryTypePin = CallFunction->FindPinChecked(OGDataBankAccessPins::EntryType);
+		EntryTypePin->DefaultObject = EntryType;
+	}
+
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CallFunction->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(UEdGraphSchema_K2::PN_Then), *CallFunction->GetThenPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetDataBankPin(), *CallFunction->FindPinChecked(OGDataBankAccessPins::DataBank));
+
+	UEdGraphPin* CallValuePin = CallFunction->FindPinChecked(ValueParamName);
+	CallValuePin->PinType = GetValuePin()->PinType;
+	CompilerContext.MovePinLinksToIntermediate(*GetValuePin(), *CallValuePin);
+
+	if (Operation == EOGDataBankAccessOp::Find)
+	{
+		CompilerContext.MovePinLinksToIntermediate(*GetFoundPin(), *CallFunction->FindPinChecked(TEXT("bOutFound")));
+	}
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_OGDataBankAccess::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (!ActionRegistrar.IsOpenForRegistration(ActionKey))
+		return;
+
+	for (const EOGDataBankAccessOp Op : {EOGDataBankAccessOp::AddUnique, EOGDataBankAccessOp::Set, EOGDataBankAccessOp::Get, EOGDataBankAccessOp::Find})
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(ActionKey);
+		check(NodeSpawner);
+		NodeSpawner->CustomizeNodeDelegate = UBlueprintNodeSpawner::FCustomizeNodeDelegate::CreateLambda([Op](UEdGraphNode* NewNode, bool bIsTemplateNode)
+		{
+			CastChecked<UK2Node_OGDataBankAccess>(NewNode)->Operation = Op;
+		});
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_OGDataBankAccess::GetMenuCategory() const
+{
+	return LOCTEXT("MenuCategory", "DataBank");
+}
+
+bool UK2Node_OGDataBankAccess::HasExternalDependencies(TArray<UStruct*>* OptionalOutput) const
+{
+	const bool bHasEntryTypeDependency = EntryType != nullptr;
+	if (bHasEntryTypeDependency && OptionalOutput)
+	{
+		OptionalOutput->AddUnique(EntryType);
+	}
+	const bool bSuperResult = Super::HasExternalDependencies(OptionalOutput);
+	return bSuperResult || bHasEntryTypeDependency;
+}
+
+UEdGraphPin* UK2Node_OGDataBankAccess::GetDataBankPin() const
+{
+	return FindPinChecked(OGDataBankAccessPins::DataBank);
+}
+
+UEdGraphPin* UK2Node_OGDataBankAccess::GetValuePin() const
+{
+	return FindPinChecked(OGDataBankAccessPins::Value);
+}
+
+UEdGraphPin* UK2Node_OGDataBankAccess::GetFoundPin() const
+{
+	return FindPin(OGDataBankAccessPins::Found);
+}
+
+const UScriptStruct* UK2Node_OGDataBankAccess::GetConnectedBankType() const
+{
+	const UEdGraphPin* DataBankPin = GetDataBankPin();
+	if (DataBankPin->LinkedTo.Num() == 0)
+		return nullptr;
+	return Cast<UScriptStruct>(DataBankPin->LinkedTo[0]->PinType.PinSubCategoryObject.Get());
+}
+
+void UK2Node_OGDataBankAccess::RefreshValuePinType() const
+{
+	UEdGraphPin* ValuePin = GetValuePin();
+	if (EntryType)
+	{
+		ValuePin->PinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+		ValuePin->PinType.PinSubCategoryObject = EntryType;
+	}
+	else
+	{
+		ValuePin->PinType.PinCategory = UEdGraphSchema_K2::PC_Wildcard;
+		ValuePin->PinType.PinSubCategoryObject = nullptr;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
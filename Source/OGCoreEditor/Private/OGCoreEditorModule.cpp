@@ -0,0 +1,5 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGCoreEditorModule.h"
+	
+IMPLEMENT_MODULE(FOGCoreEditorModule, OGCoreEditor)
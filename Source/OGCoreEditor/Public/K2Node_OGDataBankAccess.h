@@ -0,0 +1,67 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node.h"
+#include "K2Node_OGDataBankAccess.generated.h"
+
+UENUM()
+enum class EOGDataBankAccessOp : uint8
+{
+	AddUnique,
+	Set,
+	Get,
+	Find
+};
+
+/**
+ * Typed access to a single data bank entry.
+ * The entry type is taken from the struct connected to the value pin and checked against the InnerStruct of the
+ * connected data bank when the Blueprint compiles, instead of on every call.
+ * The node expands to the matching *Resolved function in UOGPolymorphicDataFunctionLibrary with the entry type baked in.
+ * If the concrete data bank type can't be known at compile time (the pin is a plain FOGPolymorphicDataBankBase)
+ * it falls back to the runtime checked library function.
+ */
+UCLASS()
+class OGCOREEDITOR_API UK2Node_OGDataBankAccess : public UK2Node
+{
+	GENERATED_BODY()
+
+public:
+	//~ UEdGraphNode interface
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void ValidateNodeDuringCompilation(FCompilerResultsLog& MessageLog) const override;
+	//~ End UEdGraphNode interface
+
+	//~ UK2Node interface
+	virtual void NotifyPinConnectionListChanged(UEdGraphPin* Pin) override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual bool HasExternalDependencies(TArray<UStruct*>* OptionalOutput) const override;
+	//~ End UK2Node interface
+
+	UEdGraphPin* GetDataBankPin() const;
+	UEdGraphPin* GetValuePin() const;
+	UEdGraphPin* GetFoundPin() const;
+
+private:
+	bool IsValueInput() const { return Operation == EOGDataBankAccessOp::AddUnique || Operation == EOGDataBankAccessOp::Set; }
+
+	// The concrete data bank type connected to this node, if any
+	const UScriptStruct* GetConnectedBankType() const;
+
+	void RefreshValuePinType() const;
+
+	UPROPERTY()
+	EOGDataBankAccessOp Operation = EOGDataBankAccessOp::Get;
+
+	// Resolved from the value pin connection, this is what gets baked into the runtime call
+	UPROPERTY()
+	TObjectPtr<UScriptStruct> EntryType = nullptr;
+};
@@ -0,0 +1,14 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "Modules/ModuleManager.h"
+
+class FOGCoreEditorModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override {}
+	virtual void ShutdownModule() override {}
+};
@@ -1,26 +1,40 @@
-﻿using UnrealBuildTool;
-
-public class OGCoreTests : ModuleRules
-{
-	public OGCoreTests(ReadOnlyTargetRules Target) : base(Target)
-	{
-		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
-
-		PublicDependencyModuleNames.AddRange(
-			new string[]
-			{
-				"Core",
-				"CoreUObject",
-				"Engine"
-			}
-		);
-
-		PrivateDependencyModuleNames.AddRange(
-			new string[]
-			{
-				"FunctionalTesting",
-				"OGCore"
-			}
-		);
-	}
+using UnrealBuildTool;
+
+public class OGCoreTests : ModuleRules
+{
+	public OGCoreTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine"
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"FunctionalTesting",
+				"Json",
+				"OGCore",
+				"OGDevCore"
+			}
+		);
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"BlueprintGraph",
+					"OGCoreEditor",
+					"UnrealEd"
+				}
+			);
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#if WITH_EDITOR
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_OGDataBankAccess.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Misc/AutomationTest.h"
+#include "PolymorphicDataBankTest.h"
+
+namespace OGDataBankAccessTest
+{
+	// A loose pin of the given struct type, owned by a scratch node so it can be linked to the node under test
+	static UEdGraphPin* MakeStructPin(UEdGraphNode* Owner, EEdGraphPinDirection Direction, FName Category, UScriptStruct* Struct)
+	{
+		UEdGraphPin* Pin = UEdGraphPin::CreatePin(Owner);
+		Pin->Direction = Direction;
+		Pin->PinType.PinCategory = Category;
+		Pin->PinType.PinSubCategoryObject = Struct;
+		Owner->Pins.Add(Pin);
+		return Pin;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGDataBankAccessNodeTest, "OccamsGamekit.OGCore.OGPolymorphicDataBank.K2NodeAccess",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOGDataBankAccessNodeTest::RunTest(const FString& Parameters)
+{
+	using namespace OGDataBankAccessTest;
+
+	//Test 1: The inner struct of a bank type resolves without an instance, and is stable across calls
+	{
+		TestNull(TEXT("The abstract base has no inner struct"), FOGPolymorphicDataBankBase::GetInnerStructForBankType(FOGPolymorphicDataBankBase::StaticStruct()));
+		TestNull(TEXT("A non bank struct has no inner struct"), FOGPolymorphicDataBankBase::GetInnerStructForBankType(FOGTestPolymorphicData_Int::StaticStruct()));
+		TestTrue(TEXT("A concrete bank resolves its inner struct"),
+			FOGPolymorphicDataBankBase::GetInnerStructForBankType(FOGTestDataBank::StaticStruct()) == FOGTestPolymorphicData_Base::StaticStruct());
+		TestTrue(TEXT("A cached lookup returns the same inner struct"),
+			FOGPolymorphicDataBankBase::GetInnerStructForBankType(FOGTestDataBank::StaticStruct()) == FOGTestPolymorphicData_Base::StaticStruct());
+	}
+
+	UEdGraph* Graph = NewObject<UEdGraph>(GetTransientPackage());
+	Graph->Schema = UEdGraphSchema_K2::StaticClass();
+
+	UK2Node_OGDataBankAccess* Node = NewObject<UK2Node_OGDataBankAccess>(Graph);
+	Graph->AddNode(Node, false, false);
+	Node->AllocateDefaultPins();
+
+	UK2Node_OGDataBankAccess* Scratch = NewObject<UK2Node_OGDataBankAccess>(Graph);
+	Graph->AddNode(Scratch, false, false);
+
+	//Test 2: A fresh node has an untyped value pin and fails validation until an entry type is connected
+	{
+		TestEqual(TEXT("Value pin starts as a wildcard"), Node->GetValuePin()->PinType.PinCategory, UEdGraphSchema_K2::PC_Wildcard);
+		TestNull(TEXT("Get has no found pin"), Node->GetFoundPin());
+
+		FCompilerResultsLog MessageLog(false);
+		Node->ValidateNodeDuringCompilation(MessageLog);
+		TestEqual(TEXT("Missing entry type is a compile error"), MessageLog.NumErrors, 1);
+	}
+
+	//Test 3: The value pin only accepts entry structs, and once a bank is connected only ones its inner struct allows
+	{
+		FString Reason;
+		UEdGraphPin* IntPin = MakeStructPin(Scratch, EGPD_Input, UEdGraphSchema_K2::PC_Int, nullptr);
+		TestTrue(TEXT("A non struct value is rejected"), Node->IsConnectionDisallowed(Node->GetValuePin(), IntPin, Reason));
+
+		UEdGraphPin* PlainStructPin = MakeStructPin(Scratch, EGPD_Input, UEdGraphSchema_K2::PC_Struct, TBaseStructure<FVector>::Get());
+		TestTrue(TEXT("A struct that isn't an entry is rejected"), Node->IsConnectionDisallowed(Node->GetValuePin(), PlainStructPin, Reason));
+
+		UEdGraphPin* EntryPin = MakeStructPin(Scratch, EGPD_Input, UEdGraphSchema_K2::PC_Struct, FOGTestPolymorphicData_Int::StaticStruct());
+		UEdGraphPin* BaseEntryPin = MakeStructPin(Scratch, EGPD_Input, UEdGraphSchema_K2::PC_Struct, FOGPolymorphicStructBase::StaticStruct());
+		TestFalse(TEXT("An entry struct is accepted"), Node->IsConnectionDisallowed(Node->GetValuePin(), EntryPin, Reason));
+		TestFalse(TEXT("Without a bank any entry struct is accepted"), Node->IsConnectionDisallowed(Node->GetValuePin(), BaseEntryPin, Reason));
+
+		UEdGraphPin* BankPin = MakeStructPin(Scratch, EGPD_Output, UEdGraphSchema_K2::PC_Struct, FOGTestDataBank::StaticStruct());
+		BankPin->MakeLinkTo(Node->GetDataBankPin());
+		TestFalse(TEXT("An entry derived from the inner struct is accepted"), Node->IsConnectionDisallowed(Node->GetValuePin(), EntryPin, Reason));
+		TestTrue(TEXT("An entry outside the inner struct is rejected"), Node->IsConnectionDisallowed(Node->GetValuePin(), BaseEntryPin, Reason));
+	}
+
+	//Test 4: Connecting an entry struct types the value pin and makes the node valid
+	{
+		UEdGraphPin* EntryPin = MakeStructPin(Scratch, EGPD_Input, UEdGraphSchema_K2::PC_Struct, FOGTestPolymorphicData_Int::StaticStruct());
+		Node->GetValuePin()->MakeLinkTo(EntryPin);
+		Node->NotifyPinConnectionListChanged(Node->GetValuePin());
+		TestEqual(TEXT("Value pin becomes a struct"), Node->GetValuePin()->PinType.PinCategory, UEdGraphSchema_K2::PC_Struct);
+		TestTrue(TEXT("Value pin takes the connected entry type"), Node->GetValuePin()->PinType.PinSubCategoryObject == FOGTestPolymorphicData_Int::StaticStruct());
+
+		FCompilerResultsLog MessageLog(false);
+		Node->ValidateNodeDuringCompilation(MessageLog);
+		TestEqual(TEXT("A typed node against a matching bank compiles"), MessageLog.NumErrors, 0);
+
+		Node->GetValuePin()->BreakAllPinLinks();
+		Node->NotifyPinConnectionListChanged(Node->GetValuePin());
+		TestEqual(TEXT("Disconnecting reverts the value pin to a wildcard"), Node->GetValuePin()->PinType.PinCategory, UEdGraphSchema_K2::PC_Wildcard);
+	}
+
+	//Test 5: An entry type the connected bank can't hold is a compile error
+	{
+		UEdGraphPin* BaseEntryPin = MakeStructPin(Scratch, EGPD_Input, UEdGraphSchema_K2::PC_Struct, FOGPolymorphicStructBase::StaticStruct());
+		Node->GetValuePin()->MakeLinkTo(BaseEntryPin);
+		Node->NotifyPinConnectionListChanged(Node->GetValuePin());
+
+		FCompilerResultsLog MessageLog(false);
+		Node->ValidateNodeDuringCompilation(MessageLog);
+		TestEqual(TEXT("Mismatched entry type is a compile error"), MessageLog.NumErrors, 1);
+	}
+
+	Graph->RemoveNode(Node);
+	Graph->RemoveNode(Scratch);
+
+	// Make the test pass by returning true, or fail by returning false.
+	return true;
+}
+
+#endif
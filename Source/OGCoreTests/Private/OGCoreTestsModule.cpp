@@ -1,5 +1,14 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#include "OGCoreTestsModule.h"
-	
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGCoreTestsModule.h"
+
+#include "OGCoreModule.h"
+#include "PolymorphicDataBankBenchmark.h"
+
+void FOGCoreTestsModule::StartupModule()
+{
+	// The benchmark types come in large numbers and have their own StructCache, keep them from shifting every other key
+	FOGCoreModule::ExcludeFromUniversalStructCache(FOGBenchData_Base::StaticStruct());
+}
+	
 IMPLEMENT_MODULE(FOGCoreTestsModule, OGCoreTests)
\ No newline at end of file
@@ -0,0 +1,331 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGDataBankSoakTest.h"
+
+#include "OGFunctionalTestRPCBridge.h"
+#include "OGPolymorphicDataBankNetStats.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Net/UnrealNetwork.h"
+#include "Serialization/JsonSerializer.h"
+
+static double GetPercentile(TArray<double> Values, const double Percentile)
+{
+	if (Values.IsEmpty())
+		return 0;
+	Values.Sort();
+	return Values[FMath::Clamp(FMath::FloorToInt32(Percentile * (Values.Num() - 1)), 0, Values.Num() - 1)];
+}
+
+AOGDataBankSoakTest::AOGDataBankSoakTest()
+{
+	TimeLimit = 0.f;
+}
+
+void AOGDataBankSoakTest::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ThisClass, SoakBank);
+}
+
+void AOGDataBankSoakTest::StartTest()
+{
+	Super::StartTest();
+	if (!HasAuthority())
+		return;
+
+	Clients.Reset();
+	for (const auto& [Controller, Bridge] : ServerRPCBridges)
+	{
+		FClientResults& Results = Clients.Add(Bridge);
+		Results.Name = GetNameSafe(Controller);
+	}
+	Sequence = 0;
+	SentTimes.Reset();
+	SoakBank.Empty();
+	MutationBudget = 0;
+
+	ApplyNetworkConditions();
+	CaptureConnectionStats(true);
+#if OG_DATABANK_NETSTATS
+	ServerSerializeStartSeconds = FOGDataBankNetStats::Get().GetSerializeSeconds(FOGDataBankNetStats::EDirection::Sent);
+#endif
+	Phase = EPhase::Mutating;
+	PhaseStartTime = FPlatformTime::Seconds();
+}
+
+void AOGDataBankSoakTest::ClientStartTest()
+{
+	//The server starts counting from 0 again, anything higher from an earlier run would hide this run's sequences
+	LastReceivedSequence = 0;
+}
+
+void AOGDataBankSoakTest::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (!HasAuthority() || Phase == EPhase::Idle)
+		return;
+
+	const double PhaseTime = FPlatformTime::Seconds() - PhaseStartTime;
+	switch (Phase)
+	{
+	case EPhase::Mutating:
+		MutationBudget += DeltaSeconds * MutationsPerSecond;
+		while (MutationBudget >= 1)
+		{
+			Mutate();
+			MutationBudget -= 1;
+		}
+		if (PhaseTime >= DurationSeconds)
+		{
+			Phase = EPhase::Settling;
+			PhaseStartTime = FPlatformTime::Seconds();
+		}
+		break;
+	case EPhase::Settling:
+		if (PhaseTime >= SettleSeconds)
+		{
+			CaptureConnectionStats(false);
+			RPC_RequestClientResults();
+			Phase = EPhase::Collecting;
+			PhaseStartTime = FPlatformTime::Seconds();
+		}
+		break;
+	case EPhase::Collecting:
+		{
+			bool bAllFinished = true;
+			for (const auto& [Bridge, Results] : Clients)
+			{
+				bAllFinished &= Results.bFinished;
+			}
+			if (bAllFinished || PhaseTime >= CollectTimeoutSeconds)
+			{
+				FinishSoak();
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void AOGDataBankSoakTest::Mutate()
+{
+	++Sequence;
+	SentTimes.Add(FPlatformTime::Seconds());
+
+	FOGTestPolymorphicData_Int IntData;
+	IntData.TestInt = Sequence;
+	SoakBank.SetByCopy(IntData);
+
+	if (EntriesPerMutation >= 2)
+	{
+		FOGTestPolymorphicData_String StringData;
+		StringData.TestString = FString::Printf(TEXT("Soak mutation %d"), Sequence);
+		SoakBank.SetByCopy(StringData);
+	}
+
+	if (EntriesPerMutation >= 3)
+	{
+		//A new actor every time, its channel usually opens after the bank arrives so the client has to resolve it later
+		if (AActor* Previous = LastReferencedActor.Get())
+		{
+			Previous->Destroy();
+		}
+		AActor* Referenced = GetWorld()->SpawnActor<AActor>();
+		Referenced->SetReplicates(true);
+		Referenced->bAlwaysRelevant = true;
+		LastReferencedActor = Referenced;
+
+		FOGTestPolymorphicData_Actor ActorData;
+		ActorData.TestActor = Referenced;
+		SoakBank.SetByCopy(ActorData);
+	}
+}
+
+void AOGDataBankSoakTest::OnRep_SoakBank()
+{
+	const FOGTestPolymorphicData_Int* IntData = SoakBank.FindConst<FOGTestPolymorphicData_Int>();
+	if (!IntData || IntData->TestInt <= LastReceivedSequence || !ClientRPCBridge)
+		return;
+	LastReceivedSequence = IntData->TestInt;
+	ClientRPCBridge->RPC_ReportMetric(TEXT("Ack"), LastReceivedSequence);
+}
+
+void AOGDataBankSoakTest::RPC_RequestClientResults_Implementation()
+{
+	if (HasAuthority() || !ClientRPCBridge)
+		return;
+#if OG_DATABANK_NETSTATS
+	const FOGDataBankNetStats& NetStats = FOGDataBankNetStats::Get();
+	const FOGDataBankNetStats::FCounters Received = NetStats.GetTotals(FOGDataBankNetStats::EDirection::Received);
+	ClientRPCBridge->RPC_ReportMetric(TEXT("GuidResolutions"), NetStats.GetNumGuidResolutions());
+	ClientRPCBridge->RPC_ReportMetric(TEXT("BankBytesReceived"), (Received.GetTotalBits() + 7) / 8);
+	ClientRPCBridge->RPC_ReportMetric(TEXT("BankReceiveSerializeMs"), NetStats.GetSerializeSeconds(FOGDataBankNetStats::EDirection::Received) * 1000.0);
+#endif
+	ClientRPCBridge->RPC_ReportMetric(TEXT("LastReceivedSequence"), LastReceivedSequence);
+	//Reliable RPCs on one actor arrive in order, so this is the last one
+	ClientRPCBridge->RPC_ReportMetric(TEXT("Finished"), 1);
+}
+
+void AOGDataBankSoakTest::ReceiveClientMetric(AOGFunctionalTestRPCBridge* Bridge, const FString& Name, double Value)
+{
+	FClientResults* Results = Clients.Find(Bridge);
+	if (!Results)
+		return;
+
+	if (Name == TEXT("Ack"))
+	{
+		const int32 Acknowledged = static_cast<int32>(Value);
+		if (Acknowledged > Results->LastAcknowledged && SentTimes.IsValidIndex(Acknowledged - 1))
+		{
+			Results->LastAcknowledged = Acknowledged;
+			Results->ConvergeMs.Add((FPlatformTime::Seconds() - SentTimes[Acknowledged - 1]) * 1000.0);
+		}
+	}
+	else if (Name == TEXT("Finished"))
+	{
+		Results->bFinished = true;
+	}
+	else
+	{
+		Results->Reported.Add(Name, Value);
+	}
+}
+
+void AOGDataBankSoakTest::ApplyNetworkConditions()
+{
+#if DO_ENABLE_NET_TEST
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!ensure(NetDriver))
+		return;
+	SavedSimulationSettings = NetDriver->PacketSimulationSettings;
+	FPacketSimulationSettings Settings = SavedSimulationSettings;
+	Settings.PktLag = NetworkConditions.PacketLagMs;
+	Settings.PktLagVariance = NetworkConditions.PacketLagVarianceMs;
+	Settings.PktLoss = NetworkConditions.PacketLossPercent;
+	Settings.PktOrder = NetworkConditions.bReorderPackets ? 1 : 0;
+	NetDriver->SetPacketSimulationSettings(Settings);
+#else
+	LogStep(ELogVerbosity::Warning, TEXT("Packet emulation is not available in this build, running without it"));
+#endif
+}
+
+void AOGDataBankSoakTest::RestoreNetworkConditions()
+{
+#if DO_ENABLE_NET_TEST
+	if (UNetDriver* NetDriver = GetWorld()->GetNetDriver())
+	{
+		NetDriver->SetPacketSimulationSettings(SavedSimulationSettings);
+	}
+#endif
+}
+
+void AOGDataBankSoakTest::CaptureConnectionStats(const bool bIsStart)
+{
+	for (const auto& [Controller, Bridge] : ServerRPCBridges)
+	{
+		FClientResults* Results = Clients.Find(Bridge);
+		const APlayerController* PlayerController = Cast<APlayerController>(Controller);
+		const UNetConnection* Connection = PlayerController ? PlayerController->GetNetConnection() : nullptr;
+		if (!Results || !Connection)
+			continue;
+		if (bIsStart)
+		{
+			Results->StartOutBytes = Connection->OutTotalBytes;
+			Results->StartOutPacketsLost = Connection->OutTotalPacketsLost;
+		}
+		else
+		{
+			Results->OutBytes = Connection->OutTotalBytes - Results->StartOutBytes;
+			Results->OutPacketsLost = Connection->OutTotalPacketsLost - Results->StartOutPacketsLost;
+		}
+	}
+}
+
+void AOGDataBankSoakTest::FinishSoak()
+{
+	Phase = EPhase::Idle;
+	RestoreNetworkConditions();
+	if (AActor* Previous = LastReferencedActor.Get())
+	{
+		Previous->Destroy();
+	}
+	WriteResults();
+
+	TArray<FString> Lagging;
+	for (const auto& [Bridge, Results] : Clients)
+	{
+		if (!Results.bFinished || Results.LastAcknowledged != Sequence)
+		{
+			Lagging.Add(FString::Printf(TEXT("%s (acknowledged %d of %d)"), *Results.Name, Results.LastAcknowledged, Sequence));
+		}
+	}
+	if (Lagging.IsEmpty())
+	{
+		FinishTest(EFunctionalTestResult::Succeeded, FString::Printf(TEXT("%d mutations converged on %d clients"), Sequence, Clients.Num()));
+	}
+	else
+	{
+		FinishTest(EFunctionalTestResult::Failed, FString::Printf(TEXT("Clients did not converge: %s"), *FString::Join(Lagging, TEXT(", "))));
+	}
+}
+
+void AOGDataBankSoakTest::WriteResults()
+{
+	const double MutatingSeconds = FMath::Max(DurationSeconds + SettleSeconds, UE_SMALL_NUMBER);
+	TArray<TSharedPtr<FJsonValue>> JsonClients;
+	for (const auto& [Bridge, Results] : Clients)
+	{
+		TSharedRef<FJsonObject> JsonClient = MakeShared<FJsonObject>();
+		JsonClient->SetStringField(TEXT("Client"), Results.Name);
+		JsonClient->SetNumberField(TEXT("BytesSent"), Results.OutBytes);
+		JsonClient->SetNumberField(TEXT("KbpsSent"), Results.OutBytes * 8.0 / 1000.0 / MutatingSeconds);
+		JsonClient->SetNumberField(TEXT("PacketsLost"), Results.OutPacketsLost);
+		JsonClient->SetNumberField(TEXT("Acknowledged"), Results.LastAcknowledged);
+		JsonClient->SetNumberField(TEXT("ConvergeSamples"), Results.ConvergeMs.Num());
+		JsonClient->SetNumberField(TEXT("ConvergeP50Ms"), GetPercentile(Results.ConvergeMs, 0.5));
+		JsonClient->SetNumberField(TEXT("ConvergeP90Ms"), GetPercentile(Results.ConvergeMs, 0.9));
+		JsonClient->SetNumberField(TEXT("ConvergeP99Ms"), GetPercentile(Results.ConvergeMs, 0.99));
+		JsonClient->SetNumberField(TEXT("ConvergeMaxMs"), GetPercentile(Results.ConvergeMs, 1.0));
+		JsonClient->SetBoolField(TEXT("Finished"), Results.bFinished);
+		for (const auto& [Name, Value] : Results.Reported)
+		{
+			JsonClient->SetNumberField(Name, Value);
+		}
+		JsonClients.Add(MakeShared<FJsonValueObject>(JsonClient));
+	}
+
+	TSharedRef<FJsonObject> JsonRoot = MakeShared<FJsonObject>();
+	JsonRoot->SetStringField(TEXT("Test"), GetName());
+	JsonRoot->SetStringField(TEXT("BuildVersion"), FApp::GetBuildVersion());
+	JsonRoot->SetNumberField(TEXT("DurationSeconds"), DurationSeconds);
+	JsonRoot->SetNumberField(TEXT("MutationsPerSecond"), MutationsPerSecond);
+	JsonRoot->SetNumberField(TEXT("EntriesPerMutation"), EntriesPerMutation);
+	JsonRoot->SetNumberField(TEXT("Mutations"), Sequence);
+	JsonRoot->SetNumberField(TEXT("PacketLagMs"), NetworkConditions.PacketLagMs);
+	JsonRoot->SetNumberField(TEXT("PacketLagVarianceMs"), NetworkConditions.PacketLagVarianceMs);
+	JsonRoot->SetNumberField(TEXT("PacketLossPercent"), NetworkConditions.PacketLossPercent);
+	JsonRoot->SetBoolField(TEXT("ReorderPackets"), NetworkConditions.bReorderPackets);
+	//Only what the server sends is emulated, see the class comment
+	JsonRoot->SetStringField(TEXT("PacketEmulation"), TEXT("ServerToClientOnly"));
+#if OG_DATABANK_NETSTATS
+	JsonRoot->SetNumberField(TEXT("ServerBankSerializeMs"),
+		(FOGDataBankNetStats::Get().GetSerializeSeconds(FOGDataBankNetStats::EDirection::Sent) - ServerSerializeStartSeconds) * 1000.0);
+#endif
+	JsonRoot->SetArrayField(TEXT("Clients"), JsonClients);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(JsonRoot, JsonWriter);
+
+	const FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("OGCore"), TEXT("Soak"),
+		FString::Printf(TEXT("%s_%s.json"), *GetName(), *FDateTime::Now().ToString()));
+	FFileHelper::SaveStringToFile(Json, *OutputPath);
+	LogStep(ELogVerbosity::Log, FString::Printf(TEXT("Soak results written to %s"), *FPaths::ConvertRelativePathToFull(OutputPath)));
+}
@@ -0,0 +1,136 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGHandle.h"
+#include "OGSlotMap.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+struct FOGTestSlotTag;
+using FOGTestSlotHandle = TOGHandle<FOGTestSlotTag>;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGSlotMapTest, "OccamsGamekit.OGCore.OGHandle.SlotMap",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOGSlotMapTest::RunTest(const FString& Parameters)
+{
+	//Test 1: Added values resolve through their handles
+	{
+		TOGSlotMap<FOGTestSlotHandle, int32> SlotMap;
+		const FOGTestSlotHandle First = SlotMap.Add(1);
+		const FOGTestSlotHandle Second = SlotMap.Add(2);
+		TestTrue(TEXT("Issued handles are valid"), First.IsValid() && Second.IsValid());
+		TestTrue(TEXT("Issued handles are distinct"), First != Second);
+		TestEqual(TEXT("First handle resolves to its value"), *SlotMap.Find(First), 1);
+		TestEqual(TEXT("Second handle resolves to its value"), *SlotMap.Find(Second), 2);
+		TestNull(TEXT("The empty handle resolves to nothing"), SlotMap.Find(FOGTestSlotHandle::EmptyHandle()));
+	}
+
+	//Test 2: Removal keeps the values dense and leaves stale handles unresolvable, even after the slot is reused
+	{
+		TOGSlotMap<FOGTestSlotHandle, int32> SlotMap;
+		const FOGTestSlotHandle First = SlotMap.Add(1);
+		const FOGTestSlotHandle Second = SlotMap.Add(2);
+		TestTrue(TEXT("Removing a live handle succeeds"), SlotMap.Remove(First));
+		TestFalse(TEXT("Removing it again fails"), SlotMap.Remove(First));
+		TestEqual(TEXT("Values stay dense"), SlotMap.GetValues().Num(), 1);
+		TestEqual(TEXT("Swapped value still resolves"), *SlotMap.Find(Second), 2);
+
+		const FOGTestSlotHandle Reused = SlotMap.Add(3);
+		constexpr OGHandleIdType IndexMask = TOGSlotMap<FOGTestSlotHandle, int32>::MaxSlots - 1;
+		TestTrue(TEXT("Freed slot is reused"), (Reused.GetHandleId() & IndexMask) == (First.GetHandleId() & IndexMask));
+		TestNull(TEXT("Stale handle does not resolve to the reused slot"), SlotMap.Find(First));
+		TestEqual(TEXT("New handle resolves"), *SlotMap.Find(Reused), 3);
+		TestTrue(TEXT("Dense handle lookup matches"), SlotMap.GetHandleAt(0) == Second);
+	}
+
+	//Test 3: Bulk generation reserves consecutive ids
+	{
+		TArray<FOGTestSlotHandle> Handles;
+		FOGTestSlotHandle::GenerateHandles(16, Handles);
+		TestEqual(TEXT("All handles generated"), Handles.Num(), 16);
+		TestTrue(TEXT("Ids are consecutive"), Handles.Last().GetHandleId() - Handles[0].GetHandleId() == 15);
+		TestFalse(TEXT("Single generation doesn't reuse a bulk id"), Handles.Contains(FOGTestSlotHandle::GenerateHandle()));
+	}
+
+	//Test 4: Freed slots are reused oldest first, and a slot whose generations run out is retired instead of wrapping
+	{
+		TOGSlotMap<FOGTestSlotHandle, int32> SlotMap;
+		constexpr OGHandleIdType IndexMask = TOGSlotMap<FOGTestSlotHandle, int32>::MaxSlots - 1;
+		const FOGTestSlotHandle First = SlotMap.Add(1);
+		const FOGTestSlotHandle Second = SlotMap.Add(2);
+		SlotMap.Remove(First);
+		SlotMap.Remove(Second);
+		TestTrue(TEXT("The slot freed first is reused first"), (SlotMap.Add(3).GetHandleId() & IndexMask) == (First.GetHandleId() & IndexMask));
+
+		TOGSlotMap<FOGTestSlotHandle, int32> CyclingMap;
+		const FOGTestSlotHandle Original = CyclingMap.Add(0);
+		FOGTestSlotHandle Latest = Original;
+		bool bAlwaysReused = true;
+		constexpr uint32 NumGenerations = (1u << TOGSlotMap<FOGTestSlotHandle, int32>::GenerationBits) - 1;
+		for (uint32 Cycle = 1; Cycle < NumGenerations; ++Cycle)
+		{
+			CyclingMap.Remove(Latest);
+			Latest = CyclingMap.Add(static_cast<int32>(Cycle));
+			bAlwaysReused &= (Latest.GetHandleId() & IndexMask) == (Original.GetHandleId() & IndexMask);
+		}
+		TestTrue(TEXT("A single free slot is reused for every generation"), bAlwaysReused);
+		CyclingMap.Remove(Latest);
+		const FOGTestSlotHandle AfterExhaustion = CyclingMap.Add(-1);
+		TestTrue(TEXT("The exhausted slot is retired"), (AfterExhaustion.GetHandleId() & IndexMask) != (Original.GetHandleId() & IndexMask));
+		TestNull(TEXT("The original handle never resolves again"), CyclingMap.Find(Original));
+		TestNull(TEXT("Nor does the last handle of the retired slot"), CyclingMap.Find(Latest));
+		TestEqual(TEXT("The new handle resolves"), *CyclingMap.Find(AfterExhaustion), -1);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGHandleNetSerializeTest, "OccamsGamekit.OGCore.OGHandle.NetSerialize",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOGHandleNetSerializeTest::RunTest(const FString& Parameters)
+{
+	//Test 1: Ids cost a fixed 6 bit length prefix plus only their significant bits
+	{
+		OGHandleIdType SmallId = 5;
+		OGHandleIdType LargeId = MAX_uint32;
+		OGHandleIdType InvalidId = 0;
+
+		FBitWriter SmallWriter(0, true);
+		OGHandle::NetSerializeId(SmallWriter, SmallId);
+		TestEqual(TEXT("Small id costs the prefix and three bits"), SmallWriter.GetNumBits(), 9ll);
+
+		FBitWriter LargeWriter(0, true);
+		OGHandle::NetSerializeId(LargeWriter, LargeId);
+		TestEqual(TEXT("Large id costs the prefix and 32 bits"), LargeWriter.GetNumBits(), 38ll);
+
+		FBitWriter InvalidWriter(0, true);
+		OGHandle::NetSerializeId(InvalidWriter, InvalidId);
+		TestEqual(TEXT("Invalid id costs only the prefix"), InvalidWriter.GetNumBits(), 6ll);
+	}
+
+	//Test 2: Ids round trip back to back in one stream
+	{
+		FBitWriter Writer(0, true);
+		OGHandleIdType SmallId = 5;
+		OGHandleIdType LargeId = MAX_uint32;
+		OGHandleIdType InvalidId = 0;
+		OGHandle::NetSerializeId(Writer, SmallId);
+		OGHandle::NetSerializeId(Writer, LargeId);
+		OGHandle::NetSerializeId(Writer, InvalidId);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		OGHandleIdType ReadId = 0;
+		OGHandle::NetSerializeId(Reader, ReadId);
+		TestTrue(TEXT("Small id round trips"), ReadId == SmallId);
+		OGHandle::NetSerializeId(Reader, ReadId);
+		TestTrue(TEXT("Large id round trips"), ReadId == LargeId);
+		OGHandle::NetSerializeId(Reader, ReadId);
+		TestTrue(TEXT("Invalid id round trips"), ReadId == InvalidId);
+		TestFalse(TEXT("Reader did not overflow"), Reader.IsError());
+		TestEqual(TEXT("Everything written was read"), Reader.GetPosBits(), Writer.GetNumBits());
+	}
+
+	return true;
+}
@@ -0,0 +1,467 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "PolymorphicDataBankBenchmark.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/NetSerialization.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/CoreNet.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+FOGPolymorphicStructCache* GetBenchStructCache()
+{
+	static FOGPolymorphicStructCache BenchStructCache;
+	BenchStructCache.InitTypeCache(FOGBenchData_Base::StaticStruct());
+	return &BenchStructCache;
+}
+
+/**
+ * CPU microbenchmarks for FOGPolymorphicDataBankBase.
+ *
+ * Every operation runs for each entry shape (plain data, strings, object references) and bank size (1, 4, 16, 64 entries).
+ * Timings are per call of the operation on the whole bank, e.g. Find on a 16 entry bank is 16 Find calls.
+ * Results are logged and written as CSV and JSON to Saved/Benchmarks/OGCore/<Timestamp>/<Operation>.csv|json
+ * so runs of different versions can be compared.
+ *
+ * Running headless (e.g. on Linux CI):
+ *   UnrealEditor-Cmd <Project>.uproject -ExecCmds="Automation RunTests OccamsGamekit.OGCore.OGPolymorphicDataBank.Benchmark;Quit" -nullrhi -unattended -nosplash -nosound -stdout
+ *
+ * Optional command line parameters:
+ *   -OGBenchSamples=<N>   timed samples per case (default 200)
+ *   -OGBenchWarmup=<N>    untimed warmup runs per case (default 20)
+ *   -OGBenchOutput=<Dir>  output directory, replaces Saved/Benchmarks/OGCore/<Timestamp>
+ */
+namespace OGBenchmark
+{
+	static const TCHAR* Operations[] = {
+		TEXT("AddUnique"),
+		TEXT("Find"),
+		TEXT("GetConstChecked"),
+		TEXT("SetByCopy"),
+		TEXT("Remove"),
+		TEXT("CopyConstruct"),
+		TEXT("Assign"),
+		TEXT("Empty"),
+		TEXT("AddStructReferencedObjects"),
+		TEXT("NetSerializeWrite"),
+		TEXT("NetSerializeRead"),
+		TEXT("NetDeltaSerializeWriteFull"),
+		TEXT("NetDeltaSerializeWriteOneChanged"),
+		TEXT("NetDeltaSerializeRead"),
+	};
+
+	static const int32 BankSizes[] = {1, 4, 16, OG_BENCH_MAX_ENTRIES};
+
+	struct FSettings
+	{
+		int32 Samples = 200;
+		int32 Warmup = 20;
+		FString OutputDir;
+
+		static FSettings FromCommandLine()
+		{
+			static const FString RunTimestamp = FDateTime::Now().ToString();
+			FSettings Settings;
+			FParse::Value(FCommandLine::Get(), TEXT("OGBenchSamples="), Settings.Samples);
+			FParse::Value(FCommandLine::Get(), TEXT("OGBenchWarmup="), Settings.Warmup);
+			if (!FParse::Value(FCommandLine::Get(), TEXT("OGBenchOutput="), Settings.OutputDir))
+			{
+				Settings.OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("OGCore"), RunTimestamp);
+			}
+			Settings.Samples = FMath::Max(1, Settings.Samples);
+			Settings.Warmup = FMath::Max(0, Settings.Warmup);
+			return Settings;
+		}
+	};
+
+	struct FCaseResult
+	{
+		FString Operation;
+		FString Shape;
+		int32 NumEntries = 0;
+		int32 NumSamples = 0;
+		double MinNs = 0;
+		double MeanNs = 0;
+		double P50Ns = 0;
+		double P90Ns = 0;
+		double P99Ns = 0;
+		double MaxNs = 0;
+		//Size of the serialized bank for the serialization benchmarks
+		int64 PayloadBits = 0;
+	};
+
+	template<typename... Ts>
+	struct TTypeList {};
+
+	using FPODTypes = TTypeList<OG_BENCH_POD_TYPES>;
+	using FStringTypes = TTypeList<OG_BENCH_STRING_TYPES>;
+	using FObjectTypes = TTypeList<OG_BENCH_OBJECT_TYPES>;
+
+	// Calls Func.template operator()<T>() for the first Num types of the list
+	template<typename... Ts, typename FuncType>
+	void ForFirstN(TTypeList<Ts...>, const int32 Num, FuncType&& Func)
+	{
+		int32 Index = 0;
+		((Index++ < Num ? Func.template operator()<Ts>() : void()), ...);
+	}
+
+	// Keeps the compiler from discarding the results of the benchmarked calls
+	static volatile UPTRINT Sink = 0;
+	FORCENOINLINE void Consume(const void* Ptr)
+	{
+		Sink = Sink ^ reinterpret_cast<UPTRINT>(Ptr);
+	}
+
+	void FillEntry(FOGBenchPOD_Base& Entry, const UScriptStruct* Type)
+	{
+		Entry.Location = FVector(1.0, 2.0, 3.0);
+		Entry.Scalar = 0.5f;
+		Entry.Count = Type->GetStructureSize();
+		Entry.Flags = 0x5;
+	}
+
+	void FillEntry(FOGBenchString_Base& Entry, const UScriptStruct* Type)
+	{
+		Entry.Name = Type->GetName();
+		Entry.Description = FString::ChrN(64, TEXT('x'));
+		Entry.Values = {1, 2, 3, 4, 5, 6, 7, 8};
+	}
+
+	void FillEntry(FOGBenchObject_Base& Entry, const UScriptStruct* Type)
+	{
+		Entry.Primary = const_cast<UScriptStruct*>(Type);
+		Entry.Secondary = GetTransientPackage();
+		Entry.Others = {GetTransientPackage(), FOGBenchData_Base::StaticStruct(), FOGPolymorphicStructBase::StaticStruct(), UObject::StaticClass()};
+	}
+
+	// One filled instance per entry type, used as the source for SetByCopy
+	template<typename T>
+	const T& GetSource()
+	{
+		static const T Source = []()
+		{
+			T NewSource;
+			FillEntry(NewSource, T::StaticStruct());
+			return NewSource;
+		}();
+		return Source;
+	}
+
+	template<typename BankType, typename... Ts>
+	void FillBank(BankType& Bank, TTypeList<Ts...> Types, const int32 NumEntries)
+	{
+		ForFirstN(Types, NumEntries, [&Bank]<typename T>()
+		{
+			FillEntry(Bank.template AddUnique<T>(), T::StaticStruct());
+		});
+	}
+
+	// Counts references instead of marking anything, so the cost is the bank's traversal
+	class FReferenceCounter : public FReferenceCollector
+	{
+	public:
+		virtual void HandleObjectReference(UObject*& InObject, const UObject* InReferencingObject, const FProperty* InReferencingProperty) override
+		{
+			NumReferences += InObject ? 1 : 0;
+		}
+		virtual bool IsIgnoringArchetypeRef() const override { return false; }
+		virtual bool IsIgnoringTransient() const override { return false; }
+
+		int64 NumReferences = 0;
+	};
+
+	// Forwards struct serialization straight to the entry's native NetSerialize, standing in for the net driver's RepLayout
+	class FNativeNetSerializeCB : public INetSerializeCB
+	{
+	public:
+		virtual void NetSerializeStruct(FNetDeltaSerializeInfo& Params) override
+		{
+			FBitArchive& Ar = Params.Reader ? static_cast<FBitArchive&>(*Params.Reader) : static_cast<FBitArchive&>(*Params.Writer);
+			const UScriptStruct* Struct = CastChecked<UScriptStruct>(Params.Struct);
+			bool bSuccess = true;
+			Struct->GetCppStructOps()->NetSerialize(Ar, Params.Map, bSuccess, Params.Data);
+		}
+		virtual void GatherGuidReferencesForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool MoveGuidToUnmappedForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+		virtual void UpdateUnmappedGuidsForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool NetDeltaSerializeForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+	};
+
+	// Runs Setup untimed and Body timed, Repeats times per sample for operations too fast to time individually
+	template<typename SetupType, typename BodyType>
+	FCaseResult Measure(const FSettings& Settings, const TCHAR* Operation, const TCHAR* Shape, const int32 NumEntries,
+		const int32 Repeats, SetupType&& Setup, BodyType&& Body)
+	{
+		TArray<double> SamplesNs;
+		SamplesNs.Reserve(Settings.Samples);
+		for (int32 Run = 0; Run < Settings.Warmup + Settings.Samples; ++Run)
+		{
+			Setup();
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+			{
+				Body();
+			}
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+			if (Run >= Settings.Warmup)
+			{
+				SamplesNs.Add(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000000.0 / Repeats);
+			}
+		}
+		SamplesNs.Sort();
+
+		const auto Percentile = [&SamplesNs](const double Fraction)
+		{
+			return SamplesNs[FMath::Clamp(FMath::FloorToInt32((SamplesNs.Num() - 1) * Fraction), 0, SamplesNs.Num() - 1)];
+		};
+
+		FCaseResult Result;
+		Result.Operation = Operation;
+		Result.Shape = Shape;
+		Result.NumEntries = NumEntries;
+		Result.NumSamples = SamplesNs.Num();
+		Result.MinNs = SamplesNs[0];
+		Result.MaxNs = SamplesNs.Last();
+		double Total = 0;
+		for (const double Sample : SamplesNs)
+		{
+			Total += Sample;
+		}
+		Result.MeanNs = Total / SamplesNs.Num();
+		Result.P50Ns = Percentile(0.5);
+		Result.P90Ns = Percentile(0.9);
+		Result.P99Ns = Percentile(0.99);
+		return Result;
+	}
+
+	template<typename... Ts>
+	void RunShape(TTypeList<Ts...> Types, const TCHAR* Shape, const FString& Operation, const FSettings& Settings, UPackageMap* PackageMap, TArray<FCaseResult>& OutResults)
+	{
+		FNativeNetSerializeCB NetSerializeCB;
+
+		for (const int32 NumEntries : BankSizes)
+		{
+			//Enough repeats that a sample of the cheap operations is well above timer resolution
+			const int32 Repeats = FMath::Max(1, 256 / NumEntries);
+
+			FOGBenchDataBank Bank;
+			FillBank(Bank, Types, NumEntries);
+			FOGBenchDataBank Target;
+
+			if (Operation == TEXT("AddUnique"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Target.Empty(); },
+					[&]() { ForFirstN(Types, NumEntries, [&Target]<typename T>() { Consume(&Target.template AddUnique<T>()); }); }));
+			}
+			else if (Operation == TEXT("Find"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, Repeats,
+					[]() {},
+					[&]() { ForFirstN(Types, NumEntries, [&Bank]<typename T>() { Consume(Bank.template Find<T>()); }); }));
+			}
+			else if (Operation == TEXT("GetConstChecked"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, Repeats,
+					[]() {},
+					[&]() { ForFirstN(Types, NumEntries, [&Bank]<typename T>() { Consume(&Bank.template GetConstChecked<T>()); }); }));
+			}
+			else if (Operation == TEXT("SetByCopy"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, Repeats,
+					[]() {},
+					[&]() { ForFirstN(Types, NumEntries, [&Bank]<typename T>() { Bank.SetByCopy(GetSource<T>()); }); }));
+			}
+			else if (Operation == TEXT("Remove"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Target.Empty(); FillBank(Target, Types, NumEntries); },
+					[&]() { ForFirstN(Types, NumEntries, [&Target]<typename T>() { Target.template Remove<T>(); }); }));
+			}
+			else if (Operation == TEXT("CopyConstruct"))
+			{
+				TOptional<FOGBenchDataBank> Copy;
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Copy.Reset(); },
+					[&]() { Copy.Emplace(Bank); }));
+			}
+			else if (Operation == TEXT("Assign"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Target.Empty(); },
+					[&]() { Target = Bank; }));
+			}
+			else if (Operation == TEXT("Empty"))
+			{
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Target.Empty(); FillBank(Target, Types, NumEntries); },
+					[&]() { Target.Empty(); }));
+			}
+			else if (Operation == TEXT("AddStructReferencedObjects"))
+			{
+				FReferenceCounter Collector;
+				OutResults.Add(Measure(Settings, *Operation, Shape, NumEntries, Repeats,
+					[]() {},
+					[&]() { Bank.AddStructReferencedObjects(Collector); }));
+			}
+			else if (Operation == TEXT("NetSerializeWrite"))
+			{
+				FBitWriter Writer(0, true);
+				FCaseResult& Result = OutResults.Add_GetRef(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Writer.Reset(); },
+					[&]() { bool bSuccess = true; Bank.NetSerialize(Writer, PackageMap, bSuccess); }));
+				Result.PayloadBits = Writer.GetNumBits();
+			}
+			else if (Operation == TEXT("NetSerializeRead"))
+			{
+				FBitWriter Writer(0, true);
+				bool bWriteSuccess = true;
+				Bank.NetSerialize(Writer, PackageMap, bWriteSuccess);
+
+				TOptional<FBitReader> Reader;
+				FCaseResult& Result = OutResults.Add_GetRef(Measure(Settings, *Operation, Shape, NumEntries, 1,
+					[&]() { Reader.Emplace(Writer.GetData(), Writer.GetNumBits()); },
+					[&]() { bool bSuccess = true; Target.NetSerialize(*Reader, PackageMap, bSuccess); }));
+				Result.PayloadBits = Writer.GetNumBits();
+			}
+			else if (Operation.StartsWith(TEXT("NetDeltaSerialize")))
+			{
+				FOGBenchDataBank_Delta DeltaBank;
+				FillBank(DeltaBank, Types, NumEntries);
+
+				//NetDeltaSerialize traces through the writer's net trace collector, which only exists on FNetBitWriter
+				FNetBitWriter Writer(PackageMap, 0);
+				TSharedPtr<INetDeltaBaseState> NewState;
+				const auto WriteDelta = [&](INetDeltaBaseState* OldState)
+				{
+					FNetDeltaSerializeInfo Params;
+					Params.Writer = &Writer;
+					Params.Map = PackageMap;
+					Params.NetSerializeCB = &NetSerializeCB;
+					Params.Struct = FOGBenchDataBank_Delta::StaticStruct();
+					Params.OldState = OldState;
+					Params.NewState = &NewState;
+					DeltaBank.NetDeltaSerialize(Params);
+				};
+
+				if (Operation == TEXT("NetDeltaSerializeWriteFull"))
+				{
+					FCaseResult& Result = OutResults.Add_GetRef(Measure(Settings, *Operation, Shape, NumEntries, 1,
+						[&]() { Writer.Reset(); },
+						[&]() { WriteDelta(nullptr); }));
+					Result.PayloadBits = Writer.GetNumBits();
+				}
+				else if (Operation == TEXT("NetDeltaSerializeWriteOneChanged"))
+				{
+					WriteDelta(nullptr);
+					const TSharedPtr<INetDeltaBaseState> BaseState = NewState;
+					FCaseResult& Result = OutResults.Add_GetRef(Measure(Settings, *Operation, Shape, NumEntries, 1,
+						[&]() { Writer.Reset(); ForFirstN(Types, 1, [&DeltaBank]<typename T>() { Consume(DeltaBank.template Find<T>()); }); },
+						[&]() { WriteDelta(BaseState.Get()); }));
+					Result.PayloadBits = Writer.GetNumBits();
+				}
+				else if (Operation == TEXT("NetDeltaSerializeRead"))
+				{
+					WriteDelta(nullptr);
+					FOGBenchDataBank_Delta ReadBank;
+					TOptional<FBitReader> Reader;
+					FCaseResult& Result = OutResults.Add_GetRef(Measure(Settings, *Operation, Shape, NumEntries, 1,
+						[&]() { ReadBank.Empty(); Reader.Emplace(Writer.GetData(), Writer.GetNumBits()); },
+						[&]()
+						{
+							FNetDeltaSerializeInfo Params;
+							Params.Reader = &Reader.GetValue();
+							Params.Map = PackageMap;
+							Params.NetSerializeCB = &NetSerializeCB;
+							Params.Struct = FOGBenchDataBank_Delta::StaticStruct();
+							ReadBank.NetDeltaSerialize(Params);
+						}));
+					Result.PayloadBits = Writer.GetNumBits();
+				}
+			}
+		}
+	}
+
+	void WriteResults(const FString& Operation, const FSettings& Settings, const TArray<FCaseResult>& Results)
+	{
+		FString Csv = TEXT("Operation,Shape,Entries,Samples,MinNs,MeanNs,P50Ns,P90Ns,P99Ns,MaxNs,PayloadBits\n");
+		TArray<TSharedPtr<FJsonValue>> JsonResults;
+		for (const FCaseResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("%s,%s,%d,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%lld\n"), *Result.Operation, *Result.Shape, Result.NumEntries,
+				Result.NumSamples, Result.MinNs, Result.MeanNs, Result.P50Ns, Result.P90Ns, Result.P99Ns, Result.MaxNs, Result.PayloadBits);
+
+			TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+			JsonResult->SetStringField(TEXT("Operation"), Result.Operation);
+			JsonResult->SetStringField(TEXT("Shape"), Result.Shape);
+			JsonResult->SetNumberField(TEXT("Entries"), Result.NumEntries);
+			JsonResult->SetNumberField(TEXT("Samples"), Result.NumSamples);
+			JsonResult->SetNumberField(TEXT("MinNs"), Result.MinNs);
+			JsonResult->SetNumberField(TEXT("MeanNs"), Result.MeanNs);
+			JsonResult->SetNumberField(TEXT("P50Ns"), Result.P50Ns);
+			JsonResult->SetNumberField(TEXT("P90Ns"), Result.P90Ns);
+			JsonResult->SetNumberField(TEXT("P99Ns"), Result.P99Ns);
+			JsonResult->SetNumberField(TEXT("MaxNs"), Result.MaxNs);
+			JsonResult->SetNumberField(TEXT("PayloadBits"), Result.PayloadBits);
+			JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+		}
+
+		TSharedRef<FJsonObject> JsonRoot = MakeShared<FJsonObject>();
+		JsonRoot->SetStringField(TEXT("Operation"), Operation);
+		JsonRoot->SetStringField(TEXT("BuildVersion"), FApp::GetBuildVersion());
+		JsonRoot->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+		JsonRoot->SetNumberField(TEXT("Warmup"), Settings.Warmup);
+		JsonRoot->SetArrayField(TEXT("Results"), JsonResults);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(JsonRoot, JsonWriter);
+
+		FFileHelper::SaveStringToFile(Csv, *FPaths::Combine(Settings.OutputDir, Operation + TEXT(".csv")));
+		FFileHelper::SaveStringToFile(Json, *FPaths::Combine(Settings.OutputDir, Operation + TEXT(".json")));
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FPolymorphicDataBankBenchmark, "OccamsGamekit.OGCore.OGPolymorphicDataBank.Benchmark",
+                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+void FPolymorphicDataBankBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const TCHAR* Operation : OGBenchmark::Operations)
+	{
+		OutBeautifiedNames.Add(Operation);
+		OutTestCommands.Add(Operation);
+	}
+}
+
+bool FPolymorphicDataBankBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace OGBenchmark;
+
+	const FSettings Settings = FSettings::FromCommandLine();
+	//Reading NetDeltaSerialize tracks unmapped guids through the package map, a bare one is enough without object references
+	const TStrongObjectPtr<UPackageMap> PackageMap(NewObject<UPackageMap>());
+
+	TArray<FCaseResult> Results;
+	RunShape(FPODTypes(), TEXT("POD"), Parameters, Settings, PackageMap.Get(), Results);
+	RunShape(FStringTypes(), TEXT("String"), Parameters, Settings, PackageMap.Get(), Results);
+	RunShape(FObjectTypes(), TEXT("Object"), Parameters, Settings, PackageMap.Get(), Results);
+
+	for (const FCaseResult& Result : Results)
+	{
+		AddInfo(FString::Printf(TEXT("%s %s x%d: p50 %.1fns p90 %.1fns p99 %.1fns mean %.1fns"), *Result.Operation, *Result.Shape,
+			Result.NumEntries, Result.P50Ns, Result.P90Ns, Result.P99Ns, Result.MeanNs));
+	}
+
+	WriteResults(Parameters, Settings, Results);
+	AddInfo(FString::Printf(TEXT("Benchmark results written to %s"), *FPaths::ConvertRelativePathToFull(Settings.OutputDir)));
+
+	TestTrue(TEXT("Benchmark produced results"), Results.Num() > 0);
+	return true;
+}
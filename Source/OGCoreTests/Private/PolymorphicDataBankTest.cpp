@@ -1,45 +1,811 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#include "PolymorphicDataBankTest.h"
-
-#include "Engine/StaticMeshActor.h"
-#include "Misc/AutomationTest.h"
-#include "Tests/AutomationCommon.h"
-
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolymorphicDataBankTest, "OccamsGamekit.OGCore.OGPolymorphicDataBank.BasicUsage",
-                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
-
-bool FPolymorphicDataBankTest::RunTest(const FString& Parameters)
-{
-	//Test 1: Basic storage, retrieval, deletion
-	{
-		FOGTestDataBank_Delta DataBank;
-		TestFalse(TEXT("DataBank does not contain struct initially"),DataBank.Contains<FOGTestPolymorphicData_Int>());
-
-		DataBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 123;
-
-		TestTrue(TEXT("DataBank contains TestStructOne"), DataBank.Contains<FOGTestPolymorphicData_Int>());
-		const FOGTestPolymorphicData_Int& OutStructOne = DataBank.GetConstChecked<FOGTestPolymorphicData_Int>();
-		TestEqual(TEXT("value in TestStructOne is what we set it to"), OutStructOne.TestInt, 123);
-
-		DataBank.Remove<FOGTestPolymorphicData_Int>();
-
-		TestFalse(TEXT("DataBank does not contain TestStructOne"), DataBank.Contains<FOGTestPolymorphicData_Int>());
-	}
-
-	//Test 2: Set to copy existing structs into the data bank and override existing structs
-	{
-		FOGTestDataBank_Delta DataBank;
-		FOGTestPolymorphicData_String TestStructTwo;
-		TestStructTwo.TestString = TEXT("Initial Value");
-		DataBank.SetByCopy(TestStructTwo);
-		TestTrue(TEXT("DataBank should contain copied value"), DataBank.GetConstChecked<FOGTestPolymorphicData_String>().TestString.Equals(TEXT("Initial Value")));
-		FOGTestPolymorphicData_String OverrideStruct;
-		OverrideStruct.TestString = TEXT("Overridden Value");
-		DataBank.SetByCopy(OverrideStruct);
-		TestTrue(TEXT("DataBank should contain overridden value"), DataBank.GetConstChecked<FOGTestPolymorphicData_String>().TestString.Equals(TEXT("Overridden Value")));
-	}
-	
-	// Make the test pass by returning true, or fail by returning false.
-	return true;
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "PolymorphicDataBankTest.h"
+
+#include "OGConcurrentDataBank.h"
+#include "OGDataBankColumnStore.h"
+#include "OGDataBankRPCBaselines.h"
+#include "OGDataBankTemplate.h"
+#include "OGOverlayDataBank.h"
+#include "OGPolymorphicDataFunctionLibrary.h"
+#include "Async/ParallelFor.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/AutomationCommon.h"
+#include "UObject/CoreNet.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace OGDataBankTest
+{
+	// Serializes entries by their properties, standing in for the net driver's RepLayout. Object references go through the package map.
+	class FPropertyNetSerializeCB : public INetSerializeCB
+	{
+	public:
+		virtual void NetSerializeStruct(FNetDeltaSerializeInfo& Params) override
+		{
+			FArchive& Ar = Params.Reader ? static_cast<FArchive&>(*Params.Reader) : static_cast<FArchive&>(*Params.Writer);
+			CastChecked<UScriptStruct>(Params.Struct)->SerializeBin(Ar, Params.Data);
+		}
+		virtual void GatherGuidReferencesForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool MoveGuidToUnmappedForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+		virtual void UpdateUnmappedGuidsForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool NetDeltaSerializeForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+	};
+
+	// Write Bank's delta against OldState into Writer, returns the new state to diff the next write against
+	template <typename BankType>
+	TSharedPtr<INetDeltaBaseState> WriteDelta(BankType& Bank, FNetBitWriter& Writer, UPackageMap* Map, INetDeltaBaseState* OldState)
+	{
+		FPropertyNetSerializeCB NetSerializeCB;
+		TSharedPtr<INetDeltaBaseState> NewState;
+		FNetDeltaSerializeInfo Params;
+		Params.Writer = &Writer;
+		Params.Map = Map;
+		Params.NetSerializeCB = &NetSerializeCB;
+		Params.Struct = BankType::StaticStruct();
+		Params.OldState = OldState;
+		Params.NewState = &NewState;
+		Bank.NetDeltaSerialize(Params);
+		return NewState;
+	}
+
+	template <typename BankType>
+	void ReadDelta(BankType& Bank, const FNetBitWriter& Writer, UPackageMap* Map)
+	{
+		FPropertyNetSerializeCB NetSerializeCB;
+		FNetBitReader Reader(Map, Writer.GetData(), Writer.GetNumBits());
+		FNetDeltaSerializeInfo Params;
+		Params.Reader = &Reader;
+		Params.Map = Map;
+		Params.NetSerializeCB = &NetSerializeCB;
+		Params.Struct = BankType::StaticStruct();
+		Bank.NetDeltaSerialize(Params);
+	}
+
+	// Let Bank read again the entries whose objects have been mapped since, returns true if some are still unmapped
+	template <typename BankType>
+	bool UpdateUnmapped(BankType& Bank, UPackageMap* Map, UObject* Owner)
+	{
+		FPropertyNetSerializeCB NetSerializeCB;
+		FNetDeltaSerializeInfo Params;
+		Params.Map = Map;
+		Params.Object = Owner;
+		Params.NetSerializeCB = &NetSerializeCB;
+		Params.Struct = BankType::StaticStruct();
+		Params.bUpdateUnmappedObjects = true;
+		Bank.NetDeltaSerialize(Params);
+		return Params.bOutHasMoreUnmapped;
+	}
+
+	// NetSerialize Sender from SenderMap's end of a connection into Receiver at ReceiverMap's end, like an RPC would.
+	// Returns the bits sent.
+	template <typename BankType>
+	int64 SendWithBaseline(BankType& Sender, BankType& Receiver, UPackageMap* SenderMap, UPackageMap* ReceiverMap, bool& bOutReadCleanly)
+	{
+		bool bSuccess = true;
+		FNetBitWriter Writer(SenderMap, 0);
+		Sender.NetSerialize(Writer, SenderMap, bSuccess);
+		FNetBitReader Reader(ReceiverMap, Writer.GetData(), Writer.GetNumBits());
+		Receiver.NetSerialize(Reader, ReceiverMap, bSuccess);
+		bOutReadCleanly = bSuccess && !Reader.IsError() && Reader.AtEnd();
+		return Writer.GetNumBits();
+	}
+
+	// What UOGDataBankBaselineAckComponent does, without the RPC
+	void AcknowledgeBaselines(UPackageMap* SenderMap, UPackageMap* ReceiverMap)
+	{
+		FOGDataBankRPCBaselines& Baselines = FOGDataBankRPCBaselines::Get();
+		TArray<uint16> Ids;
+		TArray<uint32> ResetStreams;
+		Baselines.ConsumePendingAcks(ReceiverMap, Ids, ResetStreams);
+		Baselines.Acknowledge(SenderMap, Ids);
+		Baselines.ResetSentStreams(SenderMap, ResetStreams);
+	}
+}
+
+bool UOGTestPackageMap::SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID)
+{
+	FNetworkGUID GUID;
+	if (Ar.IsSaving() && Obj)
+	{
+		if (const FNetworkGUID* Found = Objects.FindKey(Obj))
+		{
+			GUID = *Found;
+		}
+	}
+	Ar << GUID;
+	if (OutNetGUID)
+	{
+		*OutNetGUID = GUID;
+	}
+	if (Ar.IsLoading())
+	{
+		Obj = GetObjectFromNetGUID(GUID, false);
+		if (!Obj && GUID.IsValid())
+		{
+			if (bShouldTrackUnmappedGuids)
+			{
+				TrackedUnmappedNetGuids.Add(GUID);
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+UObject* UOGTestPackageMap::GetObjectFromNetGUID(const FNetworkGUID& NetGUID, const bool bIgnoreMustBeMapped)
+{
+	const TWeakObjectPtr<UObject>* Found = Objects.Find(NetGUID);
+	return Found ? Found->Get() : nullptr;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPolymorphicDataBankTest, "OccamsGamekit.OGCore.OGPolymorphicDataBank.BasicUsage",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPolymorphicDataBankTest::RunTest(const FString& Parameters)
+{
+	//Test 1: Basic storage, retrieval, deletion
+	{
+		FOGTestDataBank_Delta DataBank;
+		TestFalse(TEXT("DataBank does not contain struct initially"),DataBank.Contains<FOGTestPolymorphicData_Int>());
+
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 123;
+
+		TestTrue(TEXT("DataBank contains TestStructOne"), DataBank.Contains<FOGTestPolymorphicData_Int>());
+		const FOGTestPolymorphicData_Int& OutStructOne = DataBank.GetConstChecked<FOGTestPolymorphicData_Int>();
+		TestEqual(TEXT("value in TestStructOne is what we set it to"), OutStructOne.TestInt, 123);
+
+		DataBank.Remove<FOGTestPolymorphicData_Int>();
+
+		TestFalse(TEXT("DataBank does not contain TestStructOne"), DataBank.Contains<FOGTestPolymorphicData_Int>());
+	}
+
+	//Test 2: Set to copy existing structs into the data bank and override existing structs
+	{
+		FOGTestDataBank_Delta DataBank;
+		FOGTestPolymorphicData_String TestStructTwo;
+		TestStructTwo.TestString = TEXT("Initial Value");
+		DataBank.SetByCopy(TestStructTwo);
+		TestTrue(TEXT("DataBank should contain copied value"), DataBank.GetConstChecked<FOGTestPolymorphicData_String>().TestString.Equals(TEXT("Initial Value")));
+		FOGTestPolymorphicData_String OverrideStruct;
+		OverrideStruct.TestString = TEXT("Overridden Value");
+		DataBank.SetByCopy(OverrideStruct);
+		TestTrue(TEXT("DataBank should contain overridden value"), DataBank.GetConstChecked<FOGTestPolymorphicData_String>().TestString.Equals(TEXT("Overridden Value")));
+	}
+
+	//Test 3: Field level access reads and writes a single member in place
+	{
+		FOGTestDataBank_Delta DataBank;
+		const UScriptStruct* EntryType = FOGTestPolymorphicData_Int::StaticStruct();
+		const FProperty* Field = FindFProperty<FProperty>(EntryType, GET_MEMBER_NAME_CHECKED(FOGTestPolymorphicData_Int, TestInt));
+		int OutValue = 0;
+		TestFalse(TEXT("Reading a field of a missing entry fails"), UOGPolymorphicDataFunctionLibrary::GetFieldGeneric(DataBank, EntryType, Field, &OutValue));
+
+		int NewValue = 42;
+		TestTrue(TEXT("Writing a field of a missing entry adds it"), UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(DataBank, EntryType, Field, &NewValue));
+		TestTrue(TEXT("Reading the field finds the entry"), UOGPolymorphicDataFunctionLibrary::GetFieldGeneric(DataBank, EntryType, Field, &OutValue));
+		TestEqual(TEXT("Field value is what we wrote"), OutValue, 42);
+		TestFalse(TEXT("Writing the same value is not a change"), UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(DataBank, EntryType, Field, &NewValue));
+		NewValue = 7;
+		TestTrue(TEXT("Writing a different value is a change"), UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(DataBank, EntryType, Field, &NewValue));
+		TestEqual(TEXT("Entry holds the new value"), DataBank.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 7);
+	}
+
+	//Test 4: Snapshots keep the contents they were taken with while the bank keeps changing
+	{
+		FOGTestDataBank DataBank;
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 1;
+		const TSharedRef<const FOGPolymorphicDataBankSnapshot> Snapshot = DataBank.MakeSnapshot();
+		TestFalse(TEXT("Fresh snapshot is not stale"), Snapshot->IsStale(DataBank));
+
+		DataBank.GetChecked<FOGTestPolymorphicData_Int>().TestInt = 2;
+		DataBank.AddUnique<FOGTestPolymorphicData_String>();
+		TestTrue(TEXT("Snapshot is stale after the bank changed"), Snapshot->IsStale(DataBank));
+		TestEqual(TEXT("Snapshot keeps the old value"), Snapshot->Find<FOGTestPolymorphicData_Int>()->TestInt, 1);
+		TestFalse(TEXT("Snapshot does not see entries added later"), Snapshot->Contains<FOGTestPolymorphicData_String>());
+		TestEqual(TEXT("Bank has the new value"), DataBank.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 2);
+
+		DataBank.Empty();
+		TestEqual(TEXT("Snapshot outlives removal of its entries"), Snapshot->Find<FOGTestPolymorphicData_Int>()->TestInt, 1);
+	}
+
+	//Test 5: Concurrent writes from worker threads are committed into a regular bank
+	{
+		FOGTestDataBank DataBank;
+		FOGConcurrentDataBank ConcurrentBank(DataBank);
+		ParallelFor(64, [&ConcurrentBank](int32 Index)
+		{
+			FOGTestPolymorphicData_Int IntData;
+			IntData.TestInt = Index;
+			ConcurrentBank.SetByCopy(IntData);
+		});
+		TestTrue(TEXT("Concurrent bank holds the entry written in parallel"), ConcurrentBank.Contains<FOGTestPolymorphicData_Int>());
+		TestFalse(TEXT("Nothing reaches the bank before Commit"), DataBank.Contains<FOGTestPolymorphicData_Int>());
+
+		TestEqual(TEXT("Commit writes one entry"), ConcurrentBank.Commit(DataBank), 1);
+		TestEqual(TEXT("Bank holds the last published value"), DataBank.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, ConcurrentBank.Find<FOGTestPolymorphicData_Int>()->TestInt);
+		TestEqual(TEXT("Nothing is pending after Commit"), ConcurrentBank.Commit(DataBank), 0);
+	}
+
+	//Test 6: Persistent serialization round trips plain data and tagged entries
+	{
+		FOGTestDataBank DataBank;
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 17;
+		DataBank.AddUnique<FOGTestPolymorphicData_String>().TestString = TEXT("Saved");
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		DataBank.Serialize(Writer);
+
+		FOGTestDataBank LoadedBank;
+		LoadedBank.AddUnique<FOGTestPolymorphicData_Object>();
+		FMemoryReader Reader(Bytes);
+		LoadedBank.Serialize(Reader);
+		TestFalse(TEXT("Loading replaces the previous contents"), LoadedBank.Contains<FOGTestPolymorphicData_Object>());
+		TestEqual(TEXT("Plain data entry round trips"), LoadedBank.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 17);
+		TestEqual(TEXT("Tagged entry round trips"), LoadedBank.GetConstChecked<FOGTestPolymorphicData_String>().TestString, FString(TEXT("Saved")));
+		TestTrue(TEXT("Reader consumed everything"), Reader.AtEnd() && !Reader.IsError());
+	}
+
+	//Test 7: Template instances share the template entries until they write to them
+	{
+		UOGDataBankTemplate* Template = NewObject<UOGDataBankTemplate>();
+		Template->BankType = FOGTestDataBank::StaticStruct();
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 3;
+		Template->Entries.Add(FInstancedStruct::Make(IntData));
+
+		FOGTestDataBank First, Second;
+		Template->Instantiate(First);
+		Template->Instantiate(Second);
+		TestTrue(TEXT("Instances share the template entry"), First.FindConst<FOGTestPolymorphicData_Int>() == Second.FindConst<FOGTestPolymorphicData_Int>());
+		TestEqual(TEXT("Instance holds the template value"), First.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 3);
+
+		First.GetChecked<FOGTestPolymorphicData_Int>().TestInt = 4;
+		TestEqual(TEXT("Writing to one instance leaves the other alone"), Second.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 3);
+		TestEqual(TEXT("Written instance has the new value"), First.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 4);
+	}
+
+	//Test 8: Column store keeps one column per type and can copy an entity to and from a bank
+	{
+		FOGDataBankColumnStore Store((FOGTestDataBank()));
+		TArray<int32> StoreEntities;
+		for (int32 Idx = 0; Idx < 100; ++Idx)
+		{
+			const int32 Entity = Store.AddEntity();
+			StoreEntities.Add(Entity);
+			if (Idx % 2 == 0)
+			{
+				Store.AddUnique<FOGTestPolymorphicData_Int>(Entity).TestInt = Idx;
+			}
+		}
+
+		int32 Visited = 0;
+		Store.ForEach<FOGTestPolymorphicData_Int>([&Visited](const int32 Entity, FOGTestPolymorphicData_Int& Entry) { ++Visited; });
+		TestEqual(TEXT("ForEach visits only entities that have the type"), Visited, 50);
+
+		std::atomic<int32> ParallelSum = 0;
+		Store.ParallelForEach<FOGTestPolymorphicData_Int>([&ParallelSum](const int32 Entity, FOGTestPolymorphicData_Int& Entry) { ParallelSum += Entry.TestInt; }, 16);
+		TestEqual(TEXT("ParallelForEach visits every entry once"), ParallelSum.load(), 2450);
+
+		FOGTestDataBank EntityBank;
+		Store.CopyToBank(StoreEntities[4], EntityBank);
+		TestEqual(TEXT("Bank holds the entity's entries"), EntityBank.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 4);
+		EntityBank.GetChecked<FOGTestPolymorphicData_Int>().TestInt = 99;
+		TestEqual(TEXT("Writes to the bank don't reach the store by themselves"), Store.FindConst<FOGTestPolymorphicData_Int>(StoreEntities[4])->TestInt, 4);
+		EntityBank.AddUnique<FOGTestPolymorphicData_NetInt>().TestInt = 5;
+		Store.CopyFromBank(StoreEntities[4], EntityBank);
+		TestEqual(TEXT("Copying the bank back updates the store"), Store.FindConst<FOGTestPolymorphicData_Int>(StoreEntities[4])->TestInt, 99);
+		TestEqual(TEXT("Copying the bank back adds its new entries"), Store.FindConst<FOGTestPolymorphicData_NetInt>(StoreEntities[4])->TestInt, 5);
+
+		Store.RemoveEntity(StoreEntities[4]);
+		TestNull(TEXT("Removed entities have no entries"), Store.Find<FOGTestPolymorphicData_Int>(StoreEntities[4]));
+		TestEqual(TEXT("Bank copies outlive the entity"), EntityBank.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 99);
+
+		TestEqual(TEXT("Column of a type no entity has is empty"), Store.GetColumn<FOGTestPolymorphicData_String>().Num(), 0);
+		TestEqual(TEXT("Presence of a type no entity has is empty"), Store.GetPresence<FOGTestPolymorphicData_String>().Num(), 0);
+		int32 VisitedStrings = 0;
+		Store.ForEach<FOGTestPolymorphicData_String>([&VisitedStrings](const int32 Entity, FOGTestPolymorphicData_String& Entry) { ++VisitedStrings; });
+		TestEqual(TEXT("ForEach over a type no entity has visits nothing"), VisitedStrings, 0);
+	}
+
+	//Test 9: Entries are visited by type hierarchy
+	{
+		FOGTestDataBank DataBank;
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>();
+		DataBank.AddUnique<FOGTestPolymorphicData_String>();
+		int32 Visited = 0;
+		DataBank.ForEachConst<FOGTestPolymorphicData_Base>([&Visited](const FOGTestPolymorphicData_Base& Entry) { ++Visited; });
+		TestEqual(TEXT("ForEach over the base visits every entry"), Visited, 2);
+		Visited = 0;
+		DataBank.ForEachConst<FOGTestPolymorphicData_Int>([&Visited](const FOGTestPolymorphicData_Int& Entry) { ++Visited; });
+		TestEqual(TEXT("ForEach over a leaf visits only that entry"), Visited, 1);
+		TestEqual(TEXT("Blueprint lookup finds both entry types"),
+			UOGPolymorphicDataFunctionLibrary::GetEntryTypesDerivedFrom(DataBank, FOGTestPolymorphicData_Base::StaticStruct()).Num(), 2);
+	}
+
+	//Test 10: Multi bank holds several elements of one type, each behind its own handle
+	{
+		FOGTestMultiBank MultiBank;
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 1;
+		const FOGDataBankElementHandle First = MultiBank.AddByCopy(IntData);
+		IntData.TestInt = 2;
+		const FOGDataBankElementHandle Second = MultiBank.AddByCopy(IntData);
+		FOGDataBankElementHandle StringHandle;
+		MultiBank.Add<FOGTestPolymorphicData_String>(StringHandle).TestString = TEXT("Multi");
+		TestEqual(TEXT("Every element is kept"), MultiBank.Num(), 3);
+		TestEqual(TEXT("Elements are indexed by type"), MultiBank.GetHandlesOfType<FOGTestPolymorphicData_Int>().Num(), 2);
+		TestTrue(TEXT("Handles find their own element"), MultiBank.FindConst<FOGTestPolymorphicData_Int>(Second) && MultiBank.FindConst<FOGTestPolymorphicData_Int>(Second)->TestInt == 2);
+		TestNull(TEXT("Handles don't find elements of another type"), MultiBank.FindConst<FOGTestPolymorphicData_Int>(StringHandle));
+		TestNotNull(TEXT("Handles find elements through their base type"), MultiBank.FindConst<FOGTestPolymorphicData_Base>(StringHandle));
+		TestTrue(TEXT("Removing an element"), MultiBank.Remove(First));
+		TestFalse(TEXT("Removed handles are gone"), MultiBank.Contains(First));
+		TestTrue(TEXT("Removing keeps the other elements of the type"), MultiBank.GetHandlesOfType<FOGTestPolymorphicData_Int>().Num() == 1 && MultiBank.GetHandlesOfType<FOGTestPolymorphicData_Int>()[0] == Second);
+		const FOGTestMultiBank Copy = MultiBank;
+		TestTrue(TEXT("Copies keep the handles"), Copy.FindConst<FOGTestPolymorphicData_String>(StringHandle) && Copy.FindConst<FOGTestPolymorphicData_String>(StringHandle)->TestString == TEXT("Multi"));
+	}
+
+	//Test 11: Overlay banks read through to their parent and only store overrides
+	{
+		UOGDataBankTemplate* Template = NewObject<UOGDataBankTemplate>();
+		Template->BankType = FOGTestDataBank::StaticStruct();
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 5;
+		Template->Entries.Add(FInstancedStruct::Make(IntData));
+		FOGTestPolymorphicData_String StringData;
+		StringData.TestString = TEXT("Parent");
+		Template->Entries.Add(FInstancedStruct::Make(StringData));
+
+		FOGTestOverlayBank First, Second;
+		First.SetParent(Template);
+		Second.SetParent(Template);
+		TestTrue(TEXT("Overlays read the parent entry"), First.FindConst<FOGTestPolymorphicData_Int>() == Second.FindConst<FOGTestPolymorphicData_Int>());
+		TestEqual(TEXT("Overlays start without overrides"), First.NumOverrides(), 0);
+		TestEqual(TEXT("Merged view has the parent entries"), First.Num(), 2);
+
+		First.Find<FOGTestPolymorphicData_Int>()->TestInt = 6;
+		TestTrue(TEXT("Writing creates an override"), First.IsOverridden<FOGTestPolymorphicData_Int>());
+		TestEqual(TEXT("Other overlays keep the parent value"), Second.FindConst<FOGTestPolymorphicData_Int>()->TestInt, 5);
+		TestEqual(TEXT("Overrides don't change the merged count"), First.Num(), 2);
+
+		First.Remove<FOGTestPolymorphicData_String>();
+		TestFalse(TEXT("Removing a parent entry hides it"), First.Contains<FOGTestPolymorphicData_String>());
+		int32 Visited = 0;
+		First.ForEachConst<FOGTestPolymorphicData_Base>([&Visited](const FOGTestPolymorphicData_Base& Entry) { ++Visited; });
+		TestEqual(TEXT("Iteration skips removed parent entries"), Visited, 1);
+		First.RevertToParent<FOGTestPolymorphicData_String>();
+		First.RevertToParent<FOGTestPolymorphicData_Int>();
+		TestEqual(TEXT("Reverting shows the parent again"), First.FindConst<FOGTestPolymorphicData_Int>()->TestInt, 5);
+		TestEqual(TEXT("Reverting shows removed entries again"), First.Num(), 2);
+	}
+
+	{
+		//Instantiating another kind of bank from the same template must not invalidate what overlays read through to
+		UOGDataBankTemplate* Template = NewObject<UOGDataBankTemplate>();
+		Template->BankType = FOGTestDataBank::StaticStruct();
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 7;
+		Template->Entries.Add(FInstancedStruct::Make(IntData));
+
+		FOGTestOverlayBank Overlay;
+		Overlay.SetParent(Template);
+		const FOGTestPolymorphicData_Int* ReadThrough = Overlay.FindConst<FOGTestPolymorphicData_Int>();
+		FOGTestDataBank_IntOnly OtherKind;
+		Template->Instantiate(OtherKind);
+		TestEqual(TEXT("Other kinds of banks get the template entries too"), OtherKind.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 7);
+		TestTrue(TEXT("Overlay entries stay put when another kind of bank uses the template"), Overlay.FindConst<FOGTestPolymorphicData_Int>() == ReadThrough);
+		TestEqual(TEXT("Earlier read throughs stay valid"), ReadThrough->TestInt, 7);
+	}
+
+	//Test 12: Change subscriptions are coalesced and delivered once per flush
+	{
+		FOGTestDataBank DataBank;
+		int32 Calls = 0;
+		TArray<UScriptStruct*> LastChanged;
+		const FOGDataBankSubscriptionHandle Subscription = DataBank.SubscribeToChanges<FOGTestPolymorphicData_Base>(
+			FOGOnDataBankChanged::CreateLambda([&Calls, &LastChanged](TConstArrayView<UScriptStruct*> ChangedTypes)
+			{
+				++Calls;
+				LastChanged = TArray<UScriptStruct*>(ChangedTypes);
+			}));
+		int32 StringCalls = 0;
+		DataBank.SubscribeToChanges<FOGTestPolymorphicData_String>(FOGOnDataBankChanged::CreateLambda([&StringCalls](TConstArrayView<UScriptStruct*>) { ++StringCalls; }));
+
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 1;
+		const uint16 AddedVersion = DataBank.GetEntryVersion<FOGTestPolymorphicData_Int>();
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 2;
+		DataBank.SetByCopy(IntData);
+		TestTrue(TEXT("Writes change the entry version"), DataBank.GetEntryVersion<FOGTestPolymorphicData_Int>() != AddedVersion);
+		FOGDataBankChangeListeners::FlushAll();
+		TestEqual(TEXT("Changes in one frame are delivered once"), Calls, 1);
+		TestTrue(TEXT("Changed types are delivered"), LastChanged.Num() == 1 && LastChanged[0] == FOGTestPolymorphicData_Int::StaticStruct());
+		TestEqual(TEXT("Subscriptions to other types are not called"), StringCalls, 0);
+
+		FOGDataBankChangeListeners::FlushAll();
+		TestEqual(TEXT("Nothing is delivered without changes"), Calls, 1);
+
+		DataBank.Remove<FOGTestPolymorphicData_Int>();
+		TestTrue(TEXT("Unsubscribing"), DataBank.UnsubscribeFromChanges(Subscription));
+		FOGDataBankChangeListeners::FlushAll();
+		TestEqual(TEXT("Unsubscribed listeners are not called"), Calls, 1);
+	}
+
+	//Test 13: Futures wait for entries without polling
+	{
+		FOGTestDataBank DataBank;
+		TOGFuture<void> WhenInt = DataBank.WhenContains<FOGTestPolymorphicData_Int>();
+		TOGFuture<void> WhenIntChanged = DataBank.WhenChanged<FOGTestPolymorphicData_Int>();
+		DataBank.AddUnique<FOGTestPolymorphicData_String>();
+		FOGDataBankChangeListeners::FlushAll();
+		TestFalse(TEXT("Other types don't fulfill the wait"), WhenInt->IsFulfilled());
+
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>();
+		TestFalse(TEXT("Waits are fulfilled at the end of the frame"), WhenInt->IsFulfilled());
+		FOGDataBankChangeListeners::FlushAll();
+		TestTrue(TEXT("Adding the type fulfills WhenContains"), WhenInt->IsFulfilled());
+		TestTrue(TEXT("Adding the type fulfills WhenChanged"), WhenIntChanged->IsFulfilled());
+		TestTrue(TEXT("WhenContains on a present type is already fulfilled"), DataBank.WhenContains<FOGTestPolymorphicData_Int>()->IsFulfilled());
+	}
+
+	//Test 14: Content hashes and equality ignore replication keys, identical writes can be skipped
+	{
+		FOGTestDataBank First;
+		FOGTestDataBank Second;
+		First.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 3;
+		First.AddUnique<FOGTestPolymorphicData_String>().TestString = TEXT("Same");
+		//Added in the other order so the replication keys differ
+		Second.AddUnique<FOGTestPolymorphicData_String>().TestString = TEXT("Same");
+		Second.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 3;
+		TestTrue(TEXT("Banks with the same contents are equal"), First == Second);
+		TestTrue(TEXT("Banks with the same contents hash the same"), First.GetContentHash() == Second.GetContentHash());
+
+		Second.GetChecked<FOGTestPolymorphicData_Int>().TestInt = 4;
+		TestTrue(TEXT("Changing a value breaks equality"), First != Second);
+		TestTrue(TEXT("Changing a value changes the hash"), First.GetContentHash() != Second.GetContentHash());
+
+		FOGTestDataBank_SkipRedundant SkipBank;
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 7;
+		SkipBank.SetByCopy(IntData);
+		const uint16 Version = SkipBank.GetEntryVersion<FOGTestPolymorphicData_Int>();
+		SkipBank.SetByCopy(IntData);
+		TestTrue(TEXT("Writing an identical value keeps the replication key"), Version == SkipBank.GetEntryVersion<FOGTestPolymorphicData_Int>());
+		IntData.TestInt = 8;
+		SkipBank.SetByCopy(IntData);
+		TestTrue(TEXT("Writing a new value bumps the replication key"), Version != SkipBank.GetEntryVersion<FOGTestPolymorphicData_Int>());
+
+		FOGTestDataBank Unordered;
+		FOGTestDataBank Reordered;
+		FOGTestPolymorphicData_Unordered& UnorderedData = Unordered.AddUnique<FOGTestPolymorphicData_Unordered>();
+		FOGTestPolymorphicData_Unordered& ReorderedData = Reordered.AddUnique<FOGTestPolymorphicData_Unordered>();
+		UnorderedData.TestFloat = 0.f;
+		ReorderedData.TestFloat = -0.f;
+		UnorderedData.TestVector = FVector(0.0, 1.0, 2.0);
+		ReorderedData.TestVector = FVector(-0.0, 1.0, 2.0);
+		for (int32 Value = 0; Value < 8; ++Value)
+		{
+			UnorderedData.TestSet.Add(Value);
+			ReorderedData.TestSet.Add(7 - Value);
+			UnorderedData.TestMap.Add(FName(*FString::FromInt(Value)), Value);
+			ReorderedData.TestMap.Add(FName(*FString::FromInt(7 - Value)), 7 - Value);
+		}
+		TestTrue(TEXT("Zero and negative zero, and sets and maps in another order are equal"), Unordered == Reordered);
+		TestTrue(TEXT("Equal banks hash the same whatever their float signs and element order"), Unordered.GetContentHash() == Reordered.GetContentHash());
+		Reordered.GetChecked<FOGTestPolymorphicData_Unordered>().TestMap.Add(TEXT("8"), 8);
+		TestTrue(TEXT("Changing a map changes the hash"), Unordered.GetContentHash() != Reordered.GetContentHash());
+	}
+
+	//Test 15: Plain data entries persist their members only, in the archive's byte order
+	{
+		FOGTestDataBank First;
+		FOGTestDataBank Second;
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 0x01020304;
+		First.SetByCopy(IntData);
+		//Written twice so the replication key differs from First's
+		Second.SetByCopy(IntData);
+		Second.SetByCopy(IntData);
+
+		TArray<uint8> FirstBytes, SecondBytes;
+		FMemoryWriter FirstWriter(FirstBytes);
+		First.Serialize(FirstWriter);
+		FMemoryWriter SecondWriter(SecondBytes);
+		Second.Serialize(SecondWriter);
+		TestTrue(TEXT("Replication keys are not persisted"), FirstBytes == SecondBytes);
+
+		TArray<uint8> SwappedBytes;
+		FMemoryWriter SwappedWriter(SwappedBytes);
+		SwappedWriter.SetByteSwapping(true);
+		First.Serialize(SwappedWriter);
+		FOGTestDataBank Loaded;
+		FMemoryReader SwappedReader(SwappedBytes);
+		SwappedReader.SetByteSwapping(true);
+		Loaded.Serialize(SwappedReader);
+		TestEqual(TEXT("Byte swapped plain data round trips"), Loaded.GetConstChecked<FOGTestPolymorphicData_Int>().TestInt, 0x01020304);
+		TestTrue(TEXT("Byte swapped reader consumed everything"), SwappedReader.AtEnd() && !SwappedReader.IsError());
+	}
+
+	//Test 16: Multi bank delta replication sends added, changed and removed elements and keeps the server's handles
+	{
+		using namespace OGDataBankTest;
+		const TStrongObjectPtr<UPackageMap> PackageMap(NewObject<UPackageMap>());
+		FOGTestMultiBank ServerBank;
+		FOGTestMultiBank ClientBank;
+		FOGTestPolymorphicData_Int IntData;
+		IntData.TestInt = 1;
+		const FOGDataBankElementHandle First = ServerBank.AddByCopy(IntData);
+		IntData.TestInt = 2;
+		const FOGDataBankElementHandle Second = ServerBank.AddByCopy(IntData);
+		FOGDataBankElementHandle StringHandle;
+		ServerBank.Add<FOGTestPolymorphicData_String>(StringHandle).TestString = TEXT("Replicated");
+
+		FNetBitWriter FullWriter(PackageMap.Get(), 0);
+		const TSharedPtr<INetDeltaBaseState> FullState = WriteDelta(ServerBank, FullWriter, PackageMap.Get(), nullptr);
+		ReadDelta(ClientBank, FullWriter, PackageMap.Get());
+		TestEqual(TEXT("Every element arrives"), ClientBank.Num(), 3);
+		TestTrue(TEXT("Elements arrive under the server's handles"), ClientBank.FindConst<FOGTestPolymorphicData_Int>(Second) && ClientBank.FindConst<FOGTestPolymorphicData_Int>(Second)->TestInt == 2);
+		TestTrue(TEXT("Element values arrive"), ClientBank.FindConst<FOGTestPolymorphicData_String>(StringHandle) && ClientBank.FindConst<FOGTestPolymorphicData_String>(StringHandle)->TestString == TEXT("Replicated"));
+
+		FNetBitWriter UnchangedWriter(PackageMap.Get(), 0);
+		WriteDelta(ServerBank, UnchangedWriter, PackageMap.Get(), FullState.Get());
+		TestEqual(TEXT("An unchanged bank writes nothing"), UnchangedWriter.GetNumBits(), 0ll);
+
+		ServerBank.Find<FOGTestPolymorphicData_Int>(First)->TestInt = 10;
+		ServerBank.Remove(Second);
+		IntData.TestInt = 3;
+		const FOGDataBankElementHandle Third = ServerBank.AddByCopy(IntData);
+		FNetBitWriter DeltaWriter(PackageMap.Get(), 0);
+		WriteDelta(ServerBank, DeltaWriter, PackageMap.Get(), FullState.Get());
+		ReadDelta(ClientBank, DeltaWriter, PackageMap.Get());
+		TestTrue(TEXT("Changed element is updated"), ClientBank.FindConst<FOGTestPolymorphicData_Int>(First) && ClientBank.FindConst<FOGTestPolymorphicData_Int>(First)->TestInt == 10);
+		TestFalse(TEXT("Removed element is removed"), ClientBank.Contains(Second));
+		TestTrue(TEXT("Added element is added"), ClientBank.FindConst<FOGTestPolymorphicData_Int>(Third) && ClientBank.FindConst<FOGTestPolymorphicData_Int>(Third)->TestInt == 3);
+		TestTrue(TEXT("Untouched element is kept"), ClientBank.Contains(StringHandle));
+		TestEqual(TEXT("Client matches the server"), ClientBank.Num(), ServerBank.Num());
+	}
+
+	//Test 17: Entries whose objects resolve later are read again and stay in the bank once nothing is left to resolve
+	{
+		using namespace OGDataBankTest;
+		UObject* Referenced = NewObject<UOGDataBankTemplate>();
+		const TStrongObjectPtr<UObject> ReferencedRoot(Referenced);
+		const FNetworkGUID ReferencedGUID = FNetworkGUID::CreateFromIndex(1, true);
+		const TStrongObjectPtr<UOGTestPackageMap> ServerMap(NewObject<UOGTestPackageMap>());
+		const TStrongObjectPtr<UOGTestPackageMap> ClientMap(NewObject<UOGTestPackageMap>());
+		ServerMap->MapObject(ReferencedGUID, Referenced);
+
+		FOGTestDataBank_Delta ServerBank;
+		FOGTestDataBank_Delta ClientBank;
+		ServerBank.AddUnique<FOGTestPolymorphicData_Object>().TestObject = Referenced;
+		ServerBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 4;
+
+		FNetBitWriter Writer(ServerMap.Get(), 0);
+		WriteDelta(ServerBank, Writer, ServerMap.Get(), nullptr);
+		ReadDelta(ClientBank, Writer, ClientMap.Get());
+		TestTrue(TEXT("Entry with an unmapped object arrives without it"), ClientBank.Contains<FOGTestPolymorphicData_Object>() && !ClientBank.GetConstChecked<FOGTestPolymorphicData_Object>().TestObject);
+		TestTrue(TEXT("Unmapped object keeps the bank waiting"), UpdateUnmapped(ClientBank, ClientMap.Get(), Referenced));
+
+		ClientMap->MapObject(ReferencedGUID, Referenced);
+		TestFalse(TEXT("Nothing is left to resolve once the object is mapped"), UpdateUnmapped(ClientBank, ClientMap.Get(), Referenced));
+		TestTrue(TEXT("Resolved entry stays in the bank"), ClientBank.Contains<FOGTestPolymorphicData_Object>());
+		TestTrue(TEXT("Resolved entry was read again"), ClientBank.GetConstChecked<FOGTestPolymorphicData_Object>().TestObject == Referenced);
+		TestFalse(TEXT("Later updates have nothing to do"), UpdateUnmapped(ClientBank, ClientMap.Get(), Referenced));
+		TestTrue(TEXT("Entries stay in the bank after they stop being tracked"), ClientBank.Contains<FOGTestPolymorphicData_Object>() && ClientBank.Contains<FOGTestPolymorphicData_Int>());
+	}
+
+	//Test 18: RPC baselines send everything until a send is acknowledged, then only the difference to it
+	{
+		using namespace OGDataBankTest;
+		const TStrongObjectPtr<UPackageMap> SenderMap(NewObject<UPackageMap>());
+		const TStrongObjectPtr<UPackageMap> ReceiverMap(NewObject<UPackageMap>());
+		FOGTestDataBank_Baselines Sender;
+		FOGTestDataBank_Baselines Receiver;
+		Sender.AddUnique<FOGTestPolymorphicData_NetInt>().TestInt = 1;
+		Sender.AddUnique<FOGTestPolymorphicData_NetString>().TestString = TEXT("Baseline");
+		bool bReadCleanly = false;
+
+		const int64 FullBits = SendWithBaseline(Sender, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("Unacknowledged send reads cleanly"), bReadCleanly);
+		TestTrue(TEXT("Unacknowledged send has every entry"), Receiver.Num() == 2 && Receiver.GetConstChecked<FOGTestPolymorphicData_NetString>().TestString == TEXT("Baseline"));
+		TestEqual(TEXT("Sends stay full until one is acknowledged"), SendWithBaseline(Sender, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly), FullBits);
+
+		AcknowledgeBaselines(SenderMap.Get(), ReceiverMap.Get());
+		const int64 UnchangedBits = SendWithBaseline(Sender, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("Acknowledged send of an unchanged bank only sends a header"), bReadCleanly && UnchangedBits < FullBits);
+		TestTrue(TEXT("Unchanged entries come from the baseline"), Receiver.Num() == 2 && Receiver.GetConstChecked<FOGTestPolymorphicData_NetInt>().TestInt == 1);
+
+		FOGTestDataBank_Baselines OtherSender;
+		FOGTestDataBank_Baselines OtherReceiver;
+		OtherSender.AddUnique<FOGTestPolymorphicData_NetInt>().TestInt = 5;
+		SendWithBaseline(OtherSender, OtherReceiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("Other banks of the same type don't use this bank's baselines"), bReadCleanly && OtherReceiver.Num() == 1 && OtherReceiver.GetConstChecked<FOGTestPolymorphicData_NetInt>().TestInt == 5);
+
+		Sender.GetChecked<FOGTestPolymorphicData_NetInt>().TestInt = 2;
+		Sender.Remove<FOGTestPolymorphicData_NetString>();
+		SendWithBaseline(Sender, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("Acknowledged delta reads cleanly"), bReadCleanly);
+		TestEqual(TEXT("Changed entry arrives"), Receiver.GetConstChecked<FOGTestPolymorphicData_NetInt>().TestInt, 2);
+		TestFalse(TEXT("Removed entry is removed"), Receiver.Contains<FOGTestPolymorphicData_NetString>());
+		TestEqual(TEXT("Receiver matches the sender"), Receiver.Num(), Sender.Num());
+
+		//A receiver that doesn't hold the baseline, as if it had been evicted, fails the read and resets the stream
+		const TStrongObjectPtr<UPackageMap> LostMap(NewObject<UPackageMap>());
+		FOGTestDataBank_Baselines LostReceiver;
+		AddExpectedError(TEXT("which is no longer held"), EAutomationExpectedErrorFlags::Contains, 1);
+		SendWithBaseline(Sender, LostReceiver, SenderMap.Get(), LostMap.Get(), bReadCleanly);
+		TestFalse(TEXT("Send relative to an unknown baseline fails the read"), bReadCleanly);
+		AcknowledgeBaselines(SenderMap.Get(), LostMap.Get());
+		SendWithBaseline(Sender, LostReceiver, SenderMap.Get(), LostMap.Get(), bReadCleanly);
+		TestTrue(TEXT("Sender goes back to a full send after the reset"), bReadCleanly && LostReceiver.Num() == 1 && LostReceiver.GetConstChecked<FOGTestPolymorphicData_NetInt>().TestInt == 2);
+	}
+
+	//Test 19: Allocated sizes grow with the entries and with the memory their members own
+	{
+		const FString LongString = FString::ChrN(1024, TEXT('x'));
+
+		FOGTestDataBank DataBank;
+		const SIZE_T EmptyBankSize = DataBank.GetAllocatedSize();
+		DataBank.AddUnique<FOGTestPolymorphicData_String>();
+		const SIZE_T OneEntrySize = DataBank.GetAllocatedSize();
+		TestTrue(TEXT("Bank size grows with entries"), OneEntrySize > EmptyBankSize);
+		DataBank.GetChecked<FOGTestPolymorphicData_String>().TestString = LongString;
+		TMap<const UScriptStruct*, SIZE_T> BytesPerEntryType;
+		TestTrue(TEXT("Bank size counts memory owned by members"), DataBank.GetAllocatedSize(&BytesPerEntryType) >= OneEntrySize + LongString.Len() * sizeof(TCHAR));
+		TestTrue(TEXT("Bank size is attributed to the entry type"), BytesPerEntryType.FindRef(FOGTestPolymorphicData_String::StaticStruct()) >= LongString.Len() * sizeof(TCHAR));
+
+		UOGDataBankTemplate* Template = NewObject<UOGDataBankTemplate>();
+		Template->BankType = FOGTestDataBank::StaticStruct();
+		FOGTestPolymorphicData_String StringData;
+		StringData.TestString = LongString;
+		Template->Entries.Add(FInstancedStruct::Make(StringData));
+		FOGTestOverlayBank Overlay;
+		Overlay.SetParent(Template);
+		const SIZE_T ReadThroughSize = Overlay.GetAllocatedSize();
+		TestTrue(TEXT("Entries read through to the parent aren't counted by the overlay"), ReadThroughSize < LongString.Len() * sizeof(TCHAR));
+		Overlay.Find<FOGTestPolymorphicData_String>()->TestString += TEXT("y");
+		TestTrue(TEXT("Overlay size grows with overrides and what they own"), Overlay.GetAllocatedSize() >= ReadThroughSize + LongString.Len() * sizeof(TCHAR));
+
+		FOGTestDataBank FirstInstance;
+		FOGTestDataBank SecondInstance;
+		Template->Instantiate(FirstInstance);
+		Template->Instantiate(SecondInstance);
+		TSet<const void*> CountedEntries;
+		TestTrue(TEXT("The first bank holding a shared entry is charged for it"), FirstInstance.GetAllocatedSize(nullptr, &CountedEntries) >= LongString.Len() * sizeof(TCHAR));
+		TestTrue(TEXT("Later banks holding the same shared entry aren't charged again"), SecondInstance.GetAllocatedSize(nullptr, &CountedEntries) < LongString.Len() * sizeof(TCHAR));
+		TestTrue(TEXT("Without a counted set every bank is charged"), SecondInstance.GetAllocatedSize() >= LongString.Len() * sizeof(TCHAR));
+
+		FOGDataBankColumnStore Store((FOGTestDataBank()));
+		const int32 Entity = Store.AddEntity();
+		const SIZE_T NoColumnSize = Store.GetAllocatedSize();
+		Store.AddUnique<FOGTestPolymorphicData_String>(Entity);
+		const SIZE_T OneColumnSize = Store.GetAllocatedSize();
+		TestTrue(TEXT("Column store size grows with columns"), OneColumnSize > NoColumnSize);
+		Store.Find<FOGTestPolymorphicData_String>(Entity)->TestString = LongString;
+		TestTrue(TEXT("Column store size counts memory owned by members"), Store.GetAllocatedSize() >= OneColumnSize + LongString.Len() * sizeof(TCHAR));
+		int32 NumLiveStores = 0;
+		FOGDataBankColumnStore::ForEachLiveStore([&NumLiveStores, &Store](const FOGDataBankColumnStore& LiveStore) { NumLiveStores += &LiveStore == &Store; });
+		TestEqual(TEXT("Live column stores are found for the memory report"), NumLiveStores, 1);
+	}
+
+	//Test 20: Bitfield bools compare against the whole bool the script VM passes in
+	{
+		FOGTestDataBank_Delta DataBank;
+		const UScriptStruct* EntryType = FOGTestPolymorphicData_Flags::StaticStruct();
+		const FProperty* Field = FindFProperty<FProperty>(EntryType, TEXT("bTestFlag"));
+		bool NewValue = true;
+		TestTrue(TEXT("Writing a flag of a missing entry adds it"), UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(DataBank, EntryType, Field, &NewValue));
+		TestFalse(TEXT("Writing the same flag is not a change"), UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(DataBank, EntryType, Field, &NewValue));
+		NewValue = false;
+		TestTrue(TEXT("Clearing the flag is a change"), UOGPolymorphicDataFunctionLibrary::SetFieldGeneric(DataBank, EntryType, Field, &NewValue));
+		TestFalse(TEXT("Entry holds the cleared flag"), static_cast<bool>(DataBank.GetConstChecked<FOGTestPolymorphicData_Flags>().bTestFlag));
+	}
+
+	//Test 21: Removing an entry makes snapshots taken before it stale
+	{
+		FOGTestDataBank DataBank;
+		DataBank.AddUnique<FOGTestPolymorphicData_Int>().TestInt = 1;
+		const TSharedRef<const FOGPolymorphicDataBankSnapshot> Snapshot = DataBank.MakeSnapshot();
+		DataBank.Remove<FOGTestPolymorphicData_Int>();
+		TestTrue(TEXT("Snapshot is stale after a removal"), Snapshot->IsStale(DataBank));
+		TestTrue(TEXT("Snapshot still holds the removed entry"), Snapshot->Contains<FOGTestPolymorphicData_Int>());
+		TestFalse(TEXT("Snapshot taken after the removal is fresh"), DataBank.MakeSnapshot()->IsStale(DataBank));
+	}
+
+	//Test 22: An overlay that arrives before its parent is resolved picks the parent up once it is mapped
+	{
+		using namespace OGDataBankTest;
+		UOGDataBankTemplate* Template = NewObject<UOGDataBankTemplate>();
+		const TStrongObjectPtr<UOGDataBankTemplate> TemplateRoot(Template);
+		Template->BankType = FOGTestDataBank::StaticStruct();
+		FOGTestPolymorphicData_String StringData;
+		StringData.TestString = TEXT("Parent");
+		Template->Entries.Add(FInstancedStruct::Make(StringData));
+		const FNetworkGUID TemplateGUID = FNetworkGUID::CreateFromIndex(2, false);
+		const TStrongObjectPtr<UOGTestPackageMap> ServerMap(NewObject<UOGTestPackageMap>());
+		const TStrongObjectPtr<UOGTestPackageMap> ClientMap(NewObject<UOGTestPackageMap>());
+		ServerMap->MapObject(TemplateGUID, Template);
+
+		FOGTestOverlayBank ServerOverlay;
+		FOGTestOverlayBank ClientOverlay;
+		ServerOverlay.SetParent(Template);
+		ServerOverlay.SetByCopy(FOGTestPolymorphicData_Int());
+
+		FNetBitWriter Writer(ServerMap.Get(), 0);
+		WriteDelta(ServerOverlay, Writer, ServerMap.Get(), nullptr);
+		ReadDelta(ClientOverlay, Writer, ClientMap.Get());
+		TestNull(TEXT("Overlay arrives without its unmapped parent"), ClientOverlay.GetParent());
+		TestTrue(TEXT("Overrides arrive regardless"), ClientOverlay.Contains<FOGTestPolymorphicData_Int>());
+		TestTrue(TEXT("Unmapped parent keeps the overlay waiting"), UpdateUnmapped(ClientOverlay, ClientMap.Get(), Template));
+
+		ClientMap->MapObject(TemplateGUID, Template);
+		TestFalse(TEXT("Nothing is left to resolve once the parent is mapped"), UpdateUnmapped(ClientOverlay, ClientMap.Get(), Template));
+		TestTrue(TEXT("Overlay has its parent"), ClientOverlay.GetParent() == Template);
+		TestEqual(TEXT("Overlay reads through to the resolved parent"), ClientOverlay.FindConst<FOGTestPolymorphicData_String>()->TestString, FString(TEXT("Parent")));
+	}
+
+	//Test 23: RPCs send a copy of the bank, so copies and assignments continue the original's baselines
+	{
+		using namespace OGDataBankTest;
+		const TStrongObjectPtr<UPackageMap> SenderMap(NewObject<UPackageMap>());
+		const TStrongObjectPtr<UPackageMap> ReceiverMap(NewObject<UPackageMap>());
+		FOGTestDataBank_Baselines Original;
+		FOGTestDataBank_Baselines Receiver;
+		Original.AddUnique<FOGTestPolymorphicData_NetInt>().TestInt = 1;
+		Original.AddUnique<FOGTestPolymorphicData_NetString>().TestString = TEXT("Baseline");
+		bool bReadCleanly = false;
+
+		FOGTestDataBank_Baselines FirstCopy(Original);
+		const int64 FullBits = SendWithBaseline(FirstCopy, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("First copy sends everything"), bReadCleanly && Receiver.Num() == 2);
+		AcknowledgeBaselines(SenderMap.Get(), ReceiverMap.Get());
+
+		FOGTestDataBank_Baselines SecondCopy(Original);
+		const int64 CopyBits = SendWithBaseline(SecondCopy, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("A later copy sends relative to an earlier copy's acknowledged send"), bReadCleanly && CopyBits < FullBits);
+		TestTrue(TEXT("Unchanged entries come from the baseline"), Receiver.Num() == 2 && Receiver.GetConstChecked<FOGTestPolymorphicData_NetString>().TestString == TEXT("Baseline"));
+
+		FOGTestDataBank_Baselines Assigned;
+		Assigned = Original;
+		Assigned.GetChecked<FOGTestPolymorphicData_NetInt>().TestInt = 3;
+		const int64 AssignedBits = SendWithBaseline(Assigned, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		TestTrue(TEXT("An assigned bank continues the stream too"), bReadCleanly && AssignedBits < FullBits);
+		TestTrue(TEXT("Changed entry arrives through the assigned bank"), Receiver.Num() == 2 && Receiver.GetConstChecked<FOGTestPolymorphicData_NetInt>().TestInt == 3);
+	}
+
+	//Test 24: A send relative to a baseline the receiver lost reports failure but keeps the archive in step
+	{
+		using namespace OGDataBankTest;
+		const TStrongObjectPtr<UPackageMap> SenderMap(NewObject<UPackageMap>());
+		const TStrongObjectPtr<UPackageMap> ReceiverMap(NewObject<UPackageMap>());
+		const TStrongObjectPtr<UPackageMap> LostMap(NewObject<UPackageMap>());
+		FOGTestDataBank_Baselines Sender;
+		FOGTestDataBank_Baselines Receiver;
+		Sender.AddUnique<FOGTestPolymorphicData_NetInt>().TestInt = 7;
+		bool bReadCleanly = false;
+		SendWithBaseline(Sender, Receiver, SenderMap.Get(), ReceiverMap.Get(), bReadCleanly);
+		AcknowledgeBaselines(SenderMap.Get(), ReceiverMap.Get());
+
+		bool bSuccess = true;
+		FNetBitWriter Writer(SenderMap.Get(), 0);
+		Sender.NetSerialize(Writer, SenderMap.Get(), bSuccess);
+		FOGTestDataBank_Baselines LostReceiver;
+		FNetBitReader Reader(LostMap.Get(), Writer.GetData(), Writer.GetNumBits());
+		AddExpectedError(TEXT("which is no longer held"), EAutomationExpectedErrorFlags::Contains, 1);
+		const bool bReturned = LostReceiver.NetSerialize(Reader, LostMap.Get(), bSuccess);
+		TestFalse(TEXT("Lost baseline returns failure"), bReturned);
+		TestFalse(TEXT("Lost baseline reports failure"), bSuccess);
+		TestTrue(TEXT("Lost baseline still reads the whole send"), !Reader.IsError() && Reader.AtEnd());
+
+		AcknowledgeBaselines(SenderMap.Get(), LostMap.Get());
+		SendWithBaseline(Sender, LostReceiver, SenderMap.Get(), LostMap.Get(), bReadCleanly);
+		TestTrue(TEXT("Send after the reset is full and succeeds"), bReadCleanly && LostReceiver.Num() == 1 && LostReceiver.GetConstChecked<FOGTestPolymorphicData_NetInt>().TestInt == 7);
+	}
+	
+	// Make the test pass by returning true, or fail by returning false.
+	return true;
 }
\ No newline at end of file
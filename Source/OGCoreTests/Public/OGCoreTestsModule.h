@@ -1,15 +1,15 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "Modules\ModuleManager.h"
-
-/**
- * 
- */
-class FOGCoreTestsModule : public IModuleInterface
-{
-	/** IModuleInterface implementation */
-	virtual void StartupModule() override {}
-	virtual void ShutdownModule() override {}
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "Modules\ModuleManager.h"
+
+/**
+ * 
+ */
+class FOGCoreTestsModule : public IModuleInterface
+{
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override {}
 };
\ No newline at end of file
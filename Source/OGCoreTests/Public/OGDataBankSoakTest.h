@@ -0,0 +1,136 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetDriver.h"
+#include "OGFunctionalClientServerTest.h"
+#include "PolymorphicDataBankTest.h"
+#include "UObject/ObjectKey.h"
+#include "OGDataBankSoakTest.generated.h"
+
+USTRUCT(BlueprintType)
+struct FOGSoakNetworkConditions
+{
+	GENERATED_BODY()
+
+	// Delay added to every packet the server sends
+	UPROPERTY(EditAnywhere, Category="Soak")
+	int32 PacketLagMs = 100;
+
+	UPROPERTY(EditAnywhere, Category="Soak")
+	int32 PacketLagVarianceMs = 30;
+
+	UPROPERTY(EditAnywhere, Category="Soak", meta=(ClampMin=0, ClampMax=100))
+	int32 PacketLossPercent = 2;
+
+	UPROPERTY(EditAnywhere, Category="Soak")
+	bool bReorderPackets = true;
+};
+
+/**
+ * Drives a data bank mutation workload against every connected client under the engine's packet emulation and writes
+ * machine-readable results to Saved/Benchmarks/OGCore/Soak/<name>_<timestamp>.json.
+ *
+ * Every mutation writes a sequence number into the Int entry, with EntriesPerMutation 2 and 3 the String entry and an Actor
+ * entry pointing at a freshly spawned replicated actor are written as well, so clients regularly see references they
+ * can't resolve yet. Clients report each sequence they receive back through their RPC bridge.
+ *
+ * Per client the results hold the bytes the server sent and packets it lost (from the connection), the time from a
+ * mutation on the server to its acknowledgement arriving back, and the client's data bank net stats (entries re-read
+ * after GUIDs resolved, bank bytes received). The server adds its own bank serialization time.
+ * Packet emulation is applied to the server's net driver only, so convergence times include the emulated lag once and
+ * acknowledgements travel back unimpaired. The results record this, headless clients can emulate their side as well
+ * through -OGTestClientArgs, e.g. -OGTestClientArgs="-PktLag=100 -PktLoss=2".
+ * With PIE clients the client side net stats are per process rather than per client, use headless clients for those.
+ * Requires a non shipping build for packet emulation and net stats.
+ */
+UCLASS()
+class OGCORETESTS_API AOGDataBankSoakTest : public AOGFunctionalClientServerTest
+{
+	GENERATED_BODY()
+
+public:
+	AOGDataBankSoakTest();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	virtual void StartTest() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void ReceiveClientMetric(AOGFunctionalTestRPCBridge* Bridge, const FString& Name, double Value) override;
+	virtual void ClientStartTest() override;
+
+	UFUNCTION()
+	void OnRep_SoakBank();
+
+	UFUNCTION(NetMulticast, Reliable)
+	void RPC_RequestClientResults();
+
+	UPROPERTY(EditAnywhere, Category="Soak")
+	float DurationSeconds = 30.f;
+
+	UPROPERTY(EditAnywhere, Category="Soak")
+	float MutationsPerSecond = 20.f;
+
+	UPROPERTY(EditAnywhere, Category="Soak", meta=(ClampMin=1, ClampMax=3))
+	int32 EntriesPerMutation = 3;
+
+	// Time after the last mutation for clients to catch up before results are collected
+	UPROPERTY(EditAnywhere, Category="Soak")
+	float SettleSeconds = 5.f;
+
+	// Clients that haven't sent their results by then are reported as missing
+	UPROPERTY(EditAnywhere, Category="Soak")
+	float CollectTimeoutSeconds = 10.f;
+
+	UPROPERTY(EditAnywhere, Category="Soak")
+	FOGSoakNetworkConditions NetworkConditions;
+
+	UPROPERTY(ReplicatedUsing=OnRep_SoakBank)
+	FOGTestDataBank_Delta SoakBank;
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		Mutating,
+		Settling,
+		Collecting
+	};
+
+	struct FClientResults
+	{
+		FString Name;
+		int64 StartOutBytes = 0;
+		int64 OutBytes = 0;
+		int32 StartOutPacketsLost = 0;
+		int32 OutPacketsLost = 0;
+		int32 LastAcknowledged = 0;
+		TArray<double> ConvergeMs;
+		TMap<FString, double> Reported;
+		bool bFinished = false;
+	};
+
+	void Mutate();
+	void ApplyNetworkConditions();
+	void RestoreNetworkConditions();
+	void CaptureConnectionStats(const bool bIsStart);
+	void WriteResults();
+	void FinishSoak();
+
+	EPhase Phase = EPhase::Idle;
+	double PhaseStartTime = 0;
+	double MutationBudget = 0;
+	int32 Sequence = 0;
+	TArray<double> SentTimes;
+	TWeakObjectPtr<AActor> LastReferencedActor;
+	TMap<TObjectKey<AOGFunctionalTestRPCBridge>, FClientResults> Clients;
+	double ServerSerializeStartSeconds = 0;
+#if DO_ENABLE_NET_TEST
+	FPacketSimulationSettings SavedSimulationSettings;
+#endif
+
+	// Client side
+	int32 LastReceivedSequence = 0;
+};
@@ -0,0 +1,957 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "OGPolymorphicDataBank.h"
+#include "PolymorphicDataBankBenchmark.generated.h"
+
+/**
+ * Entry and bank types used by the data bank benchmarks (PolymorphicDataBankBenchmark.cpp).
+ * A bank can only hold one instance of each type, so every entry shape needs OG_BENCH_MAX_ENTRIES distinct types
+ * to fill the largest benchmarked bank. The numbered types only differ by name, all members live in the shape base.
+ *
+ * Entries serialize natively so the benchmarks don't need a live net driver to drive NetSerialize/NetDeltaSerialize.
+ *
+ * The benchmark types are kept out of the universal StructCache (see FOGCoreTestsModule::StartupModule) and get their own,
+ * so loading this module doesn't change the keys of any other entry type.
+ */
+
+#define OG_BENCH_MAX_ENTRIES 64
+
+// The StructCache shared by the benchmark banks, holding only FOGBenchData_Base and its children
+FOGPolymorphicStructCache* GetBenchStructCache();
+
+USTRUCT()
+struct FOGBenchData_Base : public FOGPolymorphicStructBase
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FOGBenchPOD_Base : public FOGBenchData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	float Scalar = 0.f;
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Ar << Location << Scalar << Count << Flags;
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+USTRUCT()
+struct FOGBenchString_Base : public FOGBenchData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	FString Description;
+
+	UPROPERTY()
+	TArray<int32> Values;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Ar << Name << Description << Values;
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+USTRUCT()
+struct FOGBenchObject_Base : public FOGBenchData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UObject> Primary = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UObject> Secondary = nullptr;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UObject>> Others;
+
+	// Object references stand in as fixed size ids, net GUID resolution is outside the scope of these benchmarks
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		uint32 PrimaryId = Primary ? Primary->GetUniqueID() : 0;
+		uint32 SecondaryId = Secondary ? Secondary->GetUniqueID() : 0;
+		int32 NumOthers = Others.Num();
+		Ar << PrimaryId << SecondaryId << NumOthers;
+		for (int32 Idx = 0; Idx < NumOthers; ++Idx)
+		{
+			uint32 OtherId = Ar.IsSaving() && Others[Idx] ? Others[Idx]->GetUniqueID() : 0;
+			Ar << OtherId;
+		}
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+//Plain data: trivially copyable members only
+USTRUCT()
+struct FOGBenchPOD_00 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_01 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_02 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_03 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_04 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_05 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_06 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_07 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_08 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_09 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_10 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_11 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_12 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_13 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_14 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_15 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_16 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_17 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_18 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_19 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_20 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_21 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_22 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_23 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_24 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_25 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_26 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_27 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_28 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_29 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_30 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_31 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_32 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_33 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_34 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_35 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_36 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_37 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_38 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_39 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_40 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_41 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_42 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_43 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_44 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_45 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_46 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_47 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_48 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_49 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_50 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_51 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_52 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_53 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_54 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_55 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_56 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_57 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_58 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_59 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_60 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_61 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_62 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchPOD_63 : public FOGBenchPOD_Base { GENERATED_BODY() };
+
+//Heap owning members: strings and an array
+USTRUCT()
+struct FOGBenchString_00 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_01 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_02 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_03 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_04 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_05 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_06 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_07 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_08 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_09 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_10 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_11 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_12 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_13 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_14 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_15 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_16 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_17 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_18 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_19 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_20 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_21 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_22 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_23 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_24 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_25 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_26 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_27 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_28 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_29 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_30 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_31 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_32 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_33 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_34 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_35 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_36 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_37 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_38 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_39 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_40 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_41 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_42 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_43 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_44 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_45 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_46 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_47 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_48 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_49 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_50 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_51 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_52 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_53 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_54 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_55 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_56 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_57 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_58 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_59 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_60 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_61 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_62 : public FOGBenchString_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchString_63 : public FOGBenchString_Base { GENERATED_BODY() };
+
+//Object references that GC has to visit
+USTRUCT()
+struct FOGBenchObject_00 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_01 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_02 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_03 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_04 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_05 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_06 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_07 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_08 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_09 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_10 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_11 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_12 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_13 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_14 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_15 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_16 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_17 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_18 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_19 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_20 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_21 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_22 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_23 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_24 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_25 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_26 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_27 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_28 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_29 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_30 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_31 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_32 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_33 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_34 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_35 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_36 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_37 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_38 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_39 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_40 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_41 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_42 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_43 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_44 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_45 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_46 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_47 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_48 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_49 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_50 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_51 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_52 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_53 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_54 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_55 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_56 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_57 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_58 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_59 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_60 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_61 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_62 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+USTRUCT()
+struct FOGBenchObject_63 : public FOGBenchObject_Base { GENERATED_BODY() };
+
+#define OG_BENCH_ENTRY_TRAITS(Type) \
+	template<> struct TStructOpsTypeTraits<Type> : public TStructOpsTypeTraitsBase2<Type> { enum { WithNetSerializer = true }; };
+
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_Base)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_00)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_01)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_02)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_03)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_04)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_05)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_06)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_07)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_08)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_09)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_10)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_11)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_12)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_13)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_14)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_15)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_16)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_17)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_18)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_19)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_20)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_21)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_22)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_23)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_24)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_25)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_26)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_27)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_28)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_29)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_30)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_31)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_32)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_33)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_34)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_35)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_36)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_37)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_38)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_39)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_40)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_41)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_42)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_43)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_44)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_45)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_46)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_47)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_48)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_49)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_50)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_51)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_52)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_53)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_54)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_55)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_56)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_57)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_58)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_59)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_60)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_61)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_62)
+OG_BENCH_ENTRY_TRAITS(FOGBenchPOD_63)
+
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_Base)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_00)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_01)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_02)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_03)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_04)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_05)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_06)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_07)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_08)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_09)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_10)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_11)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_12)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_13)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_14)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_15)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_16)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_17)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_18)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_19)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_20)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_21)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_22)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_23)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_24)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_25)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_26)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_27)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_28)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_29)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_30)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_31)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_32)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_33)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_34)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_35)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_36)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_37)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_38)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_39)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_40)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_41)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_42)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_43)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_44)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_45)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_46)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_47)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_48)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_49)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_50)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_51)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_52)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_53)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_54)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_55)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_56)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_57)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_58)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_59)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_60)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_61)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_62)
+OG_BENCH_ENTRY_TRAITS(FOGBenchString_63)
+
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_Base)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_00)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_01)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_02)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_03)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_04)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_05)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_06)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_07)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_08)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_09)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_10)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_11)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_12)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_13)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_14)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_15)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_16)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_17)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_18)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_19)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_20)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_21)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_22)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_23)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_24)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_25)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_26)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_27)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_28)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_29)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_30)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_31)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_32)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_33)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_34)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_35)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_36)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_37)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_38)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_39)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_40)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_41)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_42)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_43)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_44)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_45)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_46)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_47)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_48)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_49)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_50)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_51)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_52)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_53)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_54)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_55)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_56)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_57)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_58)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_59)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_60)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_61)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_62)
+OG_BENCH_ENTRY_TRAITS(FOGBenchObject_63)
+
+#undef OG_BENCH_ENTRY_TRAITS
+
+// Type lists for each shape, in the order the benchmarks fill a bank
+#define OG_BENCH_POD_TYPES \
+	FOGBenchPOD_00, FOGBenchPOD_01, FOGBenchPOD_02, FOGBenchPOD_03, FOGBenchPOD_04, FOGBenchPOD_05, FOGBenchPOD_06, FOGBenchPOD_07, \
+	FOGBenchPOD_08, FOGBenchPOD_09, FOGBenchPOD_10, FOGBenchPOD_11, FOGBenchPOD_12, FOGBenchPOD_13, FOGBenchPOD_14, FOGBenchPOD_15, \
+	FOGBenchPOD_16, FOGBenchPOD_17, FOGBenchPOD_18, FOGBenchPOD_19, FOGBenchPOD_20, FOGBenchPOD_21, FOGBenchPOD_22, FOGBenchPOD_23, \
+	FOGBenchPOD_24, FOGBenchPOD_25, FOGBenchPOD_26, FOGBenchPOD_27, FOGBenchPOD_28, FOGBenchPOD_29, FOGBenchPOD_30, FOGBenchPOD_31, \
+	FOGBenchPOD_32, FOGBenchPOD_33, FOGBenchPOD_34, FOGBenchPOD_35, FOGBenchPOD_36, FOGBenchPOD_37, FOGBenchPOD_38, FOGBenchPOD_39, \
+	FOGBenchPOD_40, FOGBenchPOD_41, FOGBenchPOD_42, FOGBenchPOD_43, FOGBenchPOD_44, FOGBenchPOD_45, FOGBenchPOD_46, FOGBenchPOD_47, \
+	FOGBenchPOD_48, FOGBenchPOD_49, FOGBenchPOD_50, FOGBenchPOD_51, FOGBenchPOD_52, FOGBenchPOD_53, FOGBenchPOD_54, FOGBenchPOD_55, \
+	FOGBenchPOD_56, FOGBenchPOD_57, FOGBenchPOD_58, FOGBenchPOD_59, FOGBenchPOD_60, FOGBenchPOD_61, FOGBenchPOD_62, FOGBenchPOD_63
+
+#define OG_BENCH_STRING_TYPES \
+	FOGBenchString_00, FOGBenchString_01, FOGBenchString_02, FOGBenchString_03, FOGBenchString_04, FOGBenchString_05, FOGBenchString_06, FOGBenchString_07, \
+	FOGBenchString_08, FOGBenchString_09, FOGBenchString_10, FOGBenchString_11, FOGBenchString_12, FOGBenchString_13, FOGBenchString_14, FOGBenchString_15, \
+	FOGBenchString_16, FOGBenchString_17, FOGBenchString_18, FOGBenchString_19, FOGBenchString_20, FOGBenchString_21, FOGBenchString_22, FOGBenchString_23, \
+	FOGBenchString_24, FOGBenchString_25, FOGBenchString_26, FOGBenchString_27, FOGBenchString_28, FOGBenchString_29, FOGBenchString_30, FOGBenchString_31, \
+	FOGBenchString_32, FOGBenchString_33, FOGBenchString_34, FOGBenchString_35, FOGBenchString_36, FOGBenchString_37, FOGBenchString_38, FOGBenchString_39, \
+	FOGBenchString_40, FOGBenchString_41, FOGBenchString_42, FOGBenchString_43, FOGBenchString_44, FOGBenchString_45, FOGBenchString_46, FOGBenchString_47, \
+	FOGBenchString_48, FOGBenchString_49, FOGBenchString_50, FOGBenchString_51, FOGBenchString_52, FOGBenchString_53, FOGBenchString_54, FOGBenchString_55, \
+	FOGBenchString_56, FOGBenchString_57, FOGBenchString_58, FOGBenchString_59, FOGBenchString_60, FOGBenchString_61, FOGBenchString_62, FOGBenchString_63
+
+#define OG_BENCH_OBJECT_TYPES \
+	FOGBenchObject_00, FOGBenchObject_01, FOGBenchObject_02, FOGBenchObject_03, FOGBenchObject_04, FOGBenchObject_05, FOGBenchObject_06, FOGBenchObject_07, \
+	FOGBenchObject_08, FOGBenchObject_09, FOGBenchObject_10, FOGBenchObject_11, FOGBenchObject_12, FOGBenchObject_13, FOGBenchObject_14, FOGBenchObject_15, \
+	FOGBenchObject_16, FOGBenchObject_17, FOGBenchObject_18, FOGBenchObject_19, FOGBenchObject_20, FOGBenchObject_21, FOGBenchObject_22, FOGBenchObject_23, \
+	FOGBenchObject_24, FOGBenchObject_25, FOGBenchObject_26, FOGBenchObject_27, FOGBenchObject_28, FOGBenchObject_29, FOGBenchObject_30, FOGBenchObject_31, \
+	FOGBenchObject_32, FOGBenchObject_33, FOGBenchObject_34, FOGBenchObject_35, FOGBenchObject_36, FOGBenchObject_37, FOGBenchObject_38, FOGBenchObject_39, \
+	FOGBenchObject_40, FOGBenchObject_41, FOGBenchObject_42, FOGBenchObject_43, FOGBenchObject_44, FOGBenchObject_45, FOGBenchObject_46, FOGBenchObject_47, \
+	FOGBenchObject_48, FOGBenchObject_49, FOGBenchObject_50, FOGBenchObject_51, FOGBenchObject_52, FOGBenchObject_53, FOGBenchObject_54, FOGBenchObject_55, \
+	FOGBenchObject_56, FOGBenchObject_57, FOGBenchObject_58, FOGBenchObject_59, FOGBenchObject_60, FOGBenchObject_61, FOGBenchObject_62, FOGBenchObject_63
+
+USTRUCT()
+struct FOGBenchDataBank : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGBenchData_Base::StaticStruct();}
+	virtual FOGPolymorphicStructCache* GetStructCache() const override {return GetBenchStructCache();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGBenchDataBank> : public TStructOpsTypeTraitsBase2<FOGBenchDataBank>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetSerializer = true,
+	};
+};
+
+USTRUCT()
+struct FOGBenchDataBank_Delta : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGBenchData_Base::StaticStruct();}
+	virtual FOGPolymorphicStructCache* GetStructCache() const override {return GetBenchStructCache();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGBenchDataBank_Delta> : public TStructOpsTypeTraitsBase2<FOGBenchDataBank_Delta>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -1,85 +1,258 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "OGPolymorphicDataBank.h"
-#include "PolymorphicDataBankTest.generated.h"
-
-USTRUCT()
-struct FOGTestPolymorphicData_Base : public FOGPolymorphicStructBase
-{
-	GENERATED_BODY()
-};
-
-USTRUCT(BlueprintType)
-struct FOGTestPolymorphicData_Int : public FOGTestPolymorphicData_Base
-{
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadWrite)
-	int TestInt = 0;
-};
-
-USTRUCT(BlueprintType)
-struct FOGTestPolymorphicData_String : public FOGTestPolymorphicData_Base
-{
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadWrite)
-	FString TestString = TEXT("");
-};
-
-USTRUCT(BlueprintType)
-struct FOGTestPolymorphicData_Actor : public FOGTestPolymorphicData_Base
-{
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadWrite)
-	TObjectPtr<AActor> TestActor = nullptr;
-};
-
-USTRUCT(BlueprintType)
-struct FOGTestPolymorphicData_Object : public FOGTestPolymorphicData_Base
-{
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadWrite)
-	TObjectPtr<UObject> TestObject = nullptr;
-};
-
-USTRUCT(BlueprintType)
-struct FOGTestDataBank : public FOGPolymorphicDataBankBase
-{
-	GENERATED_BODY()
-
-	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
-};
-
-template<>
-struct TStructOpsTypeTraits<FOGTestDataBank> : public TStructOpsTypeTraitsBase2<FOGTestDataBank>
-{
-	enum
-	{
-		WithAddStructReferencedObjects = true,
-		WithNetSerializer = true,
-	};
-};
-
-USTRUCT(BlueprintType)
-struct FOGTestDataBank_Delta : public FOGPolymorphicDataBankBase
-{
-	GENERATED_BODY()
-
-	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
-};
-
-template<>
-struct TStructOpsTypeTraits<FOGTestDataBank_Delta> : public TStructOpsTypeTraitsBase2<FOGTestDataBank_Delta>
-{
-	enum
-	{
-		WithAddStructReferencedObjects = true,
-		WithNetDeltaSerializer = true,
-	};
-};
-
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "OGOverlayDataBank.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGPolymorphicMultiBank.h"
+#include "UObject/CoreNet.h"
+#include "PolymorphicDataBankTest.generated.h"
+
+USTRUCT()
+struct FOGTestPolymorphicData_Base : public FOGPolymorphicStructBase
+{
+	GENERATED_BODY()
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_Int : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	int TestInt = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_String : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	FString TestString = TEXT("");
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_Actor : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	TObjectPtr<AActor> TestActor = nullptr;
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_Object : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	TObjectPtr<UObject> TestObject = nullptr;
+};
+
+// A bitfield bool member, which the script VM hands over as a whole bool
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_Flags : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	FOGTestPolymorphicData_Flags() : bTestFlag(false) {}
+
+	UPROPERTY(BlueprintReadWrite)
+	uint8 bTestFlag : 1;
+};
+
+// Entries that serialize natively, so NetSerialize works without a live net driver
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_NetInt : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 TestInt = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Ar << TestInt;
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestPolymorphicData_NetInt> : public TStructOpsTypeTraitsBase2<FOGTestPolymorphicData_NetInt>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_NetString : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	FString TestString = TEXT("");
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Ar << TestString;
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestPolymorphicData_NetString> : public TStructOpsTypeTraitsBase2<FOGTestPolymorphicData_NetString>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+// Members whose equality isn't bitwise, for the content hash tests
+USTRUCT(BlueprintType)
+struct FOGTestPolymorphicData_Unordered : public FOGTestPolymorphicData_Base
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	float TestFloat = 0.f;
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector TestVector = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite)
+	TSet<int32> TestSet;
+
+	UPROPERTY(BlueprintReadWrite)
+	TMap<FName, int32> TestMap;
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestDataBank : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestDataBank> : public TStructOpsTypeTraitsBase2<FOGTestDataBank>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetSerializer = true,
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestDataBank_Delta : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestDataBank_Delta> : public TStructOpsTypeTraitsBase2<FOGTestDataBank_Delta>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetDeltaSerializer = true,
+	};
+};
+
+// Only holds the int entry, a bank with a different inner struct than the other test banks
+USTRUCT(BlueprintType)
+struct FOGTestDataBank_IntOnly : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Int::StaticStruct();}
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestDataBank_SkipRedundant : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
+	virtual bool SkipsRedundantWrites() const override {return true;}
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestDataBank_Baselines : public FOGPolymorphicDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
+	virtual bool UsesRPCBaselines() const override {return true;}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestDataBank_Baselines> : public TStructOpsTypeTraitsBase2<FOGTestDataBank_Baselines>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetSerializer = true,
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestMultiBank : public FOGPolymorphicMultiBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestMultiBank> : public TStructOpsTypeTraitsBase2<FOGTestMultiBank>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetDeltaSerializer = true,
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FOGTestOverlayBank : public FOGOverlayDataBankBase
+{
+	GENERATED_BODY()
+
+	virtual UScriptStruct* GetInnerStruct() const override {return FOGTestPolymorphicData_Base::StaticStruct();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTestOverlayBank> : public TStructOpsTypeTraitsBase2<FOGTestOverlayBank>
+{
+	enum
+	{
+		WithAddStructReferencedObjects = true,
+		WithNetDeltaSerializer = true,
+	};
+};
+
+// Stands in for the client package map: objects are sent as guids and only resolve once their guid is mapped
+UCLASS(Transient)
+class UOGTestPackageMap : public UPackageMap
+{
+	GENERATED_BODY()
+
+public:
+	void MapObject(const FNetworkGUID& GUID, UObject* Object) { Objects.Add(GUID, Object); }
+
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = nullptr) override;
+	virtual UObject* GetObjectFromNetGUID(const FNetworkGUID& NetGUID, const bool bIgnoreMustBeMapped) override;
+
+private:
+	TMap<FNetworkGUID, TWeakObjectPtr<UObject>> Objects;
+};
@@ -1,20 +1,23 @@
-﻿// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "OGDevCoreModule.h"
-
-#define LOCTEXT_NAMESPACE "FOGDevCoreModule"
-
-void FOGDevCoreModule::StartupModule()
-{
-	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-}
-
-void FOGDevCoreModule::ShutdownModule()
-{
-	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
-	// we call this function before unloading the module.
-}
-
-#undef LOCTEXT_NAMESPACE
-	
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OGDevCoreModule.h"
+
+#include "OGHeadlessClientPool.h"
+
+#define LOCTEXT_NAMESPACE "FOGDevCoreModule"
+
+void FOGDevCoreModule::StartupModule()
+{
+	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+}
+
+void FOGDevCoreModule::ShutdownModule()
+{
+	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
+	// we call this function before unloading the module.
+	FOGHeadlessClientPool::Get().ShutdownClients();
+}
+
+#undef LOCTEXT_NAMESPACE
+	
 IMPLEMENT_MODULE(FOGDevCoreModule, OGDevCore)
\ No newline at end of file
@@ -1,285 +1,377 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#include "OGFunctionalClientServerTest.h"
-
-#include "OGAsyncUtils.h"
-#include "GameFramework/GameModeBase.h"
-#include "OGFunctionalTestRPCBridge.h"
-#include "OGFutureUtilities.h"
-#include "Editor/UnrealEdEngine.h"
-#include "Net/UnrealNetwork.h"
-#include "Net/Core/PushModel/PushModel.h"
-
-// Sets default values
-AOGFunctionalClientServerTest::AOGFunctionalClientServerTest()
-{
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-	bReplicates = true;
-	bAlwaysRelevant = true;
-
-	bNetLoadOnClient = true;
-}
-
-void AOGFunctionalClientServerTest::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	FDoRepLifetimeParams Params;
-	Params.bIsPushBased = true;
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, IsServerCheckpointAcknowledged, Params);
-}
-
-void AOGFunctionalClientServerTest::Tick(float DeltaSeconds)
-{
-	Super::Tick(DeltaSeconds);
-	if (!bIsRunning)
-		return;
-	
-	TimeForClientConnection -= DeltaSeconds;
-	if (TimeForClientConnection < 0 && !bRequestedNewClients)
-	{
-		//const UUnrealEdEngine* EdEngine = Cast<UUnrealEdEngine>(GEngine);
-		//const bool bSkipFirstClient = EdEngine && GetNetMode() == NM_DedicatedServer;
-		//NumClientsToSpawn = NumClients - (bSkipFirstClient ? 1 : 0);
-		NumClientsToSpawn = NumClients - ServerRPCBridges.Num();
-		bRequestedNewClients = true;
-	}
-
-	//Spawn one client per tick because the request isn't processed immediately
-	if (NumClientsToSpawn > 0)
-	{
-		StartNewClient();
-		--NumClientsToSpawn;
-	}
-}
-
-void AOGFunctionalClientServerTest::OnRep_ServerCheckpoint(bool OldCheckpoint)
-{
-	ensure(!HasAuthority());
-	if (IsServerCheckpointAcknowledged)
-	{
-		WhenServerReachesCheckpoint = TOGPromise<void>();
-		WhenServerAcknowledgesCheckpoint->Fulfill();
-	}
-	else
-	{
-		WhenServerAcknowledgesCheckpoint = TOGPromise<void>();
-		WhenServerReachesCheckpoint->Fulfill();
-	}
-}
-
-void AOGFunctionalClientServerTest::Checkpoint(FLatentActionInfo LatentInfo, EOGCheckpointReturn& OutReturn)
-{
-	if (HasAuthority())
-	{
-		OutReturn = EOGCheckpointReturn::Server;
-		WhenAllClientsReachCheckpoint(false)->WeakThen(this, [this]()
-		{
-			SetServerCheckpoint(false);
-			return WhenAllClientsReachCheckpoint(true);
-		})->WeakThen(this, [this, LatentInfo]()mutable
-		{
-			SetServerCheckpoint(true);
-			FOGAsyncUtils::ExecuteLatentAction(LatentInfo);
-		});
-	}
-	else
-	{
-		OutReturn = EOGCheckpointReturn::Client;
-		if (!ensureAlways(ClientRPCBridge))
-			return;
-		
-		ClientRPCBridge->RPC_ClientReachedCheckpoint(false);
-		WhenServerReachesCheckpoint->WeakThen(this, [this]() ->TOGPromise<void>&
-		{
-			ClientRPCBridge->RPC_ClientReachedCheckpoint(true);
-			return WhenServerAcknowledgesCheckpoint;
-		})->WeakThen(this, [this, LatentInfo]() mutable
-		{
-			FOGAsyncUtils::ExecuteLatentAction(LatentInfo);
-		});
-	}
-}
-
-void AOGFunctionalClientServerTest::SetServerCheckpoint(const bool bIsAcknowledge)
-{
-	IsServerCheckpointAcknowledged = bIsAcknowledge;
-	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, IsServerCheckpointAcknowledged, this);
-}
-
-void AOGFunctionalClientServerTest::RPC_StartTestOnAll_Implementation()
-{
-	if (!HasAuthority())
-	{
-		ReceiveStartTest();
-	}
-}
-
-void AOGFunctionalClientServerTest::OnClientConnected(AGameModeBase* GameMode, APlayerController* NewPlayer)
-{
-	//No need for a bridge to a local controller
-	if (NewPlayer->IsLocalController())
-		return;
-	ensure(HasAuthority());
-	CreateRPCBridgeForClient(NewPlayer);
-}
-
-void AOGFunctionalClientServerTest::OnClientDisconnected(AGameModeBase* GameMode, AController* DisconnectedPlayer)
-{
-	//No need for a bridge to a local controller
-	if (DisconnectedPlayer->IsLocalController())
-		return;
-	
-	ensure(HasAuthority());
-	
-	if (ServerRPCBridges.Contains(DisconnectedPlayer))
-	{
-		AOGFunctionalTestRPCBridge* Bridge = ServerRPCBridges.FindAndRemoveChecked(DisconnectedPlayer);
-		Bridge->Destroy();
-	}
-}
-
-void AOGFunctionalClientServerTest::CreateRPCBridgeForClient(APlayerController* ClientController)
-{
-	if (!ensure(HasAuthority() && ClientController && !ServerRPCBridges.Contains(ClientController)))
-		return;
-    
-	// Spawn parameters
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = ClientController;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-    
-	// Spawn the RPC bridge actor
-	AOGFunctionalTestRPCBridge* NewBridge = GetWorld()->SpawnActor<AOGFunctionalTestRPCBridge>(
-		RPCBridgeClass ? RPCBridgeClass->StaticClass() : AOGFunctionalTestRPCBridge::StaticClass(),
-		FVector::ZeroVector,
-		FRotator::ZeroRotator,
-		SpawnParams
-	);
-    
-	if (NewBridge)
-	{
-		// Initialize the bridge with the client controller
-		NewBridge->ParentFunctionalTest = this;
-        
-		// Add to our map
-		ServerRPCBridges.Add(ClientController, NewBridge);
-	}
-
-	if (ServerRPCBridges.Num() == NumClients)
-	{
-		WhenAllClientBridgesEstablished->Fulfill();
-	}
-}
-
-TOGFuture<void> AOGFunctionalClientServerTest::WhenAllClientsReachCheckpoint(bool bIsAcknowledge)
-{
-	ensure(HasAuthority());
-	TArray<FOGFuture> AllClientFutures;
-	for (auto& [Controller, Bridge] : ServerRPCBridges)
-	{
-		AllClientFutures.Add(Bridge->GetCheckpointFuture(bIsAcknowledge));
-	}
-	return UOGFutureUtilities::FutureAll(this, AllClientFutures);
-}
-
-AOGFunctionalTestRPCBridge* AOGFunctionalClientServerTest::GetRPCBridgeForClient(APlayerController* ClientController)
-{
-	if (!ensure(HasAuthority()))
-		return nullptr;
-
-	AOGFunctionalTestRPCBridge** Bridge = ServerRPCBridges.Find(ClientController);
-	if (!ensure(Bridge))
-		return nullptr;
-	return *Bridge;
-}
-
-void AOGFunctionalClientServerTest::PrepareTest()
-{
-	if (GetNetMode() == NM_Standalone)
-	{
-		FinishTest(EFunctionalTestResult::Invalid, TEXT("Cannot run a client-server test in NetMode Standalone"));
-	}
-	
-	Super::PrepareTest();
-	
-	//If we're rerunning the test, use existing clients
-	if (WhenAllClientBridgesEstablished->IsFulfilled())
-	{
-		return;
-	}
-	
-	RegisterConnectionEvents();
-	WhenAllClientBridgesEstablished->WeakThen(this, [this]()
-	{
-		return WhenAllClientsReachCheckpoint(true);
-	})->WeakThen(this, [this]()
-	{
-		bAreClientConnectionsReady = true;
-	});
-}
-
-void AOGFunctionalClientServerTest::StartTest()
-{
-	Super::StartTest();
-	RPC_StartTestOnAll();
-}
-
-void AOGFunctionalClientServerTest::LogStep(ELogVerbosity::Type Verbosity, const FString& Message)
-{
-	if (HasAuthority())
-	{
-		Super::LogStep(Verbosity, Message);
-	}
-	else
-	{
-		ClientRPCBridge->RPC_ForwardLogStep(Verbosity, Message);
-	}
-}
-
-bool AOGFunctionalClientServerTest::IsReady_Implementation()
-{
-	return bAreClientConnectionsReady && Super::IsReady_Implementation();
-}
-
-void AOGFunctionalClientServerTest::LinkClientRPCBridge(AOGFunctionalTestRPCBridge* Bridge)
-{
-	ClientRPCBridge = Bridge;
-	ClientRPCBridge->RPC_ClientReachedCheckpoint(true);
-}
-
-void AOGFunctionalClientServerTest::RegisterConnectionEvents()
-{
-	if(!ensure(HasAuthority())) [[unlikely]] 
-		return;
-
-	ServerRPCBridges.Empty();
-	
-
-	FGameModeEvents::OnGameModePostLoginEvent().AddUObject(this, &ThisClass::OnClientConnected);
-	FGameModeEvents::OnGameModeLogoutEvent().AddUObject(this, &ThisClass::OnClientDisconnected);
-
-	// Spawn RPC bridge for any existing connections
-	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
-	{
-		APlayerController* PC = It->Get();
-		if (PC && !PC->IsLocalController()) // We only care about remote clients
-		{
-			// Check if this client already has a bridge
-			if (!ServerRPCBridges.Contains(PC) || !IsValid(ServerRPCBridges.FindChecked(PC)))
-			{
-				CreateRPCBridgeForClient(PC);
-			}
-		}
-	}
-}
-
-void AOGFunctionalClientServerTest::StartNewClient() const
-{
-	ensure(HasAuthority());
-	UUnrealEdEngine* EdEngine = Cast<UUnrealEdEngine>(GEngine);
-	EdEngine->RequestLateJoin();
-	//TODO: Handle starting clients when we don't have EdEngine (presumably this will happen when running tests autonomously)
-}
-
-
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGFunctionalClientServerTest.h"
+
+#include "OGAsyncUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "OGFunctionalTestRPCBridge.h"
+#include "OGHeadlessClientPool.h"
+#include "Editor/UnrealEdEngine.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+// Sets default values
+AOGFunctionalClientServerTest::AOGFunctionalClientServerTest()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	bNetLoadOnClient = true;
+}
+
+void AOGFunctionalClientServerTest::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReleasedCheckpointSequence, Params);
+}
+
+void AOGFunctionalClientServerTest::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (!bIsRunning)
+		return;
+
+	if (HasAuthority())
+	{
+		CheckCheckpointTimeout();
+	}
+	
+	if (UsesHeadlessClients())
+	{
+		if (!WhenAllClientBridgesEstablished->IsFulfilled())
+		{
+			//Processes are launched in parallel and reused, the pool only starts the ones that are missing
+			FOGHeadlessClientPool& Pool = FOGHeadlessClientPool::Get();
+			if (Pool.ReapExitedClients() > 0 && bRequestedNewClients)
+			{
+				FinishTest(EFunctionalTestResult::Failed, TEXT("A test client process exited before connecting, see OGTestClient*.log"));
+				return;
+			}
+			if (!bRequestedNewClients)
+			{
+				Pool.EnsureClients(NumClients, GetWorld()->URL.Port);
+				bRequestedNewClients = true;
+			}
+		}
+		return;
+	}
+
+	TimeForClientConnection -= DeltaSeconds;
+	if (TimeForClientConnection < 0 && !bRequestedNewClients)
+	{
+		//const UUnrealEdEngine* EdEngine = Cast<UUnrealEdEngine>(GEngine);
+		//const bool bSkipFirstClient = EdEngine && GetNetMode() == NM_DedicatedServer;
+		//NumClientsToSpawn = NumClients - (bSkipFirstClient ? 1 : 0);
+		NumClientsToSpawn = NumClients - ServerRPCBridges.Num();
+		bRequestedNewClients = true;
+	}
+
+	//Spawn one client per tick because the request isn't processed immediately
+	if (NumClientsToSpawn > 0)
+	{
+		StartNewClient();
+		--NumClientsToSpawn;
+	}
+}
+
+void AOGFunctionalClientServerTest::OnRep_ReleasedCheckpoint()
+{
+	ensure(!HasAuthority());
+	FulfillCheckpointsUpTo(ReleasedCheckpointSequence);
+}
+
+void AOGFunctionalClientServerTest::Checkpoint(FLatentActionInfo LatentInfo, EOGCheckpointReturn& OutReturn, FName CheckpointName)
+{
+	OutReturn = HasAuthority() ? EOGCheckpointReturn::Server : EOGCheckpointReturn::Client;
+	ReachCheckpoint(CheckpointName)->WeakThen(this, [LatentInfo]() mutable
+	{
+		FOGAsyncUtils::ExecuteLatentAction(LatentInfo);
+	});
+}
+
+TOGFuture<void> AOGFunctionalClientServerTest::ReachCheckpoint(const FName CheckpointName)
+{
+	FPendingCheckpoint& Checkpoint = PendingCheckpoints.AddDefaulted_GetRef();
+	Checkpoint.Sequence = ++CheckpointSequence;
+	Checkpoint.Name = CheckpointName;
+	Checkpoint.StartTime = FPlatformTime::Seconds();
+	TOGFuture<void> Future = Checkpoint.Promise;
+
+	if (HasAuthority())
+	{
+		for (const auto& [Controller, Bridge] : ServerRPCBridges)
+		{
+			if (Bridge->ReachedCheckpointSequence == Checkpoint.Sequence && Bridge->ReachedCheckpointName != CheckpointName)
+			{
+				LogStep(ELogVerbosity::Error, FString::Printf(TEXT("Checkpoint %d is '%s' on the server but '%s' on %s"),
+					Checkpoint.Sequence, *CheckpointName.ToString(), *Bridge->ReachedCheckpointName.ToString(), *GetNameSafe(Controller)));
+			}
+		}
+		ReleaseReachedCheckpoints();
+	}
+	else if (ensureAlways(ClientRPCBridge))
+	{
+		ClientRPCBridge->RPC_ClientReachedCheckpoint(Checkpoint.Sequence, CheckpointName);
+	}
+	return Future;
+}
+
+void AOGFunctionalClientServerTest::OnClientReachedCheckpoint(AOGFunctionalTestRPCBridge* Bridge)
+{
+	ensure(HasAuthority());
+	for (const FPendingCheckpoint& Checkpoint : PendingCheckpoints)
+	{
+		if (Checkpoint.Sequence == Bridge->ReachedCheckpointSequence && Checkpoint.Name != Bridge->ReachedCheckpointName)
+		{
+			LogStep(ELogVerbosity::Error, FString::Printf(TEXT("Checkpoint %d is '%s' on the server but '%s' on %s"),
+				Checkpoint.Sequence, *Checkpoint.Name.ToString(), *Bridge->ReachedCheckpointName.ToString(), *GetNameSafe(Bridge->GetOwner())));
+		}
+	}
+	ReleaseReachedCheckpoints();
+}
+
+void AOGFunctionalClientServerTest::ReleaseReachedCheckpoints()
+{
+	if (PendingCheckpoints.IsEmpty())
+		return;
+
+	int32 SlowestClient = PendingCheckpoints.Last().Sequence;
+	for (const auto& [Controller, Bridge] : ServerRPCBridges)
+	{
+		SlowestClient = FMath::Min(SlowestClient, Bridge->ReachedCheckpointSequence);
+	}
+	if (SlowestClient <= ReleasedCheckpointSequence)
+		return;
+
+	ReleasedCheckpointSequence = SlowestClient;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReleasedCheckpointSequence, this);
+	FulfillCheckpointsUpTo(ReleasedCheckpointSequence);
+}
+
+void AOGFunctionalClientServerTest::FulfillCheckpointsUpTo(const int32 Sequence)
+{
+	int32 NumReleased = 0;
+	while (NumReleased < PendingCheckpoints.Num() && PendingCheckpoints[NumReleased].Sequence <= Sequence)
+	{
+		++NumReleased;
+	}
+	//Remove first, fulfilling may reach the next checkpoint
+	TArray<FPendingCheckpoint> Released(PendingCheckpoints.GetData(), NumReleased);
+	PendingCheckpoints.RemoveAt(0, NumReleased);
+	for (FPendingCheckpoint& Checkpoint : Released)
+	{
+		Checkpoint.Promise->Fulfill();
+	}
+}
+
+void AOGFunctionalClientServerTest::CheckCheckpointTimeout()
+{
+	if (PendingCheckpoints.IsEmpty() || CheckpointTimeoutSeconds <= 0)
+		return;
+
+	const FPendingCheckpoint& Oldest = PendingCheckpoints[0];
+	const double WaitedSeconds = FPlatformTime::Seconds() - Oldest.StartTime;
+	if (WaitedSeconds < CheckpointTimeoutSeconds)
+		return;
+
+	TArray<FString> Lagging;
+	for (const auto& [Controller, Bridge] : ServerRPCBridges)
+	{
+		if (Bridge->ReachedCheckpointSequence < Oldest.Sequence)
+		{
+			Lagging.Add(FString::Printf(TEXT("%s (last reached %d '%s')"),
+				*GetNameSafe(Controller), Bridge->ReachedCheckpointSequence, *Bridge->ReachedCheckpointName.ToString()));
+		}
+	}
+	const FString Message = FString::Printf(TEXT("Checkpoint %d '%s' timed out after %.1fs waiting for %s"),
+		Oldest.Sequence, *Oldest.Name.ToString(), WaitedSeconds, *FString::Join(Lagging, TEXT(", ")));
+	PendingCheckpoints.Reset();
+	FinishTest(EFunctionalTestResult::Failed, Message);
+}
+
+void AOGFunctionalClientServerTest::RPC_StartTestOnAll_Implementation(const int32 CheckpointBase)
+{
+	if (!HasAuthority())
+	{
+		CheckpointSequence = CheckpointBase;
+		PendingCheckpoints.Reset();
+		ClientStartTest();
+		ReceiveStartTest();
+	}
+}
+
+void AOGFunctionalClientServerTest::OnClientConnected(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	//No need for a bridge to a local controller
+	if (NewPlayer->IsLocalController())
+		return;
+	ensure(HasAuthority());
+	CreateRPCBridgeForClient(NewPlayer);
+}
+
+void AOGFunctionalClientServerTest::OnClientDisconnected(AGameModeBase* GameMode, AController* DisconnectedPlayer)
+{
+	//No need for a bridge to a local controller
+	if (DisconnectedPlayer->IsLocalController())
+		return;
+	
+	ensure(HasAuthority());
+	
+	if (ServerRPCBridges.Contains(DisconnectedPlayer))
+	{
+		AOGFunctionalTestRPCBridge* Bridge = ServerRPCBridges.FindAndRemoveChecked(DisconnectedPlayer);
+		Bridge->Destroy();
+	}
+}
+
+void AOGFunctionalClientServerTest::CreateRPCBridgeForClient(APlayerController* ClientController)
+{
+	if (!ensure(HasAuthority() && ClientController && !ServerRPCBridges.Contains(ClientController)))
+		return;
+    
+	// Spawn parameters
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = ClientController;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    
+	// Spawn the RPC bridge actor
+	AOGFunctionalTestRPCBridge* NewBridge = GetWorld()->SpawnActor<AOGFunctionalTestRPCBridge>(
+		RPCBridgeClass ? RPCBridgeClass->StaticClass() : AOGFunctionalTestRPCBridge::StaticClass(),
+		FVector::ZeroVector,
+		FRotator::ZeroRotator,
+		SpawnParams
+	);
+    
+	if (NewBridge)
+	{
+		// Initialize the bridge with the client controller
+		NewBridge->ParentFunctionalTest = this;
+        
+		// Add to our map
+		ServerRPCBridges.Add(ClientController, NewBridge);
+	}
+
+	//Reused headless clients from earlier tests may outnumber what this test asked for
+	if (ServerRPCBridges.Num() >= NumClients && !WhenAllClientBridgesEstablished->IsFulfilled())
+	{
+		WhenAllClientBridgesEstablished->Fulfill();
+	}
+}
+
+AOGFunctionalTestRPCBridge* AOGFunctionalClientServerTest::GetRPCBridgeForClient(APlayerController* ClientController)
+{
+	if (!ensure(HasAuthority()))
+		return nullptr;
+
+	AOGFunctionalTestRPCBridge** Bridge = ServerRPCBridges.Find(ClientController);
+	if (!ensure(Bridge))
+		return nullptr;
+	return *Bridge;
+}
+
+void AOGFunctionalClientServerTest::PrepareTest()
+{
+	if (GetNetMode() == NM_Standalone)
+	{
+		FinishTest(EFunctionalTestResult::Invalid, TEXT("Cannot run a client-server test in NetMode Standalone"));
+	}
+	
+	Super::PrepareTest();
+	
+	//If we're rerunning the test, use existing clients
+	if (WhenAllClientBridgesEstablished->IsFulfilled())
+	{
+		return;
+	}
+	
+	RegisterConnectionEvents();
+}
+
+void AOGFunctionalClientServerTest::StartTest()
+{
+	Super::StartTest();
+	//Anything left from an aborted run is dropped and every client starts level with the server
+	PendingCheckpoints.Reset();
+	ReleasedCheckpointSequence = CheckpointSequence;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReleasedCheckpointSequence, this);
+	for (const auto& [Controller, Bridge] : ServerRPCBridges)
+	{
+		Bridge->ReachedCheckpointSequence = CheckpointSequence;
+		Bridge->ReachedCheckpointName = NAME_None;
+	}
+	RPC_StartTestOnAll(CheckpointSequence);
+}
+
+void AOGFunctionalClientServerTest::LogStep(ELogVerbosity::Type Verbosity, const FString& Message)
+{
+	if (HasAuthority())
+	{
+		Super::LogStep(Verbosity, Message);
+	}
+	else
+	{
+		ClientRPCBridge->RPC_ForwardLogStep(Verbosity, Message);
+	}
+}
+
+bool AOGFunctionalClientServerTest::IsReady_Implementation()
+{
+	if (!WhenAllClientBridgesEstablished->IsFulfilled())
+		return false;
+	for (const auto& [Controller, Bridge] : ServerRPCBridges)
+	{
+		if (!Bridge->bIsClientLinked)
+			return false;
+	}
+	return Super::IsReady_Implementation();
+}
+
+void AOGFunctionalClientServerTest::LinkClientRPCBridge(AOGFunctionalTestRPCBridge* Bridge)
+{
+	ClientRPCBridge = Bridge;
+	ClientRPCBridge->RPC_ClientLinked();
+}
+
+void AOGFunctionalClientServerTest::RegisterConnectionEvents()
+{
+	if(!ensure(HasAuthority())) [[unlikely]] 
+		return;
+
+	ServerRPCBridges.Empty();
+	
+
+	FGameModeEvents::OnGameModePostLoginEvent().AddUObject(this, &ThisClass::OnClientConnected);
+	FGameModeEvents::OnGameModeLogoutEvent().AddUObject(this, &ThisClass::OnClientDisconnected);
+
+	// Spawn RPC bridge for any existing connections
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (PC && !PC->IsLocalController()) // We only care about remote clients
+		{
+			// Check if this client already has a bridge
+			if (!ServerRPCBridges.Contains(PC) || !IsValid(ServerRPCBridges.FindChecked(PC)))
+			{
+				CreateRPCBridgeForClient(PC);
+			}
+		}
+	}
+}
+
+void AOGFunctionalClientServerTest::StartNewClient() const
+{
+	ensure(HasAuthority());
+	UUnrealEdEngine* EdEngine = Cast<UUnrealEdEngine>(GEngine);
+	EdEngine->RequestLateJoin();
+}
+
+bool AOGFunctionalClientServerTest::UsesHeadlessClients() const
+{
+	return HasAuthority() && !Cast<UUnrealEdEngine>(GEngine);
+}
+
+
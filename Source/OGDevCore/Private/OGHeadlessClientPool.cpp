@@ -0,0 +1,97 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#include "OGHeadlessClientPool.h"
+
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOGHeadlessClients, Log, All);
+
+//A server target can't run as a client, the game target built next to it is used instead
+static FString GetDefaultClientExecutable()
+{
+#if UE_SERVER
+	return FPlatformProcess::GenerateApplicationPath(FApp::GetProjectName(), FApp::GetBuildConfiguration());
+#else
+	return FPlatformProcess::ExecutablePath();
+#endif
+}
+
+FOGHeadlessClientPool& FOGHeadlessClientPool::Get()
+{
+	static FOGHeadlessClientPool Instance;
+	return Instance;
+}
+
+void FOGHeadlessClientPool::EnsureClients(const int32 NumClients, const int32 Port)
+{
+	ReapExitedClients();
+	const int32 NumToLaunch = NumClients - Clients.Num();
+	if (NumToLaunch <= 0)
+		return;
+
+	FString ExtraArgs;
+	FParse::Value(FCommandLine::Get(), TEXT("-OGTestClientArgs="), ExtraArgs, false);
+
+	FString Executable;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("-OGTestClientExe="), Executable))
+	{
+		Executable = GetDefaultClientExecutable();
+	}
+	if (!FPaths::FileExists(Executable))
+	{
+		UE_LOG(LogOGHeadlessClients, Error, TEXT("Can't launch test clients, %s doesn't exist.%s Pass a client or editor executable with -OGTestClientExe=<path>"),
+			*Executable, UE_SERVER ? TEXT(" The running binary is a server build and can't act as a client.") : TEXT(""));
+		return;
+	}
+
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	for (int32 Idx = 0; Idx < NumToLaunch; ++Idx)
+	{
+		FClientProcess Client;
+		Client.Index = NextClientIndex++;
+		// Separate logs per client, they would otherwise all write to the server's log file
+		const FString Args = FString::Printf(TEXT("\"%s\" 127.0.0.1:%d -game -nullrhi -nosound -unattended -nosplash -nopause -log=OGTestClient%d.log %s"),
+			*ProjectPath, Port, Client.Index, *ExtraArgs);
+		Client.Handle = FPlatformProcess::CreateProc(*Executable, *Args, true, true, true, &Client.ProcessId, 0, nullptr, nullptr);
+		if (!Client.Handle.IsValid())
+		{
+			UE_LOG(LogOGHeadlessClients, Error, TEXT("Failed to launch test client %d: %s %s"), Client.Index, *Executable, *Args);
+			continue;
+		}
+		UE_LOG(LogOGHeadlessClients, Log, TEXT("Launched test client %d (pid %u): %s"), Client.Index, Client.ProcessId, *Executable);
+		Clients.Add(MoveTemp(Client));
+	}
+}
+
+int32 FOGHeadlessClientPool::ReapExitedClients()
+{
+	int32 NumExited = 0;
+	for (int32 Idx = Clients.Num() - 1; Idx >= 0; --Idx)
+	{
+		FClientProcess& Client = Clients[Idx];
+		if (FPlatformProcess::IsProcRunning(Client.Handle))
+			continue;
+		int32 ReturnCode = 0;
+		FPlatformProcess::GetProcReturnCode(Client.Handle, &ReturnCode);
+		UE_LOG(LogOGHeadlessClients, Warning, TEXT("Test client %d (pid %u) exited with code %d"), Client.Index, Client.ProcessId, ReturnCode);
+		FPlatformProcess::CloseProc(Client.Handle);
+		Clients.RemoveAtSwap(Idx);
+		++NumExited;
+	}
+	return NumExited;
+}
+
+void FOGHeadlessClientPool::ShutdownClients()
+{
+	for (FClientProcess& Client : Clients)
+	{
+		if (FPlatformProcess::IsProcRunning(Client.Handle))
+		{
+			FPlatformProcess::TerminateProc(Client.Handle, true);
+		}
+		FPlatformProcess::CloseProc(Client.Handle);
+	}
+	Clients.Empty();
+}
@@ -1,41 +1,50 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
-#include "OGFuture.h"
-#include "OGFunctionalTestRPCBridge.generated.h"
-
-class AOGFunctionalClientServerTest;
-
-UCLASS()
-class OGDEVCORE_API AOGFunctionalTestRPCBridge : public AActor
-{
-	friend AOGFunctionalClientServerTest;
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this actor's properties
-	AOGFunctionalTestRPCBridge();
-
-	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
-	
-	UFUNCTION(Server, Reliable)
-	void RPC_ClientReachedCheckpoint(const bool bIsAcknowledge);
-
-	TOGFuture<void> GetCheckpointFuture(const bool bIsAcknowledge) {return bIsAcknowledge ? WhenClientAcknowledgesCheckpoint : WhenClientReachesCheckpoint; }
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-	UFUNCTION(Server, Reliable)
-	void RPC_ForwardLogStep(uint8 Verbosity, const FString& Message);
-
-	UPROPERTY(Replicated)
-	AOGFunctionalClientServerTest* ParentFunctionalTest = nullptr;
-	
-	TOGPromise<void> WhenClientReachesCheckpoint;
-	TOGPromise<void> WhenClientAcknowledgesCheckpoint;
-};
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "OGFunctionalTestRPCBridge.generated.h"
+
+class AOGFunctionalClientServerTest;
+
+UCLASS()
+class OGDEVCORE_API AOGFunctionalTestRPCBridge : public AActor
+{
+	friend AOGFunctionalClientServerTest;
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	AOGFunctionalTestRPCBridge();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	
+	// Sequence is the client's count of checkpoints reached so far, the name is only used to diagnose mismatched checkpoints
+	UFUNCTION(Server, Reliable)
+	void RPC_ClientReachedCheckpoint(const int32 Sequence, const FName CheckpointName);
+
+	// The client has linked this bridge to its copy of the test and is ready to take part in checkpoints
+	UFUNCTION(Server, Reliable)
+	void RPC_ClientLinked();
+
+	// Send a named measurement from this client to the server's test, see AOGFunctionalClientServerTest::ReceiveClientMetric
+	UFUNCTION(Server, Reliable)
+	void RPC_ReportMetric(const FString& Name, double Value);
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	UFUNCTION(Server, Reliable)
+	void RPC_ForwardLogStep(uint8 Verbosity, const FString& Message);
+
+	UPROPERTY(Replicated)
+	AOGFunctionalClientServerTest* ParentFunctionalTest = nullptr;
+
+	//Server-only - last checkpoint this client reported
+	int32 ReachedCheckpointSequence = 0;
+	FName ReachedCheckpointName;
+
+	bool bIsClientLinked = false;
+};
@@ -0,0 +1,44 @@
+/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+
+/**
+ * Client processes for AOGFunctionalClientServerTest when there is no editor to add PIE clients, e.g. a dedicated server
+ * started from a commandlet or with -ExecCmds="Automation RunTests ..." on headless CI.
+ * Clients are launched in parallel as -game -nullrhi processes connecting to the local server. They run the running
+ * executable, or for server builds, which can't act as clients, the game executable built next to it. Another executable
+ * can be given with -OGTestClientExe=<path>.
+ * They stay connected between tests, so the next test only launches what it is missing, and are closed when the module
+ * shuts down.
+ *
+ * Extra client arguments can be passed with -OGTestClientArgs="...", e.g. to enable packet emulation on the clients.
+ */
+class OGDEVCORE_API FOGHeadlessClientPool
+{
+public:
+	static FOGHeadlessClientPool& Get();
+
+	// Launch enough clients for NumClients to be running or starting, connecting to the server listening on Port
+	void EnsureClients(const int32 NumClients, const int32 Port);
+
+	// Forget clients whose process exited, returns how many did since the last call
+	int32 ReapExitedClients();
+
+	int32 NumRunning() const { return Clients.Num(); }
+
+	void ShutdownClients();
+
+private:
+	struct FClientProcess
+	{
+		FProcHandle Handle;
+		uint32 ProcessId = 0;
+		int32 Index = 0;
+	};
+
+	TArray<FClientProcess> Clients;
+	int32 NextClientIndex = 0;
+};